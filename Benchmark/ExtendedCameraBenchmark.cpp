@@ -0,0 +1,227 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#include "ExtendedCameraMath.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace ExtendedCameraMath;
+
+using FVector3d = TVector3<double>;
+using FRotator3d = TRotator3<double>;
+using FRotator3f = TRotator3<float>;
+using FQuat4d = TQuat4<double>;
+
+namespace
+{
+// Inputs are drawn from a pool this size, so the working set stays in cache and we measure the maths
+constexpr size_t PoolSize = 4096;
+
+struct FSyntheticFrame
+{
+    FVector3d TrackLocation;
+    FRotator3d TrackRotation;
+    FQuat4d TrackQuat;
+    FRotator3f LookAt;
+    float TrackFOV;
+    float Alpha;
+    float ReferenceDistance;
+    float CurrentDistance;
+    float DeltaTime;
+};
+
+std::vector<FSyntheticFrame> MakeFrames()
+{
+    std::mt19937 Random(0x5EED);
+    std::uniform_real_distribution<double> Position(-100000.0, 100000.0);
+    std::uniform_real_distribution<double> Angle(-180.0, 180.0);
+    std::uniform_real_distribution<float> FOV(20.f, 120.f);
+    std::uniform_real_distribution<float> Unit(0.f, 1.f);
+    std::uniform_real_distribution<float> Distance(50.f, 5000.f);
+
+    std::vector<FSyntheticFrame> Frames(PoolSize);
+    for (auto &Frame : Frames)
+    {
+        Frame.TrackLocation = {Position(Random), Position(Random), Position(Random)};
+        Frame.TrackRotation = {Angle(Random) * 0.5, Angle(Random), Angle(Random) * 0.1};
+        Frame.TrackQuat = RotatorToQuat<FQuat4d>(Frame.TrackRotation);
+        Frame.LookAt = {float(Angle(Random) * 0.5), float(Angle(Random)), 0.f};
+        Frame.TrackFOV = FOV(Random);
+        Frame.Alpha = Unit(Random);
+        Frame.ReferenceDistance = Distance(Random);
+        Frame.CurrentDistance = Distance(Random);
+
+        // Around 60Hz with some jitter
+        Frame.DeltaTime = 1.f / 60.f + (Unit(Random) - 0.5f) * 0.004f;
+    }
+
+    return Frames;
+}
+
+// Run Body once per frame and report nanoseconds per call. Body returns something to fold into the checksum
+template <typename BodyType> double Measure(const char *Name, int64_t NumFrames, double &Checksum, BodyType Body)
+{
+    const auto Start = std::chrono::steady_clock::now();
+
+    double Sum = 0.0;
+    for (int64_t Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        Sum += Body(size_t(Frame) % PoolSize);
+    }
+
+    const auto End = std::chrono::steady_clock::now();
+    const double Nanoseconds = double(std::chrono::duration_cast<std::chrono::nanoseconds>(End - Start).count());
+    const double PerOp = Nanoseconds / double(NumFrames);
+
+    std::printf("%-16s %10.3f ns/op\n", Name, PerOp);
+    Checksum += Sum;
+    return PerOp;
+}
+
+// Run Body over the whole pool until NumFrames items are done, and report nanoseconds per item
+template <typename BodyType>
+double MeasureBatch(const char *Name, int64_t NumFrames, double &Checksum, BodyType Body)
+{
+    const int64_t NumBatches = (NumFrames + int64_t(PoolSize) - 1) / int64_t(PoolSize);
+
+    const auto Start = std::chrono::steady_clock::now();
+
+    double Sum = 0.0;
+    for (int64_t Batch = 0; Batch < NumBatches; ++Batch)
+    {
+        Sum += Body();
+    }
+
+    const auto End = std::chrono::steady_clock::now();
+    const double Nanoseconds = double(std::chrono::duration_cast<std::chrono::nanoseconds>(End - Start).count());
+    const double PerOp = Nanoseconds / double(NumBatches * int64_t(PoolSize));
+
+    std::printf("%-16s %10.3f ns/op\n", Name, PerOp);
+    Checksum += Sum;
+    return PerOp;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const int64_t NumFrames = argc > 1 ? std::atoll(argv[1]) : 10000000;
+    if (NumFrames <= 0)
+    {
+        std::fprintf(stderr, "usage: %s [frames]\n", argv[0]);
+        return 1;
+    }
+
+    const auto Frames = MakeFrames();
+    double Checksum = 0.0;
+
+    std::printf("%lld frames\n", static_cast<long long>(NumFrames));
+
+    // Each benchmark carries its state across frames, the same as a camera would
+    FVector3d Location{0.0, 0.0, 0.0};
+    FRotator3d Rotation{0.0, 0.0, 0.0};
+    float FOV = 90.f;
+    Measure("Blend", NumFrames, Checksum, [&](size_t Index) {
+        const auto &Frame = Frames[Index];
+        BlendView(Location, Rotation, FOV, Frame.TrackLocation, Frame.TrackRotation, Frame.TrackFOV, Frame.Alpha);
+        return Location.X + Rotation.Yaw + FOV;
+    });
+
+    // Track rotations stay quaternions, and the view is only turned back into a rotator at the end
+    for (const bool Spherical : {false, true})
+    {
+        Location = {0.0, 0.0, 0.0};
+        FQuat4d Quat{0.0, 0.0, 0.0, 1.0};
+        FOV = 90.f;
+        Measure(Spherical ? "BlendSlerp" : "BlendNLerp", NumFrames, Checksum, [&](size_t Index) {
+            const auto &Frame = Frames[Index];
+            BlendViewQuat(Location, Quat, FOV, Frame.TrackLocation, Frame.TrackQuat, Frame.TrackFOV, Frame.Alpha,
+                          Spherical);
+            return Location.X + Quat.Z + FOV;
+        });
+    }
+
+    FQuat4d Output = RotatorToQuat<FQuat4d>(FRotator3d{10.0, 20.0, 30.0});
+    Measure("QuatToRotator", NumFrames, Checksum, [&](size_t Index) {
+        Output = NLerpQuat(Output, Frames[Index].TrackQuat, 0.01);
+        return QuatToRotator<FRotator3d>(Output).Yaw;
+    });
+
+    Measure("DollyZoom", NumFrames, Checksum, [&](size_t Index) {
+        const auto &Frame = Frames[Index];
+        return double(DollyZoomFOV(Frame.ReferenceDistance, Frame.TrackFOV, Frame.CurrentDistance));
+    });
+
+    // Same work as above, a pool of cameras at a time
+    std::vector<float> ReferenceDistance(PoolSize), ReferenceFOV(PoolSize), CurrentDistance(PoolSize);
+    std::vector<float> BatchFOV(PoolSize);
+    for (size_t Index = 0; Index < PoolSize; ++Index)
+    {
+        ReferenceDistance[Index] = Frames[Index].ReferenceDistance;
+        ReferenceFOV[Index] = Frames[Index].TrackFOV;
+        CurrentDistance[Index] = Frames[Index].CurrentDistance;
+    }
+
+    MeasureBatch("DollyZoomBatch", NumFrames, Checksum, [&]() {
+        DollyZoomFOVBatch(ReferenceDistance.data(), ReferenceFOV.data(), CurrentDistance.data(), BatchFOV.data(),
+                          int(PoolSize));
+        return double(BatchFOV[0]) + double(BatchFOV[PoolSize - 1]);
+    });
+
+    FRotator3f Aim{0.f, 0.f, 0.f};
+    Measure("AimInterp", NumFrames, Checksum, [&](size_t Index) {
+        const auto &Frame = Frames[Index];
+        Aim = RInterpTo(Aim, Frame.LookAt, Frame.DeltaTime, 8.f);
+        return double(Aim.Yaw);
+    });
+
+    FVector3d Return{0.0, 0.0, 0.0};
+    Measure("SmoothReturn", NumFrames, Checksum, [&](size_t Index) {
+        const auto &Frame = Frames[Index];
+        Return = VInterpTo(Return, Frame.TrackLocation, Frame.DeltaTime, 10.f);
+        return Return.Z;
+    });
+
+    // The same two chases as springs
+    FRotator3f AimVelocity{0.f, 0.f, 0.f};
+    FRotator3f AimTarget{0.f, 0.f, 0.f};
+    Aim = {0.f, 0.f, 0.f};
+    Measure("AimSpring", NumFrames, Checksum, [&](size_t Index) {
+        const auto &Frame = Frames[Index];
+        SpringDampRotator(Aim, AimVelocity, AimTarget, Frame.LookAt, 0.15f, Frame.DeltaTime);
+        AimTarget = Frame.LookAt;
+        return double(Aim.Yaw);
+    });
+
+    FVector3d ReturnVelocity{0.0, 0.0, 0.0};
+    FVector3d ReturnTarget{0.0, 0.0, 0.0};
+    Return = {0.0, 0.0, 0.0};
+    Measure("ReturnSpring", NumFrames, Checksum, [&](size_t Index) {
+        const auto &Frame = Frames[Index];
+        SpringDampVector(Return, ReturnVelocity, ReturnTarget, Frame.TrackLocation, 0.1, double(Frame.DeltaTime));
+        ReturnTarget = Frame.TrackLocation;
+        return Return.Z;
+    });
+
+    // A pool of springs at a time, chasing still targets
+    std::vector<float> SpringValue(PoolSize), SpringVelocity(PoolSize), SpringTarget(PoolSize), SpringTime(PoolSize);
+    for (size_t Index = 0; Index < PoolSize; ++Index)
+    {
+        SpringTarget[Index] = Frames[Index].LookAt.Yaw;
+        SpringTime[Index] = 0.05f + Frames[Index].Alpha * 0.3f;
+    }
+
+    size_t SpringFrame = 0;
+    MeasureBatch("SpringBatch", NumFrames, Checksum, [&]() {
+        SpringDampBatch(SpringValue.data(), SpringVelocity.data(), SpringTarget.data(), SpringTarget.data(),
+                        SpringTime.data(), int(PoolSize), Frames[SpringFrame++ % PoolSize].DeltaTime);
+        return double(SpringValue[0]) + double(SpringValue[PoolSize - 1]);
+    });
+
+    // Printed so none of the above can be optimised away
+    std::printf("checksum %g\n", Checksum);
+    return 0;
+}
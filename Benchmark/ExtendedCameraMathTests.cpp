@@ -0,0 +1,454 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#include "ExtendedCameraCurve.h"
+#include "ExtendedCameraMath.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace ExtendedCameraMath;
+
+using FQuat4d = TQuat4<double>;
+using FRotator3d = TRotator3<double>;
+
+namespace
+{
+int Failures = 0;
+
+void Check(bool Condition, const char *What)
+{
+    if (!Condition)
+    {
+        std::printf("FAILED: %s\n", What);
+        ++Failures;
+    }
+}
+
+// Batched dolly zoom against the double precision scalar path
+void TestDollyZoomBatchAccuracy()
+{
+    std::vector<float> ReferenceDistance, ReferenceFOV, CurrentDistance;
+    for (float FOV = 1.f; FOV <= 170.f; FOV += 0.5f)
+    {
+        // Subjects from 50x closer to 50x further away than they were framed
+        for (float Exponent = -1.7f; Exponent <= 1.7f; Exponent += 0.05f)
+        {
+            ReferenceDistance.push_back(500.f);
+            ReferenceFOV.push_back(FOV);
+            CurrentDistance.push_back(500.f * std::pow(10.f, Exponent));
+        }
+    }
+
+    // Odd so the scalar tail is covered too
+    ReferenceDistance.push_back(123.f);
+    ReferenceFOV.push_back(37.f);
+    CurrentDistance.push_back(456.f);
+
+    const int Count = int(ReferenceFOV.size());
+    std::vector<float> Batched(Count);
+    DollyZoomFOVBatch(ReferenceDistance.data(), ReferenceFOV.data(), CurrentDistance.data(), Batched.data(), Count);
+
+    double MaxError = 0.0;
+    double MaxScalarDifference = 0.0;
+    for (int Index = 0; Index < Count; ++Index)
+    {
+        const double Reference =
+            DollyZoomFOV(double(ReferenceDistance[Index]), double(ReferenceFOV[Index]), double(CurrentDistance[Index]));
+        const double Fast = FastDollyZoomFOV(ReferenceDistance[Index], ReferenceFOV[Index], CurrentDistance[Index]);
+
+        MaxError = std::fmax(MaxError, std::fabs(double(Batched[Index]) - Reference));
+        MaxScalarDifference = std::fmax(MaxScalarDifference, std::fabs(double(Batched[Index]) - Fast));
+    }
+
+    std::printf("DollyZoomFOVBatch: %d samples, max error %.3g degrees, max scalar difference %.3g degrees\n", Count,
+                MaxError, MaxScalarDifference);
+
+    Check(MaxError <= FastDollyZoomMaxError, "DollyZoomFOVBatch within FastDollyZoomMaxError of DollyZoomFOV");
+    Check(MaxScalarDifference <= FastDollyZoomMaxError, "DollyZoomFOVBatch matches FastDollyZoomFOV");
+}
+
+void TestDollyZoomBatchAliasing()
+{
+    float Distance[5] = {100.f, 200.f, 300.f, 400.f, 500.f};
+    float FOV[5] = {90.f, 60.f, 45.f, 30.f, 20.f};
+    float Current[5] = {50.f, 400.f, 300.f, 1000.f, 10.f};
+
+    float Expected[5];
+    for (int Index = 0; Index < 5; ++Index)
+    {
+        Expected[Index] = FastDollyZoomFOV(Distance[Index], FOV[Index], Current[Index]);
+    }
+
+    // Writing over the FOVs in place
+    DollyZoomFOVBatch(Distance, FOV, Current, FOV, 5);
+
+    bool Matches = true;
+    for (int Index = 0; Index < 5; ++Index)
+    {
+        Matches &= std::fabs(FOV[Index] - Expected[Index]) <= FastDollyZoomMaxError;
+    }
+    Check(Matches, "DollyZoomFOVBatch in place");
+}
+
+void TestFastTrig()
+{
+    double MaxTan = 0.0;
+    for (float X = 0.f; X < float(DegreesToRadians(89.0)); X += 1.e-4f)
+    {
+        MaxTan = std::fmax(MaxTan, std::fabs(FastTan(X) / std::tan(double(X)) - 1.0) * (X > 0.f));
+    }
+
+    double MaxAtan = 0.0;
+    for (float X = -100.f; X <= 100.f; X += 1.e-3f)
+    {
+        MaxAtan = std::fmax(MaxAtan, std::fabs(FastAtan(X) - std::atan(double(X))));
+    }
+
+    std::printf("FastTan max relative error %.3g, FastAtan max error %.3g radians\n", MaxTan, MaxAtan);
+
+    Check(MaxTan < 1.e-5, "FastTan relative error");
+    Check(MaxAtan < 2.e-7, "FastAtan absolute error");
+}
+// Angle in degrees between the rotations two quaternions stand for
+double QuatAngle(const FQuat4d &A, const FQuat4d &B)
+{
+    return RadiansToDegrees(2.0 * std::acos(std::fmin(std::fabs(QuatDot(A, B)), 1.0)));
+}
+
+void TestQuatConversion()
+{
+    // Away from the poles a rotator survives the round trip exactly
+    double MaxError = 0.0;
+    for (double Pitch = -85.0; Pitch <= 85.0; Pitch += 17.0)
+    {
+        for (double Yaw = -180.0; Yaw < 180.0; Yaw += 15.0)
+        {
+            for (double Roll = -180.0; Roll < 180.0; Roll += 30.0)
+            {
+                const auto Back = QuatToRotator<FRotator3d>(RotatorToQuat<FQuat4d>(FRotator3d{Pitch, Yaw, Roll}));
+                MaxError = std::fmax(MaxError, std::fabs(NormalizeAxis(Back.Pitch - Pitch)));
+                MaxError = std::fmax(MaxError, std::fabs(NormalizeAxis(Back.Yaw - Yaw)));
+                MaxError = std::fmax(MaxError, std::fabs(NormalizeAxis(Back.Roll - Roll)));
+            }
+        }
+    }
+
+    // At the poles only the rotation itself has to survive
+    const auto Pole = RotatorToQuat<FQuat4d>(FRotator3d{90.0, 40.0, 10.0});
+    const double PoleError = QuatAngle(Pole, RotatorToQuat<FQuat4d>(QuatToRotator<FRotator3d>(Pole)));
+
+    std::printf("Quat round trip max error %.3g degrees, %.3g at the pole\n", MaxError, PoleError);
+
+    Check(MaxError < 1.e-9, "RotatorToQuat and QuatToRotator round trip");
+    Check(PoleError < 1.e-6, "QuatToRotator at the pole");
+}
+
+void TestQuatBlend()
+{
+    // Either side of the wrap. An Euler lerp of the yaw goes the long way round through zero
+    const auto A = RotatorToQuat<FQuat4d>(FRotator3d{0.0, 170.0, 0.0});
+    const auto B = RotatorToQuat<FQuat4d>(FRotator3d{0.0, -170.0, 0.0});
+
+    // B's negation is the same rotation, and must blend the same way
+    const FQuat4d NegatedB{-B.X, -B.Y, -B.Z, -B.W};
+
+    for (const auto &Target : {B, NegatedB})
+    {
+        const auto Slerped = QuatToRotator<FRotator3d>(SlerpQuat(A, Target, 0.5));
+        const auto NLerped = QuatToRotator<FRotator3d>(NLerpQuat(A, Target, 0.5));
+        Check(std::fabs(NormalizeAxis(Slerped.Yaw - 180.0)) < 1.e-9, "SlerpQuat takes the shortest arc");
+        Check(std::fabs(NormalizeAxis(NLerped.Yaw - 180.0)) < 1.e-9, "NLerpQuat takes the shortest arc");
+    }
+
+    // Slerp turns at a constant rate, NLerp only matches it at the ends and the middle
+    const auto From = RotatorToQuat<FQuat4d>(FRotator3d{-30.0, 0.0, 10.0});
+    const auto To = RotatorToQuat<FQuat4d>(FRotator3d{45.0, 120.0, -20.0});
+    const double Total = QuatAngle(From, To);
+
+    double MaxSlerpError = 0.0;
+    for (double Alpha = 0.0; Alpha <= 1.0; Alpha += 0.125)
+    {
+        const double Turned = QuatAngle(From, SlerpQuat(From, To, Alpha));
+        MaxSlerpError = std::fmax(MaxSlerpError, std::fabs(Turned - Total * Alpha));
+    }
+    Check(MaxSlerpError < 1.e-9, "SlerpQuat turns at a constant rate");
+    Check(QuatAngle(NLerpQuat(From, To, 0.5), SlerpQuat(From, To, 0.5)) < 1.e-9, "NLerpQuat meets SlerpQuat halfway");
+
+    // Nearly parallel quaternions fall back to a lerp rather than divide by nearly zero
+    const auto Near = RotatorToQuat<FQuat4d>(FRotator3d{-30.0, 0.001, 10.0});
+    const auto Halfway = SlerpQuat(From, Near, 0.5);
+    Check(std::fabs(QuatDot(Halfway, Halfway) - 1.0) < 1.e-12, "SlerpQuat of nearly parallel quaternions");
+
+    // Fully weighted tracks replace the view, with the exact quaternion they were given
+    TVector3<double> Location{1.0, 2.0, 3.0};
+    auto Rotation = From;
+    double FOV = 90.0;
+    BlendViewQuat(Location, Rotation, FOV, TVector3<double>{4.0, 5.0, 6.0}, NegatedB, 60.0, 1.0, true);
+    Check(Rotation.W == NegatedB.W && Location.X == 4.0 && FOV == 60.0, "BlendViewQuat snaps at full weight");
+}
+void TestSpring()
+{
+    // A still target lands in the same place whatever the frame rate, and never overshoots
+    const double Rates[] = {1.0, 30.0, 60.0, 144.0};
+    double Landed[4];
+    bool Overshot = false;
+    for (int Rate = 0; Rate < 4; ++Rate)
+    {
+        double Value = 0.0, Velocity = 0.0;
+        for (int Frame = 0; Frame < int(Rates[Rate]); ++Frame)
+        {
+            SpringDamp(Value, Velocity, 100.0, 0.3, 1.0 / Rates[Rate]);
+            Overshot |= Value > 100.0;
+        }
+        Landed[Rate] = Value;
+    }
+
+    std::printf("Spring after 1s at 1, 30, 60, 144Hz: %.12g %.12g %.12g %.12g\n", Landed[0], Landed[1], Landed[2],
+                Landed[3]);
+
+    Check(std::fabs(Landed[0] - Landed[3]) < 1.e-9 && std::fabs(Landed[1] - Landed[2]) < 1.e-9 &&
+              std::fabs(Landed[1] - Landed[3]) < 1.e-9,
+          "SpringDamp is frame rate independent");
+    Check(!Overshot, "SpringDamp doesn't overshoot a still target");
+
+    // A huge step still settles
+    double Value = 0.0, Velocity = 500.0;
+    SpringDamp(Value, Velocity, 100.0, 0.1, 1000.0);
+    Check(std::fabs(Value - 100.0) < 1.e-9 && std::fabs(Velocity) < 1.e-9, "SpringDamp is stable for long steps");
+
+    // A spike over a moving target matches the short frames it stood in for
+    double Spiked = 0.0, SpikedVelocity = 0.0;
+    SpringDampSubstepped(Spiked, SpikedVelocity, 0.0, 60.0, 0.2, 0.1);
+
+    double Stepped = 0.0, SteppedVelocity = 0.0;
+    for (int Frame = 1; Frame <= 6; ++Frame)
+    {
+        SpringDamp(Stepped, SteppedVelocity, Frame * 10.0, 0.2, 1.0 / 60.0);
+    }
+    Check(std::fabs(Spiked - Stepped) < 1.e-9 && std::fabs(SpikedVelocity - SteppedVelocity) < 1.e-9,
+          "SpringDampSubstepped matches short frames");
+
+    // Rotators go the short way round
+    FRotator3d Rotation{0.0, 170.0, 0.0}, AngularVelocity{0.0, 0.0, 0.0};
+    const FRotator3d Target{0.0, -170.0, 0.0};
+    SpringDampRotator(Rotation, AngularVelocity, Target, Target, 0.2, 1.0 / 60.0);
+    Check(Rotation.Yaw > 170.0 && AngularVelocity.Yaw > 0.0, "SpringDampRotator takes the shortest way round");
+}
+
+void TestSpringBatch()
+{
+    // Out to where the result goes denormal
+    double MaxRelative = 0.0;
+    for (float X = 0.f; X <= 87.f; X += 1.e-3f)
+    {
+        MaxRelative = std::fmax(MaxRelative, std::fabs(FastNegExp(X) / std::exp(-double(X)) - 1.0));
+    }
+
+    std::printf("FastNegExp max relative error %.3g\n", MaxRelative);
+    Check(MaxRelative < 1.e-5, "FastNegExp relative error");
+
+    // Odd, with a snapping spring, so everything is covered
+    const int Count = 37;
+    std::vector<float> Value(Count), Velocity(Count), Previous(Count), Target(Count), SmoothTime(Count);
+    std::vector<double> ScalarValue(Count), ScalarVelocity(Count);
+    for (int Index = 0; Index < Count; ++Index)
+    {
+        Value[Index] = float(Index * 10);
+        Velocity[Index] = float(Index % 5) * 20.f - 40.f;
+        SmoothTime[Index] = Index == 3 ? 0.f : 0.05f + 0.02f * float(Index);
+        ScalarValue[Index] = Value[Index];
+        ScalarVelocity[Index] = Velocity[Index];
+    }
+
+    // Moving targets and a spike or two along the way
+    double MaxDifference = 0.0;
+    for (int Frame = 0; Frame < 120; ++Frame)
+    {
+        const float DeltaTime = Frame % 40 == 39 ? 0.2f : 1.f / 60.f;
+        for (int Index = 0; Index < Count; ++Index)
+        {
+            Previous[Index] = Target[Index];
+            Target[Index] = 500.f + float(Frame * Index) * 0.5f;
+        }
+
+        SpringDampBatch(Value.data(), Velocity.data(), Previous.data(), Target.data(), SmoothTime.data(), Count,
+                        DeltaTime);
+
+        for (int Index = 0; Index < Count; ++Index)
+        {
+            SpringDampSubstepped(ScalarValue[Index], ScalarVelocity[Index], double(Previous[Index]),
+                                 double(Target[Index]), double(SmoothTime[Index]), double(DeltaTime));
+
+            // Relative to how far the spring has to go, which is what FastNegExp's error scales with
+            const double Scale = std::fmax(1.0, std::fabs(ScalarValue[Index] - double(Target[Index])) + 100.0);
+            MaxDifference = std::fmax(MaxDifference, std::fabs(Value[Index] - ScalarValue[Index]) / Scale);
+        }
+    }
+
+    std::printf("SpringDampBatch max difference %.3g of the distance to go\n", MaxDifference);
+    Check(MaxDifference < 1.e-5, "SpringDampBatch matches SpringDampSubstepped");
+    Check(std::fabs(Value[3] - Target[3]) < 1.e-3f && std::fabs(Velocity[3]) < 1.e-3f,
+          "SpringDampBatch snaps with no smooth time");
+}
+
+// A crane move that flies a long way, holds still, then pans and zooms
+std::vector<ExtendedCameraCurve::FCurveKey> MakeCurveSamples(int Count)
+{
+    std::vector<ExtendedCameraCurve::FCurveKey> Samples(Count);
+    for (int Index = 0; Index < Count; ++Index)
+    {
+        const double Time = Index / 60.0;
+        const double Moving = std::fmin(Time, 5.0);
+        const double Panning = std::fmax(Time - 7.0, 0.0);
+
+        auto &Sample = Samples[Index];
+        Sample.Location = {Moving * 2000.0, 300.0 * std::sin(Moving), 150.0 + 50.0 * std::cos(Moving * 2.0)};
+        Sample.Rotation = RotatorToQuat<FQuat4d>(FRotator3d{-10.0 * std::sin(Moving), 40.0 * Panning, 0.0});
+        Sample.FOV = float(90.0 - 5.0 * Panning);
+    }
+    return Samples;
+}
+
+void TestCurveCodec()
+{
+    using namespace ExtendedCameraCurve;
+
+    const int Count = 600;
+    const auto Samples = MakeCurveSamples(Count);
+    const FCurveSettings Settings;
+    const auto Encoded = Encode(Samples.data(), Count, 60.f, Settings);
+
+    FCurveDecoder Decoder;
+    if (!Decoder.Open(Encoded.data(), Encoded.size()))
+    {
+        Check(false, "Curve opens");
+        return;
+    }
+
+    // Keys are quantised after the tolerance check, which the bounds allow for
+    const double PositionBound = Settings.PositionTolerance + Settings.PositionPrecision;
+    const double AngleBound = Settings.AngleTolerance + 0.01;
+    const double FOVBound = Settings.FOVTolerance + 0.01;
+
+    double MaxPosition = 0.0, MaxAngle = 0.0, MaxFOV = 0.0;
+    for (int Index = 0; Index < Count; ++Index)
+    {
+        FCurveKey Key{};
+        Decoder.Evaluate(Index / 60.0, Key);
+
+        const auto &Sample = Samples[Index];
+        const double DX = Key.Location.X - Sample.Location.X;
+        const double DY = Key.Location.Y - Sample.Location.Y;
+        const double DZ = Key.Location.Z - Sample.Location.Z;
+        MaxPosition = std::fmax(MaxPosition, std::sqrt(DX * DX + DY * DY + DZ * DZ));
+        MaxAngle = std::fmax(MaxAngle, AngleBetween(Key.Rotation, Sample.Rotation));
+        MaxFOV = std::fmax(MaxFOV, std::fabs(double(Key.FOV) - double(Sample.FOV)));
+    }
+
+    // What a key would cost unquantised, as doubles for the location and rotation
+    const double RawSize = double(Count) * (3 * 8 + 4 * 8 + 4);
+    std::printf("Curve keeps %u of %d keys in %zu bytes, %.1fx smaller, max error %.3g units %.3g deg %.3g deg\n",
+                Decoder.GetNumKeys(), Count, Encoded.size(), RawSize / Encoded.size(), MaxPosition, MaxAngle,
+                MaxFOV);
+    Check(MaxPosition <= PositionBound, "Curve position error within tolerance");
+    Check(MaxAngle <= AngleBound, "Curve rotation error within tolerance");
+    Check(MaxFOV <= FOVBound, "Curve FOV error within tolerance");
+    Check(RawSize / Encoded.size() > 8.0, "Curve compresses");
+    Check(std::fabs(Decoder.GetDuration() - (Count - 1) / 60.0) < 1.e-9, "Curve duration");
+
+    // Seeking anywhere gives what playing forward did
+    std::vector<FCurveKey> Sequential(Count * 4);
+    for (int Index = 0; Index < Count * 4; ++Index)
+    {
+        Decoder.Evaluate(Index / 240.0, Sequential[Index]);
+    }
+
+    bool SeeksMatch = true;
+    std::srand(7);
+    for (int Seek = 0; Seek < 2000; ++Seek)
+    {
+        const int Index = std::rand() % (Count * 4);
+        FCurveKey Key{};
+        Decoder.Evaluate(Index / 240.0, Key);
+        const auto &Expected = Sequential[Index];
+        SeeksMatch &= Key.Location.X == Expected.Location.X && Key.Location.Y == Expected.Location.Y &&
+                      Key.Location.Z == Expected.Location.Z && Key.FOV == Expected.FOV &&
+                      QuatDot(Key.Rotation, Expected.Rotation) > 1.0 - 1.e-12;
+    }
+    Check(SeeksMatch, "Curve seeks match sequential playback");
+
+    // Closing drops the bytes and the cached keys, so a reopen decodes afresh
+    Decoder.Close();
+    FCurveKey Closed{};
+    Check(!Decoder.IsOpen() && !Decoder.Evaluate(1.0, Closed), "Closed curve evaluates nothing");
+    Check(Decoder.Open(Encoded.data(), Encoded.size()), "Curve reopens");
+
+    // Held at either end
+    FCurveKey Before{}, After{};
+    Decoder.Evaluate(-1.0, Before);
+    Decoder.Evaluate(100.0, After);
+    Check(Before.Location.X == Sequential.front().Location.X, "Curve holds the first key");
+    Check(std::fabs(After.Location.X - Samples.back().Location.X) <= PositionBound, "Curve holds the last key");
+
+    // A camera that never moves keeps only the keys the gap limit forces
+    const std::vector<FCurveKey> Still(Count, Samples[0]);
+    const auto StillEncoded = Encode(Still.data(), Count, 60.f, Settings);
+    const uint32_t StillKeys = 1 + (Count - 1 + MaxKeyGap - 1) / MaxKeyGap;
+    Check(Decoder.Open(StillEncoded.data(), StillEncoded.size()) && Decoder.GetNumKeys() == StillKeys,
+          "Curve drops the keys of a still camera");
+
+    // Anything else is refused
+    auto Corrupt = Encoded;
+    Corrupt[0] ^= 1;
+    Check(!Decoder.Open(Corrupt.data(), Corrupt.size()), "Curve rejects bad magic");
+    Check(!Decoder.Open(Encoded.data(), Encoded.size() - 1), "Curve rejects truncated data");
+
+    // Indices that reach outside the data, or run backwards, are refused too
+    const size_t NumSegments = GetBytes(Encoded.data() + 28, 4);
+    const size_t FirstKeyOffset = HeaderSize + NumSegments * SegmentSize;
+    Check(NumSegments > 1, "Curve has segments to corrupt");
+
+    Corrupt = Encoded;
+    Corrupt[HeaderSize + SegmentSize + 4] = 0xFF;
+    Corrupt[HeaderSize + SegmentSize + 5] = 0xFF;
+    Check(!Decoder.Open(Corrupt.data(), Corrupt.size()), "Curve rejects a segment past the last key");
+
+    Corrupt = Encoded;
+    std::memcpy(Corrupt.data() + HeaderSize + SegmentSize + 4, Encoded.data() + HeaderSize + 4, 4);
+    Check(!Decoder.Open(Corrupt.data(), Corrupt.size()), "Curve rejects segments that don't go up");
+
+    Corrupt = Encoded;
+    std::memcpy(Corrupt.data() + HeaderSize + SegmentSize, Encoded.data() + HeaderSize, 4);
+    Check(!Decoder.Open(Corrupt.data(), Corrupt.size()), "Curve rejects samples that go back a segment");
+
+    Corrupt = Encoded;
+    Corrupt[FirstKeyOffset + KeySize] = 0xFF;
+    Corrupt[FirstKeyOffset + KeySize + 1] = 0xFF;
+    Check(!Decoder.Open(Corrupt.data(), Corrupt.size()), "Curve rejects a key past the last sample");
+
+    Corrupt = Encoded;
+    std::memcpy(Corrupt.data() + FirstKeyOffset + KeySize * 2, Corrupt.data() + FirstKeyOffset + KeySize, 2);
+    Check(!Decoder.Open(Corrupt.data(), Corrupt.size()), "Curve rejects keys that don't go up");
+
+    Check(!Decoder.IsOpen(), "Rejected curves stay closed");
+    Check(Decoder.Open(Encoded.data(), Encoded.size()), "Curve still opens intact");
+}
+} // namespace
+
+int main()
+{
+    TestFastTrig();
+    TestDollyZoomBatchAccuracy();
+    TestDollyZoomBatchAliasing();
+    TestQuatConversion();
+    TestQuatBlend();
+    TestSpring();
+    TestSpringBatch();
+    TestCurveCodec();
+
+    std::printf(Failures ? "%d failed\n" : "All passed\n", Failures);
+    return Failures ? 1 : 0;
+}
@@ -37,6 +37,8 @@ public class ExtendedCamera: ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"MovieScene",
+				"SignificanceManager",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
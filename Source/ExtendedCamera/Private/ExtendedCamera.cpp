@@ -1,9 +1,54 @@
 // Copyright Acinonyx Ltd. 2022. All Rights Reserved.
 
 #include "ExtendedCamera.h"
+#include "ExtendedCameraStats.h"
 
 #define LOCTEXT_NAMESPACE "FExtendedCameraModule"
 
+CSV_DEFINE_CATEGORY(ExtendedCamera, true);
+
+DEFINE_STAT(STAT_ACIGetCameraViewInc);
+DEFINE_STAT(STAT_ACIGetCameraViewExc);
+DEFINE_STAT(STAT_ACIAimResolution);
+DEFINE_STAT(STAT_ACITracking);
+DEFINE_STAT(STAT_ACIBlend);
+DEFINE_STAT(STAT_ACILineOfSight);
+DEFINE_STAT(STAT_ACIDollyZoom);
+DEFINE_STAT(STAT_ACISmoothReturn);
+
+DEFINE_STAT(STAT_ACIParallelTracking);
+DEFINE_STAT(STAT_ACISerialTracking);
+DEFINE_STAT(STAT_ACIBatchGather);
+DEFINE_STAT(STAT_ACIBatchEvaluate);
+DEFINE_STAT(STAT_ACIBatchScatter);
+DEFINE_STAT(STAT_ACIBatchLineOfSight);
+DEFINE_STAT(STAT_ACISignificance);
+DEFINE_STAT(STAT_ACISchedule);
+
+DEFINE_STAT(STAT_ACITraces);
+DEFINE_STAT(STAT_ACILOSBlocks);
+DEFINE_STAT(STAT_ACIBoneLookups);
+DEFINE_STAT(STAT_ACIBoneCacheHits);
+DEFINE_STAT(STAT_ACILOSCacheHits);
+DEFINE_STAT(STAT_ACILOSCacheMisses);
+DEFINE_STAT(STAT_ACIVisibilityRays);
+DEFINE_STAT(STAT_ACIIdleViews);
+DEFINE_STAT(STAT_ACIFixedSteps);
+DEFINE_STAT(STAT_ACIRecordedFrames);
+DEFINE_STAT(STAT_ACIBakedViews);
+DEFINE_STAT(STAT_ACIParallelTrackedCameras);
+DEFINE_STAT(STAT_ACISerialTrackedCameras);
+DEFINE_STAT(STAT_ACIBatchedCameras);
+DEFINE_STAT(STAT_ACIBatchedLOSTraces);
+DEFINE_STAT(STAT_ACISignificanceThrottled);
+DEFINE_STAT(STAT_ACIReusedLOS);
+DEFINE_STAT(STAT_ACISignificanceBias);
+DEFINE_STAT(STAT_ACICameraMicroseconds);
+DEFINE_STAT(STAT_ACIScheduledWork);
+DEFINE_STAT(STAT_ACIForcedWork);
+DEFINE_STAT(STAT_ACIDeferredLOS);
+DEFINE_STAT(STAT_ACIDeferredBoneLookups);
+
 void FExtendedCameraModule::StartupModule()
 {
     // This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin
@@ -0,0 +1,97 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#include "ExtendedCameraBakedShot.h"
+
+void UExtendedCameraBakedShot::Reset(float InSampleRate, uint32 InBindingsSignature)
+{
+    SampleRate = FMath::Max(InSampleRate, 1.f);
+    BindingsSignature = InBindingsSignature;
+    Keys.Reset();
+    Decoder.Close();
+    CurveData.Reset();
+}
+
+void UExtendedCameraBakedShot::AddKey(const FMinimalViewInfo &View)
+{
+    const auto Rotation = View.Rotation.Quaternion();
+
+    auto &Key = Keys.AddDefaulted_GetRef();
+    Key.Location = {View.Location.X, View.Location.Y, View.Location.Z};
+    Key.Rotation = {Rotation.X, Rotation.Y, Rotation.Z, Rotation.W};
+    Key.FOV = View.FOV;
+}
+
+void UExtendedCameraBakedShot::Compress()
+{
+    ExtendedCameraCurve::FCurveSettings Settings;
+    Settings.PositionTolerance = PositionTolerance;
+    Settings.AngleTolerance = AngleTolerance;
+    Settings.FOVTolerance = FOVTolerance;
+
+    const auto Encoded = ExtendedCameraCurve::Encode(Keys.GetData(), Keys.Num(), SampleRate, Settings);
+    Decoder.Close();
+    CurveData = TArray<uint8>(Encoded.data(), Encoded.size());
+    Keys.Empty();
+    OpenCurve();
+}
+
+void UExtendedCameraBakedShot::PostLoad()
+{
+    Super::PostLoad();
+    OpenCurve();
+}
+
+void UExtendedCameraBakedShot::PostDuplicate(bool bDuplicateForPIE)
+{
+    Super::PostDuplicate(bDuplicateForPIE);
+    OpenCurve();
+}
+
+#if WITH_EDITOR
+void UExtendedCameraBakedShot::PostEditChangeProperty(FPropertyChangedEvent &PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    OpenCurve();
+}
+
+void UExtendedCameraBakedShot::PostEditUndo()
+{
+    Super::PostEditUndo();
+    OpenCurve();
+}
+#endif
+
+void UExtendedCameraBakedShot::OpenCurve()
+{
+    // Open fails and leaves the decoder closed when CurveData is empty or unreadable
+    Decoder.Open(CurveData.GetData(), CurveData.Num());
+}
+
+bool UExtendedCameraBakedShot::Evaluate(float Time, FMinimalViewInfo &OutView) const
+{
+    ExtendedCameraCurve::FCurveKey Key;
+    if (!Decoder.IsOpen() || !Decoder.Evaluate(Time, Key))
+    {
+        return false;
+    }
+
+    OutView.Location = FVector(Key.Location.X, Key.Location.Y, Key.Location.Z);
+    OutView.Rotation = FQuat(Key.Rotation.X, Key.Rotation.Y, Key.Rotation.Z, Key.Rotation.W).Rotator();
+    OutView.FOV = Key.FOV;
+    return true;
+}
+
+float UExtendedCameraBakedShot::GetDuration() const
+{
+    return Decoder.IsOpen() ? float(Decoder.GetDuration()) : 0.f;
+}
+
+int32 UExtendedCameraBakedShot::GetNumKeys() const
+{
+    return Decoder.IsOpen() ? int32(Decoder.GetNumKeys()) : 0;
+}
+
+uint32 UExtendedCameraBakedShot::GetBindingsSignature() const
+{
+    return BindingsSignature;
+}
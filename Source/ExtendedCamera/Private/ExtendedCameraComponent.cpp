@@ -2,9 +2,25 @@
 
 #include "ExtendedCameraComponent.h"
 #include "CollisionQueryParams.h"
+#include "ExtendedCameraBakedShot.h"
+#include "ExtendedCameraCustomVersion.h"
+#include "ExtendedCameraMath.h"
+#include "ExtendedCameraStats.h"
+#include "ExtendedCameraSubsystem.h"
 #include "Engine/World.h"
 #include "GameFramework/Character.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/Paths.h"
+#include "MovieSceneSequencePlayer.h"
+#include "MovieSceneSpawnableAnnotation.h"
+#include "Serialization/CustomVersion.h"
+
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+#include "Engine/SkeletalMesh.h"
+#else
+#include "Engine/SkinnedAsset.h"
+#endif
 
 #if ENABLE_DRAW_DEBUG
 #include "DrawDebugHelpers.h"
@@ -12,8 +28,38 @@
 
 DEFINE_LOG_CATEGORY_STATIC(LogExtendedCamera, Warning, All);
 
+// Call a BlueprintNativeEvent on a component, skipping the thunk unless it's overridden in script
+#define EXTCAM_CALL_ON(Camera, Event, ...)                                                                             \
+    ((Camera).CallsScript(EExtendedCameraScriptEvent::Event) ? (Camera).Event(__VA_ARGS__)                             \
+                                                              : (Camera).Event##_Implementation(__VA_ARGS__))
 
-bool BoneCheck(AActor* Actor, FName TrackedName)
+#define EXTCAM_CALL(Event, ...) EXTCAM_CALL_ON(*this, Event, __VA_ARGS__)
+
+const FGuid FExtendedCameraCustomVersion::GUID(0x5A1C3E27, 0x8B4F4D19, 0x9E62A0C7, 0x3F81D45B);
+
+// Register the custom version with core
+FCustomVersionRegistration GRegisterExtendedCameraCustomVersion(FExtendedCameraCustomVersion::GUID,
+                                                                FExtendedCameraCustomVersion::LatestVersion,
+                                                                TEXT("ExtendedCameraVer"));
+
+
+static const UObject *GetMeshAsset(const USkeletalMeshComponent *Mesh)
+{
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+    return Mesh->SkeletalMesh;
+#else
+    return Mesh->GetSkinnedAsset();
+#endif
+}
+
+// True if Cache was resolved against this mesh, the asset it has now and this bone name
+static bool IsBoneCacheCurrent(const FExtendedCameraBoneCache &Cache, const USkeletalMeshComponent *Mesh,
+                               FName TrackedName)
+{
+    return Cache.Mesh.Get() == Mesh && Cache.MeshAsset.Get() == GetMeshAsset(Mesh) && Cache.BoneName == TrackedName;
+}
+
+bool BoneCheck(AActor* Actor, FName TrackedName, FExtendedCameraBoneCache &Cache)
 {
     // Ask for the bone
     if (IsValid(Actor))
@@ -26,54 +72,269 @@ bool BoneCheck(AActor* Actor, FName TrackedName)
             USkeletalMeshComponent *Mesh = AsCharacter->GetMesh();
             if (Mesh)
             {
-                auto Index = Mesh->GetBoneIndex(TrackedName);
+                // Only search the skeleton when something we resolved against has changed
+                if (!IsBoneCacheCurrent(Cache, Mesh, TrackedName))
+                {
+                    INC_DWORD_STAT(STAT_ACIBoneLookups);
+                    Cache.Mesh = Mesh;
+                    Cache.MeshAsset = GetMeshAsset(Mesh);
+                    Cache.BoneName = TrackedName;
+                    Cache.BoneIndex = Mesh->GetBoneIndex(TrackedName);
+
+                    // Said once here, rather than every frame the miss is read back
+                    if (Cache.BoneIndex == INDEX_NONE)
+                    {
+                        UE_LOG(LogExtendedCamera, Warning, TEXT("Invalid Bone Name (%s) on %s"),
+                               *TrackedName.ToString(), *Actor->GetName());
+                    }
+                }
+                else
+                {
+                    INC_DWORD_STAT(STAT_ACIBoneCacheHits);
+                }
 
-                return Index != INDEX_NONE;
+                return Cache.BoneIndex != INDEX_NONE;
             }
         }
     }
 
+    Cache.Reset();
     return false;
 }
 
+FExtendedCameraBoneCache *UExtendedCameraComponent::FindBoneCache(const AActor *Actor, FName BoneName, bool IsAim)
+{
+    for (auto &Track : CameraTracks)
+    {
+        if (IsAim && Actor == Track.Aim && BoneName == Track.AimBoneName)
+        {
+            return &Track.AimBoneCache;
+        }
+        if (!IsAim && Actor == Track.Locator && BoneName == Track.LocatorBoneName)
+        {
+            return &Track.LocatorBoneCache;
+        }
+    }
+
+    return nullptr;
+}
+
+static constexpr bool UsesLocatorAndAim(EExtendedCameraDriverMode Mode)
+{
+    return Mode == EExtendedCameraDriverMode::LocAndAim || Mode == EExtendedCameraDriverMode::Skeleton ||
+           Mode == EExtendedCameraDriverMode::SkeletonAim || Mode == EExtendedCameraDriverMode::SkeletonLocator;
+}
 
-FVector UExtendedCameraComponent::GetAimLocation_Implementation(AActor *Owner)
+static constexpr bool UsesLocatorBone(EExtendedCameraDriverMode Mode)
 {
-    // Do we need return the aim point?
-    // Or just the ComponentOwner's location?
-    auto OAL = Owner->GetActorLocation();
-    FVector AimPoint = FVector::ZeroVector;
+    return Mode == EExtendedCameraDriverMode::Skeleton || Mode == EExtendedCameraDriverMode::SkeletonLocator;
+}
 
-    if (IsValid(PrimaryTrackAim) && (FirstTrackCameraDriverMode == EExtendedCameraDriverMode::LocAndAim ||
-                                     FirstTrackCameraDriverMode == EExtendedCameraDriverMode::Skeleton ||
-                                     FirstTrackCameraDriverMode == EExtendedCameraDriverMode::SkeletonAim ||
-                                     FirstTrackCameraDriverMode == EExtendedCameraDriverMode::SkeletonLocator))
+static constexpr bool UsesAimBone(EExtendedCameraDriverMode Mode)
+{
+    return Mode == EExtendedCameraDriverMode::Skeleton || Mode == EExtendedCameraDriverMode::SkeletonAim;
+}
+
+// True if BoneCheck would have to search the skeleton for this bone
+static bool NeedsBoneLookup(const AActor *Actor, FName TrackedName, const FExtendedCameraBoneCache &Cache)
+{
+    const auto AsCharacter = IsValid(Actor) ? Cast<ACharacter>(Actor) : nullptr;
+    const auto Mesh = AsCharacter ? AsCharacter->GetMesh() : nullptr;
+    return Mesh && !IsBoneCacheCurrent(Cache, Mesh, TrackedName);
+}
+
+// Stands in for a bone whose search the schedule has held back. The bone the cache last found, while it's still on
+// the mesh asset it was found on, or else the actor
+static FTransform GetDeferredBoneTransform(const AActor *Actor, const FExtendedCameraBoneCache &Cache)
+{
+    const auto Mesh = Cache.Mesh.Get();
+    if (Mesh && Cache.BoneIndex != INDEX_NONE && Cache.MeshAsset.Get() == GetMeshAsset(Mesh))
     {
-        AimPoint = FMath::Lerp(OAL,
-                               GetActorAimLocation(PrimaryTrackAim, FirstTrackCameraDriverMode, PrimaryAimBoneName)
-                                   .TransformPosition(PrimaryTrackAimOffset),
-                               CameraPrimaryTrackBlendAlpha);
+        return Mesh->GetBoneTransform(Cache.BoneIndex);
     }
-    else
+
+    return Actor->GetActorTransform();
+}
+
+static bool NeedsBoneLookup(const FExtendedCameraTrack &Track)
+{
+    return (UsesLocatorBone(Track.DriverMode) &&
+            NeedsBoneLookup(Track.Locator, Track.LocatorBoneName, Track.LocatorBoneCache)) ||
+           (UsesAimBone(Track.DriverMode) && NeedsBoneLookup(Track.Aim, Track.AimBoneName, Track.AimBoneCache));
+}
+
+static bool SetTrackLocatorBone(FExtendedCameraTrack &Track, FName TrackedBoneName)
+{
+    Track.LocatorBoneName = TrackedBoneName;
+
+    if (UsesLocatorBone(Track.DriverMode))
     {
-        // Get normal
-        AimPoint = OAL;
+        return BoneCheck(Track.Locator, TrackedBoneName, Track.LocatorBoneCache);
     }
 
-    if (IsValid(SecondaryTrackAim) && (SecondTrackCameraDriverMode == EExtendedCameraDriverMode::LocAndAim ||
-                                       SecondTrackCameraDriverMode == EExtendedCameraDriverMode::Skeleton ||
-                                       SecondTrackCameraDriverMode == EExtendedCameraDriverMode::SkeletonAim ||
-                                       SecondTrackCameraDriverMode == EExtendedCameraDriverMode::SkeletonLocator))
+    return false;
+}
+
+static bool SetTrackAimBone(FExtendedCameraTrack &Track, FName TrackedAimName)
+{
+    Track.AimBoneName = TrackedAimName;
+
+    if (UsesAimBone(Track.DriverMode))
     {
-        AimPoint = FMath::Lerp(AimPoint,
-                               GetActorAimLocation(SecondaryTrackAim, SecondTrackCameraDriverMode, SecondaryAimBoneName)
-                                   .TransformPosition(SecondaryTrackAimOffset),
-                               CameraSecondaryTrackBlendAlpha);
+        return BoneCheck(Track.Aim, TrackedAimName, Track.AimBoneCache);
     }
-    else
+
+    return false;
+}
+
+// Keep how far along the old segment a hit was blocked, and move it onto this one. Same as the async path
+static void PlaceHitOnSegment(FHitResult &Hit, const FVector &Start, const FVector &End)
+{
+    if (Hit.bBlockingHit)
+    {
+        const auto Shift = FMath::Lerp(Start, End, Hit.Time) - Hit.Location;
+        Hit.Location += Shift;
+        Hit.ImpactPoint += Shift;
+    }
+    Hit.TraceStart = Start;
+    Hit.TraceEnd = End;
+}
+
+// A probe's trace result, and the segment it was traced on
+static void SetVisibilityProbeResult(FExtendedCameraVisibilityProbe &Probe, const FHitResult &Hit,
+                                     const FVector &Start, const FVector &End)
+{
+    Probe.Visible = !Hit.bBlockingHit;
+    Probe.BlockedTime = Hit.bBlockingHit ? Hit.Time : 1.f;
+    Probe.BlockedNormal = Hit.ImpactNormal;
+    Probe.TracedStart = Start;
+    Probe.TracedEnd = End;
+    Probe.TracedFrameNumber = GFrameCounter;
+}
+
+// Debug colours for the aim boxes, per track
+static const FColor TrackDebugColours[] = {FColor(200, 200, 32, 128), FColor(250, 150, 32, 128),
+                                           FColor(32, 200, 200, 128), FColor(150, 32, 250, 128)};
+
+void UExtendedCameraComponent::BuildEvaluationContext(AActor *Owner)
+{
+    EXTCAM_STAGE_SCOPE(AimResolution);
+
+    EvaluationContext.FrameNumber = GFrameCounter;
+    EvaluationContext.Owner = Owner;
+    EvaluationContext.OwnerLocation = IsValid(Owner) ? Owner->GetActorLocation() : FVector::ZeroVector;
+    EvaluationContext.Tracks.SetNum(CameraTracks.Num(), false);
+
+    // Only the bone searches wait on the subsystem's schedule. Everything else is read every frame
+    const bool CanLookUpBones = IsBoneResolutionScheduled();
+
+    for (int32 Index = 0; Index < CameraTracks.Num(); ++Index)
+    {
+        const auto &Track = CameraTracks[Index];
+        auto &Context = EvaluationContext.Tracks[Index];
+
+        const bool LocatorLookup = UsesLocatorBone(Track.DriverMode) &&
+                                   NeedsBoneLookup(Track.Locator, Track.LocatorBoneName, Track.LocatorBoneCache);
+        const bool AimLookup =
+            UsesAimBone(Track.DriverMode) && NeedsBoneLookup(Track.Aim, Track.AimBoneName, Track.AimBoneCache);
+        const bool LooksUpBones = CanLookUpBones && (LocatorLookup || AimLookup);
+
+        const uint64 StartCycles = LooksUpBones ? FPlatformTime::Cycles64() : 0;
+
+        Context.Alpha = Track.BlendAlpha;
+        Context.HasLocator = UsesLocatorAndAim(Track.DriverMode) && IsValid(Track.Locator);
+        Context.HasAim = UsesLocatorAndAim(Track.DriverMode) && IsValid(Track.Aim);
+
+        // Off the game thread we've already checked these aren't overridden in script
+        if (Context.HasLocator)
+        {
+            Context.Locator =
+                LocatorLookup && !CanLookUpBones
+                    ? GetDeferredBoneTransform(Track.Locator, Track.LocatorBoneCache).GetLocation()
+                    : EXTCAM_CALL(GetActorTrackLocation, Track.Locator, Track.DriverMode, Track.LocatorBoneName);
+        }
+
+        if (Context.HasAim)
+        {
+            Context.Aim = AimLookup && !CanLookUpBones
+                              ? GetDeferredBoneTransform(Track.Aim, Track.AimBoneCache)
+                              : EXTCAM_CALL(GetActorAimLocation, Track.Aim, Track.DriverMode, Track.AimBoneName);
+            Context.AimPoint = Context.Aim.TransformPosition(Track.AimOffset);
+        }
+
+        if (LooksUpBones)
+        {
+            BoneResolutionCycles += FPlatformTime::Cycles64() - StartCycles;
+        }
+    }
+}
+
+bool UExtendedCameraComponent::HasEvaluationContext(const AActor *Owner) const
+{
+    return EvaluationContext.FrameNumber == GFrameCounter && EvaluationContext.Owner == Owner &&
+           EvaluationContext.Tracks.Num() == CameraTracks.Num();
+}
+
+void UExtendedCameraComponent::RefreshEvaluationContext(AActor *Owner)
+{
+    if (HasEvaluationContext(Owner))
+    {
+        return;
+    }
+
+    // Nothing held to carry over, or it was held for someone else
+    if (EvaluationContext.Owner != Owner || EvaluationContext.Tracks.Num() != CameraTracks.Num())
+    {
+        BuildEvaluationContext(Owner);
+        return;
+    }
+
+    // The aims stay as the held tracks were tracked from. The rest is cheap, and the blend reads it live
+    EvaluationContext.FrameNumber = GFrameCounter;
+    EvaluationContext.OwnerLocation = IsValid(Owner) ? Owner->GetActorLocation() : FVector::ZeroVector;
+
+    for (int32 Index = 0; Index < CameraTracks.Num(); ++Index)
+    {
+        EvaluationContext.Tracks[Index].Alpha = CameraTracks[Index].BlendAlpha;
+    }
+}
+
+FVector UExtendedCameraComponent::GetAimLocation_Implementation(AActor *Owner)
+{
+    // Do we need return the aim point?
+    // Or just the ComponentOwner's location?
+    // Each track pulls the aim towards its own by its blend amount
+    if (HasEvaluationContext(Owner))
+    {
+        // Prefer what GetCameraView already resolved this frame
+        const auto &OAL = EvaluationContext.OwnerLocation;
+        FVector AimPoint = OAL;
+
+        for (const auto &Context : EvaluationContext.Tracks)
+        {
+            AimPoint = FMath::Lerp(AimPoint, Context.HasAim ? Context.AimPoint : OAL, Context.Alpha);
+        }
+
+        return AimPoint;
+    }
+
+    auto OAL = Owner->GetActorLocation();
+    FVector AimPoint = OAL;
+
+    for (const auto &Track : CameraTracks)
     {
-        // Get normal
-        AimPoint = FMath::Lerp(AimPoint, OAL, CameraSecondaryTrackBlendAlpha);
+        if (IsValid(Track.Aim) && UsesLocatorAndAim(Track.DriverMode))
+        {
+            AimPoint = FMath::Lerp(AimPoint,
+                                   EXTCAM_CALL(GetActorAimLocation, Track.Aim, Track.DriverMode, Track.AimBoneName)
+                                       .TransformPosition(Track.AimOffset),
+                                   Track.BlendAlpha);
+        }
+        else
+        {
+            // Get normal
+            AimPoint = FMath::Lerp(AimPoint, OAL, Track.BlendAlpha);
+        }
     }
 
     return AimPoint;
@@ -91,6 +352,20 @@ FVector UExtendedCameraComponent::GetActorTrackLocation_Implementation(AActor *O
     else if (EExtendedCameraDriverMode::Skeleton == CameraMode ||
              EExtendedCameraDriverMode::SkeletonLocator == CameraMode)
     {
+        // Fast path. Our own tracks keep the bone index around
+        FExtendedCameraBoneCache *Cache = FindBoneCache(Owner, LocatorBoneName, false);
+        if (Cache && BoneCheck(Owner, LocatorBoneName, *Cache))
+        {
+            return Cache->Mesh->GetBoneTransform(Cache->BoneIndex).GetLocation();
+        }
+
+        // The cache knows the mesh doesn't have the bone, so don't search for it again. This falls back to the actor,
+        // where the search below gives zero
+        if (Cache && Cache->Mesh.IsValid())
+        {
+            return Owner->GetActorLocation();
+        }
+
         // Ask for the bone
         auto AsCharacter = Cast<ACharacter>(Owner);
         if (AsCharacter)
@@ -130,6 +405,20 @@ FTransform UExtendedCameraComponent::GetActorAimLocation_Implementation(AActor *
     }
     else if (EExtendedCameraDriverMode::Skeleton == CameraMode || EExtendedCameraDriverMode::SkeletonAim == CameraMode)
     {
+        // Fast path. Our own tracks keep the bone index around
+        FExtendedCameraBoneCache *Cache = FindBoneCache(Owner, LocatorBoneName, true);
+        if (Cache && BoneCheck(Owner, LocatorBoneName, *Cache))
+        {
+            return Cache->Mesh->GetBoneTransform(Cache->BoneIndex);
+        }
+
+        // The cache knows the mesh doesn't have the bone, so don't search for it again. This falls back to the actor,
+        // where the search below gives zero
+        if (Cache && Cache->Mesh.IsValid())
+        {
+            return Owner->GetActorTransform();
+        }
+
         // Ask for the bone
         auto AsCharacter = Cast<ACharacter>(Owner);
         if (AsCharacter)
@@ -183,8 +472,20 @@ void UExtendedCameraComponent::SmoothReturn_Implementation(AActor *Owner, FMinim
             return;
         }
 
-        StoredPreviousLocationForReturn =
-            FMath::VInterpTo(StoredPreviousLocationForReturn, DesiredView.Location, DeltaTime, SmoothReturnSpeed);
+        if (SmoothReturnTime > 0.f)
+        {
+            ExtendedCameraMath::SpringDampVector(StoredPreviousLocationForReturn, SmoothReturnVelocity,
+                                                 SmoothReturnTarget, DesiredView.Location, SmoothReturnTime,
+                                                 DeltaTime);
+            SmoothReturnTarget = DesiredView.Location;
+        }
+        else
+        {
+            StoredPreviousLocationForReturn =
+                ExtendedCameraMath::VInterpTo(StoredPreviousLocationForReturn, DesiredView.Location, DeltaTime,
+                                              SmoothReturnSpeed);
+        }
+
         DesiredView.Location = StoredPreviousLocationForReturn;
     }
 }
@@ -193,34 +494,23 @@ void UExtendedCameraComponent::LineOfCheckHandler_Implementation(AActor *Owner,
 {
     if (Owner)
     {
-        auto ownerLocation = Owner->GetActorLocation();
+        auto ownerLocation = HasEvaluationContext(Owner) ? EvaluationContext.OwnerLocation : Owner->GetActorLocation();
 
-        if (EExtendedCameraMode::KeepLos == CameraLOSMode)
+        if (WantsLineOfSight(ownerLocation, DesiredView))
         {
-            auto FOVAsRads = FMath::DegreesToRadians(DesiredView.FOV * 0.5f);
-            auto FOVCheckRads = FMath::Cos(FOVAsRads) - FOVCheckOffsetInRadians;
-
-            if (FVector::DotProduct(DesiredView.Rotation.Vector(),
-                                    (ownerLocation - DesiredView.Location).GetSafeNormal()) > FOVCheckRads)
+            if (EExtendedCameraMode::KeepLosNoDot == CameraLOSMode)
             {
-                KeepInFrameLineOfSight(Owner, DesiredView);
+                EXTCAM_CALL(KeepAnyLineOfSight, Owner, DesiredView);
             }
-        }
-
-        else if (EExtendedCameraMode::KeepLosWithinLimit == CameraLOSMode)
-        {
-            if (FVector::DotProduct(DesiredView.Rotation.Vector(),
-                                    (ownerLocation - DesiredView.Location).GetSafeNormal()) > FOVCheckOffsetInRadians)
+            else if (EExtendedCameraMode::KeepLosPartial == CameraLOSMode)
             {
-                KeepInFrameLineOfSight(Owner, DesiredView);
+                EXTCAM_CALL(KeepPartialLineOfSight, Owner, DesiredView);
+            }
+            else
+            {
+                EXTCAM_CALL(KeepInFrameLineOfSight, Owner, DesiredView);
             }
         }
-
-        else if (EExtendedCameraMode::KeepLosNoDot == CameraLOSMode)
-        {
-            KeepAnyLineOfSight(Owner, DesiredView);
-        }
-
         else
         {
             // Owner went out of frame
@@ -233,703 +523,2391 @@ void UExtendedCameraComponent::LineOfCheckHandler_Implementation(AActor *Owner,
     }
 }
 
-void UExtendedCameraComponent::TrackingHandler_Implementation(AActor *Owner, FMinimalViewInfo &DesiredView,
-                                                              float DeltaTime)
+bool UExtendedCameraComponent::WantsLineOfSight(const FVector &OwnerLocation,
+                                                const FMinimalViewInfo &DesiredView) const
 {
-    if (FirstTrackCameraDriverMode == EExtendedCameraDriverMode::Compat)
-    {
-        // Old Version. Sets the same stuff to maintain backwards compatibility
-        // Write Tracked Values if we're using it
-        if (!IgnorePrimaryTrackedCamera && IsValid(PrimaryTrackedCamera))
-        {
-            const auto CameraComp = PrimaryTrackedCamera->GetCameraComponent();
-            if (CameraComp)
-            {
-                PrimaryTrackTransform = PrimaryTrackedCamera->GetTransform();
-                PrimaryTrackFOV = CameraComp->FieldOfView;
-            }
-        }
-    }
-    else if (FirstTrackCameraDriverMode == EExtendedCameraDriverMode::DataDriven)
+    if (EExtendedCameraMode::KeepLos == CameraLOSMode)
     {
-        // Do Nothing? Data is being directly driven
+        auto FOVAsRads = FMath::DegreesToRadians(DesiredView.FOV * 0.5f);
+        auto FOVCheckRads = FMath::Cos(FOVAsRads) - FOVCheckOffsetInRadians;
+
+        return FVector::DotProduct(DesiredView.Rotation.Vector(),
+                                   (OwnerLocation - DesiredView.Location).GetSafeNormal()) > FOVCheckRads;
     }
-    else if (FirstTrackCameraDriverMode == EExtendedCameraDriverMode::ReferenceCameraDriven)
+
+    else if (EExtendedCameraMode::KeepLosWithinLimit == CameraLOSMode)
     {
-        // New way to specify that we wish to track a camera directly
-        if (IsValid(PrimaryTrackedCamera))
-        {
-            const auto CameraComp = PrimaryTrackedCamera->GetCameraComponent();
-            if (CameraComp)
-            {
-                PrimaryTrackTransform = PrimaryTrackedCamera->GetTransform();
-                PrimaryTrackFOV = CameraComp->FieldOfView;
-            }
-        }
+        return FVector::DotProduct(DesiredView.Rotation.Vector(),
+                                   (OwnerLocation - DesiredView.Location).GetSafeNormal()) > FOVCheckOffsetInRadians;
     }
-    else if (FirstTrackCameraDriverMode == EExtendedCameraDriverMode::LocAndAim ||
-             FirstTrackCameraDriverMode == EExtendedCameraDriverMode::Skeleton ||
-             FirstTrackCameraDriverMode == EExtendedCameraDriverMode::SkeletonAim ||
-             FirstTrackCameraDriverMode == EExtendedCameraDriverMode::SkeletonLocator)
-    {
-        // Uses Locs and Aims
-        // Aim is not valid without locator. We need the data from it
-        if (IsValid(PrimaryTrackLocator))
-        {
-            auto Locator =
-                GetActorTrackLocation(PrimaryTrackLocator, FirstTrackCameraDriverMode, PrimaryLocatorBoneName);
-            // auto Locator = PrimaryTrackLocator->GetActorLocation();
-            SetCameraPrimaryLocation(Locator);
 
-            // Uses Locs and Aims
-            if (IsValid(PrimaryTrackAim))
-            {
-                const auto BaseAimLocation =
-                    GetActorAimLocation(PrimaryTrackAim, FirstTrackCameraDriverMode, PrimaryAimBoneName)
-                        .TransformPosition(PrimaryTrackAimOffset);
+    return EExtendedCameraMode::KeepLosNoDot == CameraLOSMode || EExtendedCameraMode::KeepLosPartial == CameraLOSMode;
+}
 
-                const auto LookAt = BaseAimLocation - Locator;
+bool UExtendedCameraComponent::HasBatchedLineOfSight(const FVector &Aim, const FVector &Location) const
+{
+    // Anything between the subsystem and here may have moved the segment
+    return UseBatchedLineOfSight && BatchedLOSFrameNumber == GFrameCounter &&
+           BatchedLOSHit.TraceStart.Equals(Aim, KINDA_SMALL_NUMBER) &&
+           BatchedLOSHit.TraceEnd.Equals(Location, KINDA_SMALL_NUMBER);
+}
 
-                FRotator FinalRotation = FMath::RInterpTo(PrimaryTrackPastFrameLookAt, LookAt.Rotation(), DeltaTime,
-                                                          PrimaryTrackAimInterpolationSpeed);
-                PrimaryTrackPastFrameLookAt = FinalRotation;
-                SetCameraPrimaryRotation(FinalRotation);
+void UExtendedCameraComponent::TrackingHandler_Implementation(AActor *Owner, FMinimalViewInfo &DesiredView,
+                                                              float DeltaTime)
+{
+    // Locators and aims were resolved at the top of GetCameraView
+    const bool UseContext = HasEvaluationContext(Owner);
 
-#if ENABLE_DRAW_DEBUG
-                if (PrimaryTrackAimDebug)
-                {
-                    DrawDebugSolidBox(GetWorld(), BaseAimLocation, FVector(12.f), FColor(200, 200, 32, 128));
-                    DrawDebugBox(GetWorld(), BaseAimLocation, FVector(12.f), FColor::Black);
-                }
-#endif // ENABLE_DRAW_DEBUG
-            }
-        }
+    for (int32 Index = 0; Index < CameraTracks.Num(); ++Index)
+    {
+        TrackCamera(CameraTracks[Index], UseContext ? &EvaluationContext.Tracks[Index] : nullptr, DeltaTime,
+                    TrackDebugColours[Index % UE_ARRAY_COUNT(TrackDebugColours)]);
     }
+}
 
-    // Second
-    if (SecondTrackCameraDriverMode == EExtendedCameraDriverMode::Compat)
+void UExtendedCameraComponent::TrackCamera(FExtendedCameraTrack &Track, const FExtendedCameraTrackContext *Context,
+                                           float DeltaTime, const FColor &DebugColour)
+{
+    // DriverMode is writable from Blueprint and the editor, not just our setters
+    if (Track.EvaluatorMode != Track.DriverMode)
     {
-        // Write Tracked Values if we're using it
-        if (!IgnoreSecondTrackedCamera && IsValid(SecondaryTrackedCamera))
+        SelectTrackEvaluator(Track);
+    }
+
+    Track.Evaluator(*this, Track, Context, DeltaTime, DebugColour);
+}
+
+template <EExtendedCameraDriverMode Mode>
+void UExtendedCameraComponent::TrackCameraAs(UExtendedCameraComponent &Camera, FExtendedCameraTrack &Track,
+                                             const FExtendedCameraTrackContext *Context, float DeltaTime,
+                                             const FColor &DebugColour)
+{
+    if constexpr (Mode == EExtendedCameraDriverMode::Compat ||
+                  Mode == EExtendedCameraDriverMode::ReferenceCameraDriven)
+    {
+        // Compat is the old version, which could be told to keep its own transform
+        if constexpr (Mode == EExtendedCameraDriverMode::Compat)
         {
-            const auto CameraComp = SecondaryTrackedCamera->GetCameraComponent();
-            if (CameraComp)
+            if (Track.IgnoreTrackedCamera)
             {
-                SecondaryTrackTransform = SecondaryTrackedCamera->GetTransform();
-                SecondaryTrackFOV = CameraComp->FieldOfView;
+                return;
             }
         }
-    }
-    else if (SecondTrackCameraDriverMode == EExtendedCameraDriverMode::DataDriven)
-    {
-        // Do Nothing? Data is being directly driven
-    }
-    else if (SecondTrackCameraDriverMode == EExtendedCameraDriverMode::ReferenceCameraDriven)
-    {
+
         // Write Tracked Values if we're using it
-        if (IsValid(SecondaryTrackedCamera))
+        if (IsValid(Track.TrackedCamera))
         {
-            const auto CameraComp = SecondaryTrackedCamera->GetCameraComponent();
+            const auto CameraComp = Track.TrackedCamera->GetCameraComponent();
             if (CameraComp)
             {
-                SecondaryTrackTransform = SecondaryTrackedCamera->GetTransform();
-                SecondaryTrackFOV = CameraComp->FieldOfView;
+                Track.Transform = Track.TrackedCamera->GetTransform();
+                Track.FOV = CameraComp->FieldOfView;
             }
         }
     }
-    else if (FirstTrackCameraDriverMode == EExtendedCameraDriverMode::LocAndAim ||
-             FirstTrackCameraDriverMode == EExtendedCameraDriverMode::Skeleton ||
-             FirstTrackCameraDriverMode == EExtendedCameraDriverMode::SkeletonAim ||
-             FirstTrackCameraDriverMode == EExtendedCameraDriverMode::SkeletonLocator)
+    else if constexpr (UsesLocatorAndAim(Mode))
     {
         // Uses Locs and Aims
         // Aim is not valid without locator. We need the data from it
-        if (IsValid(SecondaryTrackLocator))
+        // A replayed context has no actors, only whether the recording had them
+        if (Context ? Context->HasLocator : IsValid(Track.Locator))
         {
-            auto Locator =
-                GetActorTrackLocation(SecondaryTrackLocator, SecondTrackCameraDriverMode, SecondaryLocatorBoneName);
-            // auto Locator = PrimaryTrackLocator->GetActorLocation();
-            SetCameraSecondaryLocation(Locator);
+            auto Locator = Context ? Context->Locator
+                                   : EXTCAM_CALL_ON(Camera, GetActorTrackLocation, Track.Locator, Mode,
+                                                    Track.LocatorBoneName);
+            Track.Transform.SetLocation(Locator);
 
             // Uses Locs and Aims
-            if (IsValid(SecondaryTrackAim))
+            if (Context ? Context->HasAim : IsValid(Track.Aim))
             {
                 const auto BaseAimLocation =
-                    GetActorAimLocation(SecondaryTrackAim, SecondTrackCameraDriverMode, SecondaryAimBoneName)
-                        .TransformPosition(SecondaryTrackAimOffset);
+                    Context ? Context->AimPoint
+                            : EXTCAM_CALL_ON(Camera, GetActorAimLocation, Track.Aim, Mode, Track.AimBoneName)
+                                  .TransformPosition(Track.AimOffset);
+
                 const auto LookAt = BaseAimLocation - Locator;
-                FRotator FinalRotation = FMath::RInterpTo(SecondaryTrackPastFrameLookAt, LookAt.Rotation(), DeltaTime,
-                                                          SecondaryTrackAimInterpolationSpeed);
-                SecondaryTrackPastFrameLookAt = FinalRotation;
-                SetCameraSecondaryRotation(FinalRotation);
+
+                const auto AimTarget = LookAt.Rotation();
+
+                FRotator FinalRotation = Track.PastFrameLookAt;
+                if (!Camera.GetActiveSignificance().SmoothAim)
+                {
+                    // Nobody's close enough to see the aim settle
+                    FinalRotation = AimTarget;
+                    Track.AimVelocity = FRotator::ZeroRotator;
+                }
+                else if (Track.AimSmoothTime > 0.f)
+                {
+                    ExtendedCameraMath::SpringDampRotator(FinalRotation, Track.AimVelocity, Track.PastFrameAimTarget,
+                                                          AimTarget, Track.AimSmoothTime, DeltaTime);
+                }
+                else
+                {
+                    FinalRotation = ExtendedCameraMath::RInterpTo(FinalRotation, AimTarget, DeltaTime,
+                                                                  Track.AimInterpolationSpeed);
+                }
+
+                Track.PastFrameLookAt = FinalRotation;
+                Track.PastFrameAimTarget = AimTarget;
+                Track.Transform.SetRotation(FinalRotation.Quaternion());
 
 #if ENABLE_DRAW_DEBUG
-                if (SecondaryTrackAimDebug)
+                if (Track.AimDebug)
                 {
-                    DrawDebugSolidBox(GetWorld(), BaseAimLocation, FVector(12.f), FColor(250, 150, 32, 128));
-                    DrawDebugBox(GetWorld(), BaseAimLocation, FVector(12.f), FColor::Black);
+                    DrawDebugSolidBox(Camera.GetWorld(), BaseAimLocation, FVector(12.f), DebugColour);
+                    DrawDebugBox(Camera.GetWorld(), BaseAimLocation, FVector(12.f), FColor::Black);
                 }
 #endif // ENABLE_DRAW_DEBUG
             }
         }
     }
+    else
+    {
+        // Direct Data Driven. The transform is written by users
+        static_assert(Mode == EExtendedCameraDriverMode::DataDriven, "Every driver mode needs an evaluator");
+    }
 }
 
-UExtendedCameraComponent::UExtendedCameraComponent()
-    : SmoothReturnOnLineOfSight(false)
-    , SmoothReturnSpeed(1)
-    , WasLineOfSightBlockedRecently(false)
-    , FirstTrackCameraDriverMode(EExtendedCameraDriverMode::Compat)
-    , SecondTrackCameraDriverMode(EExtendedCameraDriverMode::Compat)
-    , ReturnFinishedThresholdSquared(27.f)
+void UExtendedCameraComponent::SelectTrackEvaluator(FExtendedCameraTrack &Track)
 {
-}
+    // In EExtendedCameraDriverMode order
+    static constexpr FExtendedCameraTrackEvaluator Evaluators[] = {
+        &TrackCameraAs<EExtendedCameraDriverMode::ReferenceCameraDriven>,
+        &TrackCameraAs<EExtendedCameraDriverMode::Compat>,
+        &TrackCameraAs<EExtendedCameraDriverMode::DataDriven>,
+        &TrackCameraAs<EExtendedCameraDriverMode::LocAndAim>,
+        &TrackCameraAs<EExtendedCameraDriverMode::Skeleton>,
+        &TrackCameraAs<EExtendedCameraDriverMode::SkeletonLocator>,
+        &TrackCameraAs<EExtendedCameraDriverMode::SkeletonAim>,
+    };
+    static_assert(UE_ARRAY_COUNT(Evaluators) == int32(EExtendedCameraDriverMode::TOTAL_CAMERA_DRIVER_MODES),
+                  "Evaluators must cover every EExtendedCameraDriverMode");
 
-// Set Primary
-void UExtendedCameraComponent::SetPrimaryCameraTrackAlpha(float Alpha)
-{
-    CameraPrimaryTrackBlendAlpha = Alpha;
-}
+    Track.EvaluatorMode = Track.DriverMode;
 
-float UExtendedCameraComponent::GetPrimaryCameraTrackAlpha()
-{
-    return CameraPrimaryTrackBlendAlpha;
+    // Out of range modes do nothing, like Direct Data Driven
+    Track.Evaluator = Track.DriverMode < EExtendedCameraDriverMode::TOTAL_CAMERA_DRIVER_MODES
+                          ? Evaluators[Track.DriverMode]
+                          : &TrackCameraAs<EExtendedCameraDriverMode::DataDriven>;
 }
 
-// Set Secondary
-void UExtendedCameraComponent::SetSecondaryCameraTrackAlpha(float Alpha)
+void UExtendedCameraComponent::UpdateTracking(float DeltaTime)
 {
-    CameraSecondaryTrackBlendAlpha = Alpha;
-}
+    const auto ComponentOwner = GetOwner();
 
-float UExtendedCameraComponent::GetSecondaryCameraTrackAlpha()
-{
-    return CameraSecondaryTrackBlendAlpha;
-}
+    FMinimalViewInfo View;
+    GetBaseView(View);
 
-void UExtendedCameraComponent::SetCameraPrimaryTrack(FVector &InLocation, FRotator &InRotation, float InFOV)
-{
-    PrimaryTrackTransform.SetLocation(InLocation);
-    PrimaryTrackTransform.SetRotation(InRotation.Quaternion());
-    PrimaryTrackFOV = InFOV;
+    BuildEvaluationContext(ComponentOwner);
+
+    EXTCAM_STAGE_SCOPE(Tracking);
+    EXTCAM_CALL(TrackingHandler, ComponentOwner, View, GetSignificanceDeltaTime(DeltaTime));
+
+    TrackedFrameNumber = GFrameCounter;
 }
 
-void UExtendedCameraComponent::SetCameraSecondaryTrack(FVector &InLocation, FRotator &InRotation, float InFOV)
+bool UExtendedCameraComponent::CanTrackInParallel() const
 {
-    SecondaryTrackTransform.SetLocation(InLocation);
-    SecondaryTrackTransform.SetRotation(InRotation.Quaternion());
-    SecondaryTrackFOV = InFOV;
+    // Debug drawing isn't safe from workers
+    // Script overrides must be called through ProcessEvent on the game thread
+    return UseParallelTracking && !AnyTrackAimDebug() &&
+           !IsOverriddenInScript(EExtendedCameraScriptEvent::TrackingHandler) &&
+           !IsOverriddenInScript(EExtendedCameraScriptEvent::GetActorTrackLocation) &&
+           !IsOverriddenInScript(EExtendedCameraScriptEvent::GetActorAimLocation);
 }
 
-void UExtendedCameraComponent::SetCameraPrimaryTransform(FTransform &InTransform, float InFOV)
+void UExtendedCameraComponent::CacheScriptOverrides()
 {
-    PrimaryTrackTransform = InTransform;
-    PrimaryTrackFOV = InFOV;
+    // In EExtendedCameraScriptEvent order
+    static const FName EventNames[] = {
+        GET_FUNCTION_NAME_CHECKED(UExtendedCameraComponent, GetAimLocation),
+        GET_FUNCTION_NAME_CHECKED(UExtendedCameraComponent, GetActorTrackLocation),
+        GET_FUNCTION_NAME_CHECKED(UExtendedCameraComponent, GetActorAimLocation),
+        GET_FUNCTION_NAME_CHECKED(UExtendedCameraComponent, SmoothReturn),
+        GET_FUNCTION_NAME_CHECKED(UExtendedCameraComponent, LineOfCheckHandler),
+        GET_FUNCTION_NAME_CHECKED(UExtendedCameraComponent, TrackingHandler),
+        GET_FUNCTION_NAME_CHECKED(UExtendedCameraComponent, KeepInFrameLineOfSight),
+        GET_FUNCTION_NAME_CHECKED(UExtendedCameraComponent, KeepAnyLineOfSight),
+        GET_FUNCTION_NAME_CHECKED(UExtendedCameraComponent, KeepPartialLineOfSight),
+        GET_FUNCTION_NAME_CHECKED(UExtendedCameraComponent, CommonKeepLineOfSight),
+    };
+    static_assert(UE_ARRAY_COUNT(EventNames) == int32(EExtendedCameraScriptEvent::TOTAL_SCRIPT_EVENTS),
+                  "EventNames must name every EExtendedCameraScriptEvent");
+    static_assert(int32(EExtendedCameraScriptEvent::TOTAL_SCRIPT_EVENTS) <= sizeof(ScriptOverrides) * 8,
+                  "ScriptOverrides needs a bit per event");
+
+    const auto Class = GetClass();
+
+    ScriptOverrides = 0;
+    for (int32 Event = 0; Event < int32(EExtendedCameraScriptEvent::TOTAL_SCRIPT_EVENTS); ++Event)
+    {
+        if (Class->IsFunctionImplementedInScript(EventNames[Event]))
+        {
+            ScriptOverrides |= uint16(1 << Event);
+        }
+    }
+
+    ScriptOverridesClass = Class;
 }
 
-void UExtendedCameraComponent::SetCameraSecondaryTransform(FTransform &InTransform, float InFOV)
+bool UExtendedCameraComponent::CallsScript(EExtendedCameraScriptEvent Event)
 {
-    SecondaryTrackTransform = InTransform;
-    SecondaryTrackFOV = InFOV;
+    // Off the game thread we've already checked nothing we call is overridden in script
+    if (!IsInGameThread())
+    {
+        return false;
+    }
+
+    // Also covers being called before BeginPlay, in the editor
+    if (ScriptOverridesClass != GetClass())
+    {
+        CacheScriptOverrides();
+    }
+
+    return (ScriptOverrides & (1 << int32(Event))) != 0;
 }
 
-void UExtendedCameraComponent::SetCameraPrimaryLocationRotation(FVector &InLocation, FRotator &InRotation)
+bool UExtendedCameraComponent::IsOverriddenInScript(EExtendedCameraScriptEvent Event) const
 {
-    PrimaryTrackTransform.SetLocation(InLocation);
-    PrimaryTrackTransform.SetRotation(InRotation.Quaternion());
+    return ScriptOverridesClass != GetClass() || (ScriptOverrides & (1 << int32(Event))) != 0;
 }
 
-void UExtendedCameraComponent::SetCameraSecondaryLocationRotation(FVector &InLocation, FRotator &InRotation)
+bool UExtendedCameraComponent::HasTrackedThisFrame() const
 {
-    SecondaryTrackTransform.SetLocation(InLocation);
-    SecondaryTrackTransform.SetRotation(InRotation.Quaternion());
+    return TrackedFrameNumber == GFrameCounter;
 }
 
-void UExtendedCameraComponent::SetCameraPrimaryRotation(FRotator &InRotation)
+bool UExtendedCameraComponent::AnyTrackAimDebug() const
 {
-    PrimaryTrackTransform.SetRotation(InRotation.Quaternion());
+    for (const auto &Track : CameraTracks)
+    {
+        if (Track.AimDebug)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// The properties the Primary and Secondary tracks had before CameraTracks, and the track field each stands in for
+#define EXTCAM_NAMED_TRACK_PROPERTIES(Op)                                                                              \
+    Op(PrimaryTrackTransform, PrimaryTrackIndex, Transform)                                                            \
+    Op(SecondaryTrackTransform, SecondaryTrackIndex, Transform)                                                        \
+    Op(PrimaryTrackFOV, PrimaryTrackIndex, FOV)                                                                        \
+    Op(SecondaryTrackFOV, SecondaryTrackIndex, FOV)                                                                    \
+    Op(CameraPrimaryTrackBlendAlpha, PrimaryTrackIndex, BlendAlpha)                                                    \
+    Op(CameraSecondaryTrackBlendAlpha, SecondaryTrackIndex, BlendAlpha)                                                \
+    Op(FirstTrackCameraDriverMode, PrimaryTrackIndex, DriverMode)                                                      \
+    Op(SecondTrackCameraDriverMode, SecondaryTrackIndex, DriverMode)                                                   \
+    Op(PrimaryTrackedCamera, PrimaryTrackIndex, TrackedCamera)                                                         \
+    Op(SecondaryTrackedCamera, SecondaryTrackIndex, TrackedCamera)                                                     \
+    Op(IgnorePrimaryTrackedCamera, PrimaryTrackIndex, IgnoreTrackedCamera)                                             \
+    Op(IgnoreSecondTrackedCamera, SecondaryTrackIndex, IgnoreTrackedCamera)                                            \
+    Op(PrimaryTrackLocator, PrimaryTrackIndex, Locator)                                                                \
+    Op(SecondaryTrackLocator, SecondaryTrackIndex, Locator)                                                            \
+    Op(PrimaryTrackAim, PrimaryTrackIndex, Aim)                                                                        \
+    Op(SecondaryTrackAim, SecondaryTrackIndex, Aim)                                                                    \
+    Op(PrimaryTrackAimOffset, PrimaryTrackIndex, AimOffset)                                                            \
+    Op(SecondaryTrackAimOffset, SecondaryTrackIndex, AimOffset)                                                        \
+    Op(PrimaryTrackAimInterpolationSpeed, PrimaryTrackIndex, AimInterpolationSpeed)                                    \
+    Op(SecondaryTrackAimInterpolationSpeed, SecondaryTrackIndex, AimInterpolationSpeed)                                \
+    Op(PrimaryTrackAimDebug, PrimaryTrackIndex, AimDebug)                                                              \
+    Op(SecondaryTrackAimDebug, SecondaryTrackIndex, AimDebug)                                                          \
+    Op(PrimaryLocatorBoneName, PrimaryTrackIndex, LocatorBoneName)                                                     \
+    Op(SecondaryLocatorBoneName, SecondaryTrackIndex, LocatorBoneName)                                                 \
+    Op(PrimaryAimBoneName, PrimaryTrackIndex, AimBoneName)                                                             \
+    Op(SecondaryAimBoneName, SecondaryTrackIndex, AimBoneName)                                                         \
+    Op(FirstTrackDollyZoomReferenceDistance, PrimaryTrackIndex, DollyZoomReferenceDistance)                            \
+    Op(SecondTrackDollyZoomReferenceDistance, SecondaryTrackIndex, DollyZoomReferenceDistance)                         \
+    Op(FirstTrackDollyZoomEnabled, PrimaryTrackIndex, DollyZoomEnabled)                                                \
+    Op(SecondTrackDollyZoomEnabled, SecondaryTrackIndex, DollyZoomEnabled)                                             \
+    Op(FirstTrackDollyZoomDistanceLiveUpdate, PrimaryTrackIndex, DollyZoomDistanceLiveUpdate)                          \
+    Op(SecondTrackDollyZoomDistanceLiveUpdate, SecondaryTrackIndex, DollyZoomDistanceLiveUpdate)
+
+template <typename T>
+static bool IsSameTrackValue(const T &A, const T &B)
+{
+    return A == B;
+}
+
+static bool IsSameTrackValue(const FTransform &A, const FTransform &B)
+{
+    return A.Equals(B, 0.0);
+}
+
+// A property written since the last sync overrides its track field. Either way both end up holding the field.
+// True if the property was written
+template <typename T>
+static bool SyncNamedTrackProperty(T &Property, T &Synced, T &Field)
+{
+    const bool Written = !IsSameTrackValue(Property, Synced);
+    if (Written)
+    {
+        Field = Property;
+    }
+
+    Property = Field;
+    Synced = Field;
+    return Written;
+}
+
+void UExtendedCameraComponent::EnsureNamedTracks()
+{
+    if (CameraTracks.Num() <= SecondaryTrackIndex)
+    {
+        CameraTracks.SetNum(SecondaryTrackIndex + 1);
+    }
+}
+
+FExtendedCameraTrack &UExtendedCameraComponent::GetNamedTrack(int32 TrackIndex)
+{
+    EnsureNamedTracks();
+    return CameraTracks[TrackIndex];
+}
+
+UExtendedCameraComponent::UExtendedCameraComponent()
+    : RotationBlend(EExtendedCameraRotationBlend::EulerBlend)
+    , SmoothReturnOnLineOfSight(false)
+    , SmoothReturnSpeed(1)
+    , SmoothReturnTime(0.f)
+    , SmoothReturnVelocity(FVector::ZeroVector)
+    , SmoothReturnTarget(FVector::ZeroVector)
+    , WasLineOfSightBlockedRecently(false)
+    , ReturnFinishedThresholdSquared(27.f)
+    , UseAsyncLineOfSight(false)
+    , AsyncLineOfSightExtrapolation(1.f)
+    , HasAsyncLOSHistory(false)
+    , UseBatchedEvaluation(false)
+    , BatchedFOV(0.f)
+    , VisibilityThreshold(0.5f)
+    , VisibilityRayBudget(2)
+    , VisibilityScore(1.f)
+    , NextVisibilityProbe(0)
+    , VisibilityRaysFrameNumber(MAX_uint64)
+    , UseSweptLineOfSight(false)
+    , LineOfSightProbeRadius(12.f)
+    , LineOfSightPushback(0.f)
+    , UseBatchedLineOfSight(false)
+    , BatchedLOSFrameNumber(MAX_uint64)
+    , UseLineOfSightCache(false)
+    , LineOfSightCachePositionTolerance(0.5f)
+    , LineOfSightCacheRotationTolerance(0.5f)
+    , LineOfSightCacheMaxAge(30)
+    , UseParallelTracking(false)
+    , TrackedFrameNumber(MAX_uint64)
+    , BatchedFrameNumber(MAX_uint64)
+    , UseIncrementalEvaluation(false)
+    , IncrementalMaxIdleFrames(30)
+    , UseFixedTimestep(false)
+    , FixedTimestepRate(60.f)
+    , FixedTimestepMaxSteps(4)
+    , FixedTimestepAccumulator(0.f)
+    , HasSimView(false)
+    , RepeatingFixedStep(false)
+    , FixedStepLOSHit(false)
+    , ReplayedFrame(nullptr)
+    , BakedShot(nullptr)
+    , BakedShotTime(0.f)
+    , BakedShotBindingsKey(0)
+    , BakedShotBindingsMatch(false)
+    , UseSignificance(false)
+    , SignificanceTier(EExtendedCameraSignificance::SignificanceFull)
+    , SignificanceIsViewTarget(false)
+    , SignificanceCapturePixels(0)
+    , SignificanceRegistered(false)
+    , SignificancePhase(0)
+    , HasLastLOSHit(false)
+    , LineOfSightScheduledFrame(MAX_uint64)
+    , BoneResolutionScheduledFrame(MAX_uint64)
+    , LineOfSightDeferredFrames(0)
+    , BoneResolutionDeferredFrames(0)
+    , LineOfSightCycles(0)
+    , BoneResolutionCycles(0)
+    , BakingShot(false)
+    , CameraSubsystem(nullptr)
+    , ScriptOverrides(0)
+    , ScriptOverridesClass(nullptr)
+{
+    // Primary and Secondary
+    CameraTracks.SetNum(SecondaryTrackIndex + 1);
+}
+
+// Set Primary
+void UExtendedCameraComponent::SetPrimaryCameraTrackAlpha(float Alpha)
+{
+    GetNamedTrack(PrimaryTrackIndex).BlendAlpha = Alpha;
+}
+
+float UExtendedCameraComponent::GetPrimaryCameraTrackAlpha()
+{
+    return GetNamedTrack(PrimaryTrackIndex).BlendAlpha;
+}
+
+// Set Secondary
+void UExtendedCameraComponent::SetSecondaryCameraTrackAlpha(float Alpha)
+{
+    GetNamedTrack(SecondaryTrackIndex).BlendAlpha = Alpha;
+}
+
+float UExtendedCameraComponent::GetSecondaryCameraTrackAlpha()
+{
+    return GetNamedTrack(SecondaryTrackIndex).BlendAlpha;
+}
+
+void UExtendedCameraComponent::SetCameraPrimaryTrack(FVector &InLocation, FRotator &InRotation, float InFOV)
+{
+    auto &Track = GetNamedTrack(PrimaryTrackIndex);
+    Track.Transform.SetLocation(InLocation);
+    Track.Transform.SetRotation(InRotation.Quaternion());
+    Track.FOV = InFOV;
+}
+
+void UExtendedCameraComponent::SetCameraSecondaryTrack(FVector &InLocation, FRotator &InRotation, float InFOV)
+{
+    auto &Track = GetNamedTrack(SecondaryTrackIndex);
+    Track.Transform.SetLocation(InLocation);
+    Track.Transform.SetRotation(InRotation.Quaternion());
+    Track.FOV = InFOV;
+}
+
+void UExtendedCameraComponent::SetCameraPrimaryTransform(FTransform &InTransform, float InFOV)
+{
+    SetCameraTrackTransform(PrimaryTrackIndex, InTransform, InFOV);
+}
+
+void UExtendedCameraComponent::SetCameraSecondaryTransform(FTransform &InTransform, float InFOV)
+{
+    SetCameraTrackTransform(SecondaryTrackIndex, InTransform, InFOV);
+}
+
+void UExtendedCameraComponent::SetCameraPrimaryLocationRotation(FVector &InLocation, FRotator &InRotation)
+{
+    auto &Track = GetNamedTrack(PrimaryTrackIndex);
+    Track.Transform.SetLocation(InLocation);
+    Track.Transform.SetRotation(InRotation.Quaternion());
+}
+
+void UExtendedCameraComponent::SetCameraSecondaryLocationRotation(FVector &InLocation, FRotator &InRotation)
+{
+    auto &Track = GetNamedTrack(SecondaryTrackIndex);
+    Track.Transform.SetLocation(InLocation);
+    Track.Transform.SetRotation(InRotation.Quaternion());
+}
+
+void UExtendedCameraComponent::SetCameraPrimaryRotation(FRotator &InRotation)
+{
+    GetNamedTrack(PrimaryTrackIndex).Transform.SetRotation(InRotation.Quaternion());
+}
+
+void UExtendedCameraComponent::SetCameraSecondaryRotation(FRotator &InRotation)
+{
+    GetNamedTrack(SecondaryTrackIndex).Transform.SetRotation(InRotation.Quaternion());
+}
+
+void UExtendedCameraComponent::SetCameraPrimaryLocation(FVector &InLocation)
+{
+    GetNamedTrack(PrimaryTrackIndex).Transform.SetLocation(InLocation);
+}
+
+void UExtendedCameraComponent::SetCameraSecondaryLocation(FVector &InLocation)
+{
+    GetNamedTrack(SecondaryTrackIndex).Transform.SetLocation(InLocation);
+}
+
+void UExtendedCameraComponent::SetCameraPrimaryFOV(float InFOV)
+{
+    GetNamedTrack(PrimaryTrackIndex).FOV = InFOV;
+}
+
+void UExtendedCameraComponent::SetCameraSecondaryFOV(float InFOV)
+{
+    GetNamedTrack(SecondaryTrackIndex).FOV = InFOV;
+}
+
+bool UExtendedCameraComponent::GetUsePrimaryTrack()
+{
+    return FMath::IsNearlyEqual(GetNamedTrack(PrimaryTrackIndex).BlendAlpha, 1.f);
+}
+
+bool UExtendedCameraComponent::GetUseSecondaryTrack()
+{
+    return FMath::IsNearlyEqual(GetNamedTrack(SecondaryTrackIndex).BlendAlpha, 1.f);
+}
+
+void UExtendedCameraComponent::SetCameraMode(EExtendedCameraMode NewMode)
+{
+    CameraLOSMode = NewMode;
+}
+
+TEnumAsByte<EExtendedCameraMode> UExtendedCameraComponent::GetCameraMode()
+{
+    return CameraLOSMode;
+}
+
+void UExtendedCameraComponent::SetPrimaryTrackDollyZoomReferenceDistance(float Distance)
+{
+    GetNamedTrack(PrimaryTrackIndex).DollyZoomReferenceDistance = Distance;
+}
+
+void UExtendedCameraComponent::SetSecondaryTrackDollyZoomReferenceDistance(float Distance)
+{
+    GetNamedTrack(SecondaryTrackIndex).DollyZoomReferenceDistance = Distance;
+}
+
+void UExtendedCameraComponent::SetPrimaryTrackDollyZoomEnabled(bool Enabled)
+{
+    GetNamedTrack(PrimaryTrackIndex).DollyZoomEnabled = Enabled;
+}
+
+void UExtendedCameraComponent::SetSecondaryTrackDollyZoomEnabled(bool Enabled)
+{
+    GetNamedTrack(SecondaryTrackIndex).DollyZoomEnabled = Enabled;
+}
+
+void UExtendedCameraComponent::SetPrimaryTrackDollyZoomLiveUpdate(bool Enabled)
+{
+    GetNamedTrack(PrimaryTrackIndex).DollyZoomDistanceLiveUpdate = Enabled;
+}
+
+void UExtendedCameraComponent::SetSecondaryTrackDollyZoomLiveUpdate(bool Enabled)
+{
+    GetNamedTrack(SecondaryTrackIndex).DollyZoomDistanceLiveUpdate = Enabled;
+}
+
+void UExtendedCameraComponent::SetPrimaryTrackedCamera(ACameraActor *TrackedCamera)
+{
+    GetNamedTrack(PrimaryTrackIndex).TrackedCamera = TrackedCamera;
+}
+
+void UExtendedCameraComponent::SetSecondaryTrackedCamera(ACameraActor *TrackedCamera)
+{
+    GetNamedTrack(SecondaryTrackIndex).TrackedCamera = TrackedCamera;
+}
+
+void UExtendedCameraComponent::SetPrimaryTrackLocator(AActor *TrackedActor)
+{
+    GetNamedTrack(PrimaryTrackIndex).Locator = TrackedActor;
+}
+
+void UExtendedCameraComponent::SetSecondaryTrackLocator(AActor *TrackedActor)
+{
+    GetNamedTrack(SecondaryTrackIndex).Locator = TrackedActor;
+}
+
+void UExtendedCameraComponent::SetPrimaryTrackAim(AActor *TrackedActor)
+{
+    GetNamedTrack(PrimaryTrackIndex).Aim = TrackedActor;
+}
+
+void UExtendedCameraComponent::SetSecondaryTrackAim(AActor *TrackedActor)
+{
+    GetNamedTrack(SecondaryTrackIndex).Aim = TrackedActor;
+}
+
+void UExtendedCameraComponent::SetPrimaryTrackAimInterpolationSpeed(float Speed)
+{
+    GetNamedTrack(PrimaryTrackIndex).AimInterpolationSpeed = Speed;
+}
+
+void UExtendedCameraComponent::SetSecondaryTrackAimInterpolationSpeed(float Speed)
+{
+    GetNamedTrack(SecondaryTrackIndex).AimInterpolationSpeed = Speed;
+}
+
+void UExtendedCameraComponent::SetSecondaryTrackAimOffset(FVector &AimOffset)
+{
+    GetNamedTrack(SecondaryTrackIndex).AimOffset = AimOffset;
+}
+
+void UExtendedCameraComponent::SetPrimaryTrackAimOffset(FVector &AimOffset)
+{
+    GetNamedTrack(PrimaryTrackIndex).AimOffset = AimOffset;
+}
+
+int32 UExtendedCameraComponent::GetCameraTrackCount()
+{
+    return CameraTracks.Num();
+}
+
+void UExtendedCameraComponent::SetCameraTrackCount(int32 Count)
+{
+    CameraTracks.SetNum(FMath::Max(Count, SecondaryTrackIndex + 1));
+}
+
+void UExtendedCameraComponent::SetCameraTrackAlpha(int32 TrackIndex, float Alpha)
+{
+    if (CameraTracks.IsValidIndex(TrackIndex))
+    {
+        CameraTracks[TrackIndex].BlendAlpha = Alpha;
+    }
+    else
+    {
+        UE_LOG(LogExtendedCamera, Warning, TEXT("Invalid Track Index (%d)"), TrackIndex);
+    }
+}
+
+float UExtendedCameraComponent::GetCameraTrackAlpha(int32 TrackIndex)
+{
+    return CameraTracks.IsValidIndex(TrackIndex) ? CameraTracks[TrackIndex].BlendAlpha : 0.f;
+}
+
+void UExtendedCameraComponent::SetCameraTrackTransform(int32 TrackIndex, FTransform &InTransform, float InFOV)
+{
+    if (CameraTracks.IsValidIndex(TrackIndex))
+    {
+        CameraTracks[TrackIndex].Transform = InTransform;
+        CameraTracks[TrackIndex].FOV = InFOV;
+    }
+    else
+    {
+        UE_LOG(LogExtendedCamera, Warning, TEXT("Invalid Track Index (%d)"), TrackIndex);
+    }
+}
+
+void UExtendedCameraComponent::SetRotationBlend(EExtendedCameraRotationBlend NewBlend)
+{
+    RotationBlend = NewBlend;
+    MarkViewDirty();
+}
+
+void UExtendedCameraComponent::SetCameraTrackMode(int32 TrackIndex, EExtendedCameraDriverMode NewMode)
+{
+    if (CameraTracks.IsValidIndex(TrackIndex))
+    {
+        CameraTracks[TrackIndex].DriverMode = NewMode;
+        SelectTrackEvaluator(CameraTracks[TrackIndex]);
+    }
+    else
+    {
+        UE_LOG(LogExtendedCamera, Warning, TEXT("Invalid Track Index (%d)"), TrackIndex);
+    }
+}
+
+void UExtendedCameraComponent::SetCameraTrackAimSmoothTime(int32 TrackIndex, float SmoothTime)
+{
+    if (CameraTracks.IsValidIndex(TrackIndex))
+    {
+        CameraTracks[TrackIndex].AimSmoothTime = FMath::Max(SmoothTime, 0.f);
+    }
+    else
+    {
+        UE_LOG(LogExtendedCamera, Warning, TEXT("Invalid Track Index (%d)"), TrackIndex);
+    }
+}
+
+bool UExtendedCameraComponent::SetCameraTrackLocatorAndAim(int32 TrackIndex, AActor *Locator, FName LocatorBoneName,
+                                                           AActor *Aim, FName AimBoneName)
+{
+    if (!CameraTracks.IsValidIndex(TrackIndex))
+    {
+        UE_LOG(LogExtendedCamera, Warning, TEXT("Invalid Track Index (%d)"), TrackIndex);
+        return false;
+    }
+
+    auto &Track = CameraTracks[TrackIndex];
+    Track.Locator = Locator;
+    Track.Aim = Aim;
+
+    // Bones the mode doesn't use are always fine
+    const bool LocatorValid = SetTrackLocatorBone(Track, LocatorBoneName) || !UsesLocatorBone(Track.DriverMode);
+    const bool AimValid = SetTrackAimBone(Track, AimBoneName) || !UsesAimBone(Track.DriverMode);
+
+    return LocatorValid && AimValid;
+}
+
+bool UExtendedCameraComponent::GetCameraTrack(int32 TrackIndex, FExtendedCameraTrack &OutTrack)
+{
+    if (CameraTracks.IsValidIndex(TrackIndex))
+    {
+        OutTrack = CameraTracks[TrackIndex];
+        return true;
+    }
+
+    return false;
+}
+
+void UExtendedCameraComponent::SetCameraTrack(int32 TrackIndex, const FExtendedCameraTrack &InTrack)
+{
+    if (CameraTracks.IsValidIndex(TrackIndex))
+    {
+        CameraTracks[TrackIndex] = InTrack;
+        SelectTrackEvaluator(CameraTracks[TrackIndex]);
+    }
+    else
+    {
+        UE_LOG(LogExtendedCamera, Warning, TEXT("Invalid Track Index (%d)"), TrackIndex);
+    }
+}
+
+void UExtendedCameraComponent::KeepInFrameLineOfSight_Implementation(AActor *Owner, FMinimalViewInfo &DesiredView)
+{
+    EXTCAM_CALL(CommonKeepLineOfSight, Owner, DesiredView);
+}
+
+void UExtendedCameraComponent::KeepAnyLineOfSight_Implementation(AActor *Owner, FMinimalViewInfo &DesiredView)
+{
+    EXTCAM_CALL(CommonKeepLineOfSight, Owner, DesiredView);
+}
+
+void UExtendedCameraComponent::KeepPartialLineOfSight_Implementation(AActor *Owner, FMinimalViewInfo &DesiredView)
+{
+    auto World = GetWorld();
+    if (!World)
+    {
+        checkNoEntry();
+        return;
+    }
+
+    // The subsystem may have already picked this frame's probes for its batch
+    GetVisibilityProbes(Owner);
+    if (VisibilityRaysFrameNumber != GFrameCounter)
+    {
+        GatherVisibilityRays(Owner, DesiredView.Location);
+    }
+
+    FCollisionQueryParams Params{};
+    Params.AddIgnoredActor(Owner);
+
+    // Last frame's async results land whether or not their probe is due again
+    for (auto &Probe : VisibilityProbes)
+    {
+        FTraceDatum TraceData{};
+        if (Probe.AsyncHandle.IsValid() && World->QueryTraceData(Probe.AsyncHandle, TraceData))
+        {
+            SetVisibilityProbeResult(Probe, TraceData.OutHits.Num() > 0 ? TraceData.OutHits[0] : FHitResult(),
+                                     TraceData.Start, TraceData.End);
+            Probe.AsyncHandle = FTraceHandle();
+        }
+    }
+
+    // Only a few probes are retraced each frame, the rest keep their last answer
+    for (const int32 Ray : VisibilityRays)
+    {
+        if (VisibilityProbes.IsValidIndex(Ray))
+        {
+            TraceVisibilityProbe(Owner, VisibilityProbes[Ray], DesiredView.Location, Params);
+        }
+    }
+
+    int32 NumProbes = 0;
+    int32 NumVisible = 0;
+    for (const auto &Probe : VisibilityProbes)
+    {
+        if (!Probe.Resolved)
+        {
+            continue;
+        }
+
+        NumProbes += 1;
+        NumVisible += Probe.Visible ? 1 : 0;
+
+#if ENABLE_DRAW_DEBUG
+        if (AnyTrackAimDebug())
+        {
+            DrawDebugLine(World, Probe.Location, DesiredView.Location, Probe.Visible ? FColor::Green : FColor::Red);
+        }
+#endif // ENABLE_DRAW_DEBUG
+    }
+    VisibilityScore = float(NumVisible) / float(NumProbes);
+
+    // Too little of the owner is visible. Pull in to the hit nearest the camera, on its probe's segment, which
+    // brings that probe back into view. The aim ray alone can be clear while every probe is blocked
+    const FExtendedCameraVisibilityProbe *Nearest = nullptr;
+    if (VisibilityScore < VisibilityThreshold)
+    {
+        for (const auto &Probe : VisibilityProbes)
+        {
+            if (Probe.Resolved && !Probe.Visible && (!Nearest || Probe.BlockedTime > Nearest->BlockedTime))
+            {
+                Nearest = &Probe;
+            }
+        }
+    }
+
+    FHitResult LOSCheck{};
+    if (Nearest)
+    {
+        LOSCheck.bBlockingHit = true;
+        LOSCheck.Time = Nearest->BlockedTime;
+        LOSCheck.Normal = Nearest->BlockedNormal;
+        LOSCheck.ImpactNormal = Nearest->BlockedNormal;
+        PlaceHitOnSegment(LOSCheck, Nearest->Location, DesiredView.Location);
+    }
+    else
+    {
+        // Visible enough. Treat it as clear so smooth return can take us back out
+        LOSCheck.TraceStart = EXTCAM_CALL(GetAimLocation, Owner);
+        LOSCheck.TraceEnd = DesiredView.Location;
+    }
+
+    ApplyLineOfSightHit(Owner, DesiredView, LOSCheck);
+}
+
+void UExtendedCameraComponent::GetVisibilityProbes(AActor *Owner)
+{
+    TArray<FExtendedCameraVisibilityProbe, TInlineAllocator<16>> Probes;
+
+    // Carry each probe's results and bone across, so changing the set doesn't hand one probe's answer to another
+    const auto AddProbe = [this, &Probes](FName Bone, const FVector &Offset, bool IsAim) -> auto & {
+        auto &Probe = Probes.AddDefaulted_GetRef();
+        Probe.Bone = Bone;
+        Probe.Offset = Offset;
+        Probe.IsAim = IsAim;
+
+        const auto Previous = VisibilityProbes.FindByPredicate(
+            [&Probe](const FExtendedCameraVisibilityProbe &Other) { return Other.IsSameProbe(Probe); });
+        if (Previous)
+        {
+            Probe = MoveTemp(*Previous);
+        }
+        return Probe;
+    };
+
+    const auto OwnerTransform = Owner->GetActorTransform();
+    bool AnyResolved = false;
+
+    // Bones that can't be found are kept, unresolved, so the miss stays cached
+    for (const auto &Bone : VisibilityProbeBones)
+    {
+        auto &Probe = AddProbe(Bone, FVector::ZeroVector, false);
+        Probe.Resolved = BoneCheck(Owner, Bone, Probe.BoneCache);
+        if (Probe.Resolved)
+        {
+            Probe.Location = Probe.BoneCache.Mesh->GetBoneTransform(Probe.BoneCache.BoneIndex).GetLocation();
+            AnyResolved = true;
+        }
+    }
+
+    for (const auto &Offset : VisibilityProbeOffsets)
+    {
+        auto &Probe = AddProbe(NAME_None, Offset, false);
+        Probe.Location = OwnerTransform.TransformPosition(Offset);
+        Probe.Resolved = true;
+        AnyResolved = true;
+    }
+
+    if (!AnyResolved)
+    {
+        auto &Probe = AddProbe(NAME_None, FVector::ZeroVector, true);
+        Probe.Location = EXTCAM_CALL(GetAimLocation, Owner);
+        Probe.Resolved = true;
+    }
+
+    if (VisibilityProbes.Num() != Probes.Num())
+    {
+        NextVisibilityProbe = 0;
+        VisibilityRaysFrameNumber = MAX_uint64;
+    }
+
+    VisibilityProbes.Reset();
+    VisibilityProbes.Append(MoveTemp(Probes));
+}
+
+void UExtendedCameraComponent::GatherVisibilityRays(AActor *Owner, const FVector &ViewLocation)
+{
+    VisibilityRays.Reset();
+    VisibilityRaysFrameNumber = GFrameCounter;
+
+    const int32 NumProbes = VisibilityProbes.Num();
+    const int32 NumRays = FMath::Clamp(VisibilityRayBudget, 1, NumProbes);
+    const auto ToleranceSquared = FMath::Square(LineOfSightCachePositionTolerance);
+
+    // Walk the whole round robin if need be, passing over probes that haven't moved since they were traced
+    int32 Step = 0;
+    for (; Step < NumProbes && VisibilityRays.Num() < NumRays; ++Step)
+    {
+        const int32 Index = (NextVisibilityProbe + Step) % NumProbes;
+        const auto &Probe = VisibilityProbes[Index];
+        if (!Probe.Resolved)
+        {
+            continue;
+        }
+
+        if (UseLineOfSightCache && Probe.TracedFrameNumber != MAX_uint64 &&
+            GFrameCounter - Probe.TracedFrameNumber <= uint64(FMath::Max(LineOfSightCacheMaxAge, 0)) &&
+            FVector::DistSquared(Probe.TracedStart, Probe.Location) <= ToleranceSquared &&
+            FVector::DistSquared(Probe.TracedEnd, ViewLocation) <= ToleranceSquared)
+        {
+            INC_DWORD_STAT(STAT_ACILOSCacheHits);
+            continue;
+        }
+
+        VisibilityRays.Add(Index);
+    }
+    NextVisibilityProbe = NumProbes > 0 ? (NextVisibilityProbe + Step) % NumProbes : 0;
+}
+
+void UExtendedCameraComponent::TraceVisibilityProbe(AActor *Owner, FExtendedCameraVisibilityProbe &Probe,
+                                                    const FVector &ViewLocation, const FCollisionQueryParams &Params)
+{
+    INC_DWORD_STAT(STAT_ACIVisibilityRays);
+
+    // Anything between the subsystem and here may have moved the segment
+    if (UseBatchedLineOfSight && Probe.BatchedFrameNumber == GFrameCounter &&
+        Probe.BatchedStart.Equals(Probe.Location, KINDA_SMALL_NUMBER) &&
+        Probe.BatchedEnd.Equals(ViewLocation, KINDA_SMALL_NUMBER))
+    {
+        Probe.Visible = Probe.BatchedVisible;
+        Probe.TracedStart = Probe.BatchedStart;
+        Probe.TracedEnd = Probe.BatchedEnd;
+        Probe.TracedFrameNumber = GFrameCounter;
+        Probe.BlockedTime = Probe.BatchedTime;
+        Probe.BlockedNormal = Probe.BatchedNormal;
+        return;
+    }
+
+    auto World = GetWorld();
+
+    // Rays, not the LOS shape. We want to know if the point can be seen
+    if (UseAsyncLineOfSight)
+    {
+        Probe.AsyncHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Probe.Location, ViewLocation,
+                                                           this->GetCollisionObjectType(), Params);
+        INC_DWORD_STAT(STAT_ACITraces);
+
+        // A probe is only traced while we wait when it has never been seen
+        if (Probe.TracedFrameNumber != MAX_uint64)
+        {
+            return;
+        }
+    }
+
+    FHitResult ProbeHit{};
+    World->LineTraceSingleByChannel(ProbeHit, Probe.Location, ViewLocation, this->GetCollisionObjectType(), Params);
+    INC_DWORD_STAT(STAT_ACITraces);
+
+    SetVisibilityProbeResult(Probe, ProbeHit, Probe.Location, ViewLocation);
+}
+
+void UExtendedCameraComponent::CommonKeepLineOfSight_Implementation(AActor *Owner, FMinimalViewInfo &DesiredView)
+{
+    auto World = GetWorld();
+
+    if (World)
+    {
+        // Cast from owner to pawn
+        FCollisionQueryParams params{};
+        params.AddIgnoredActor(Owner);
+        FHitResult LOSCheck{};
+
+        // Owner Location is assumed to be aim. It's not always though. So we need to get the aim
+        auto Aim = EXTCAM_CALL(GetAimLocation, Owner);
+
+        if (QueryLineOfSightCache(Aim, DesiredView, LOSCheck))
+        {
+            INC_DWORD_STAT(STAT_ACILOSCacheHits);
+        }
+        else
+        {
+            if (HasBatchedLineOfSight(Aim, DesiredView.Location))
+            {
+                LOSCheck = BatchedLOSHit;
+            }
+            else if (!UseAsyncLineOfSight || !AsyncLineOfSight(Owner, Aim, DesiredView, params, LOSCheck))
+            {
+                // A line shape is traced as a ray, so this is only a sweep when we ask for one
+                World->SweepSingleByChannel(LOSCheck, Aim, DesiredView.Location, FQuat::Identity,
+                                            this->GetCollisionObjectType(), GetLineOfSightShape(), params);
+                INC_DWORD_STAT(STAT_ACITraces);
+            }
+
+            if (UseLineOfSightCache)
+            {
+                INC_DWORD_STAT(STAT_ACILOSCacheMisses);
+                StoreLineOfSightCache(Aim, DesiredView, LOSCheck);
+            }
+        }
+
+#if ENABLE_DRAW_DEBUG
+        if (AnyTrackAimDebug())
+        {
+            DrawDebugLine(GetWorld(), Aim, DesiredView.Location, FColor::Red);
+
+            DrawDebugSolidBox(GetWorld(), Aim, FVector(12.f), FColor(200, 20, 132, 128));
+            DrawDebugBox(GetWorld(), Aim, FVector(12.f), FColor::Black);
+        }
+#endif // ENABLE_DRAW_DEBUG
+
+        ApplyLineOfSightHit(Owner, DesiredView, LOSCheck);
+    }
+    else
+    {
+        // How did we get here?
+        checkNoEntry();
+    }
+}
+
+bool UExtendedCameraComponent::AsyncLineOfSight(AActor *Owner, const FVector &Aim, FMinimalViewInfo &DesiredView,
+                                                const FCollisionQueryParams &Params, FHitResult &LOSCheck)
+{
+    auto World = GetWorld();
+    bool HasResult = false;
+
+    // Last frame's trace. The queue only keeps results for one frame, so a hitch drops us back to blocking
+    FTraceDatum TraceData{};
+    if (AsyncLOSHandle.IsValid() && World->QueryTraceData(AsyncLOSHandle, TraceData))
+    {
+        HasResult = true;
+
+        if (TraceData.OutHits.Num() > 0 && TraceData.OutHits[0].bBlockingHit)
+        {
+            // The hit was traced against a predicted segment. Keep how far along it was blocked, and place
+            // that on this frame's segment so the result follows the camera
+            LOSCheck = TraceData.OutHits[0];
+            const auto Shift = FMath::Lerp(Aim, DesiredView.Location, LOSCheck.Time) - LOSCheck.Location;
+            LOSCheck.Location += Shift;
+            LOSCheck.ImpactPoint += Shift;
+            LOSCheck.TraceStart = Aim;
+            LOSCheck.TraceEnd = DesiredView.Location;
+        }
+    }
+
+    // Predict where the endpoints will be when we read this back
+    FVector Start = Aim;
+    FVector End = DesiredView.Location;
+    if (HasAsyncLOSHistory)
+    {
+        Start += (Aim - AsyncLOSPreviousAim) * AsyncLineOfSightExtrapolation;
+        End += (DesiredView.Location - AsyncLOSPreviousLocation) * AsyncLineOfSightExtrapolation;
+    }
+
+    AsyncLOSPreviousAim = Aim;
+    AsyncLOSPreviousLocation = DesiredView.Location;
+    HasAsyncLOSHistory = true;
+
+    AsyncLOSHandle = World->AsyncSweepByChannel(EAsyncTraceType::Single, Start, End, FQuat::Identity,
+                                                this->GetCollisionObjectType(), GetLineOfSightShape(), Params);
+    INC_DWORD_STAT(STAT_ACITraces);
+
+    return HasResult;
+}
+
+bool UExtendedCameraComponent::QueryLineOfSightCache(const FVector &Aim, const FMinimalViewInfo &DesiredView,
+                                                     FHitResult &LOSCheck) const
+{
+    if (!UseLineOfSightCache || LOSCache.FrameNumber == MAX_uint64 ||
+        GFrameCounter - LOSCache.FrameNumber > uint64(FMath::Max(LineOfSightCacheMaxAge, 0)))
+    {
+        return false;
+    }
+
+    const auto PositionToleranceSquared = FMath::Square(LineOfSightCachePositionTolerance);
+    if (FVector::DistSquared(LOSCache.Start, Aim) > PositionToleranceSquared ||
+        FVector::DistSquared(LOSCache.End, DesiredView.Location) > PositionToleranceSquared ||
+        !LOSCache.Rotation.Equals(DesiredView.Rotation, LineOfSightCacheRotationTolerance))
+    {
+        return false;
+    }
+
+    LOSCheck = LOSCache.Hit;
+    PlaceHitOnSegment(LOSCheck, Aim, DesiredView.Location);
+    return true;
+}
+
+void UExtendedCameraComponent::StoreLineOfSightCache(const FVector &Aim, const FMinimalViewInfo &DesiredView,
+                                                     const FHitResult &LOSCheck)
+{
+    // Tolerances are measured from here, so slow drift still retraces eventually
+    LOSCache.Start = Aim;
+    LOSCache.End = DesiredView.Location;
+    LOSCache.Rotation = DesiredView.Rotation;
+    LOSCache.Hit = LOSCheck;
+    LOSCache.FrameNumber = GFrameCounter;
+}
+
+void UExtendedCameraComponent::ApplyLineOfSightHit(AActor *Owner, FMinimalViewInfo &DesiredView,
+                                                   FHitResult &LOSCheck)
+{
+    // Before pushback, which the replay applies itself. Later fixed steps reuse the first's, as the replay will
+    if (Recorder && !RepeatingFixedStep)
+    {
+        RecordedFrame.HasLineOfSight = true;
+        RecordedFrame.LineOfSightBlocked = LOSCheck.bBlockingHit;
+        RecordedFrame.LineOfSightLocation = LOSCheck.Location;
+        RecordedFrame.LineOfSightNormal = LOSCheck.ImpactNormal;
+    }
+
+    LastLOSHit = LOSCheck;
+    HasLastLOSHit = true;
+    FixedStepLOSHit = true;
+
+    if (LOSCheck.bBlockingHit)
+    {
+        INC_DWORD_STAT(STAT_ACILOSBlocks);
+
+        if (!IsLOSBlocked)
+        {
+            StoredLOSFOV = DesiredView.FOV;
+        }
+
+        // Location is where the probe stopped. For a line that's the impact point
+        LOSCheck.Location += LOSCheck.ImpactNormal * LineOfSightPushback;
+
+        // Where the return heads back to, if LOS clears
+        const auto UnblockedLocation = DesiredView.Location;
+
+        if (UseDollyZoomForLOS)
+        {
+            DollyZoom(Owner, DesiredView, LOSCheck);
+        }
+
+        // Must be done after dollyzoom, otherwise we'll lerp nothing
+        DesiredView.Location = LOSCheck.Location;
+
+        // Update to reflect the offset position of the camera
+        // We need it later when the hit is not blocked
+        if (SmoothReturnOnLineOfSight)
+        {
+            // This gets set back to false when the lerp ends
+            WasLineOfSightBlockedRecently = true;
+            StoredPreviousLocationForReturn = LOSCheck.Location;
+
+            // The return spring starts from rest
+            SmoothReturnVelocity = FVector::ZeroVector;
+            SmoothReturnTarget = UnblockedLocation;
+        }
+    }
+    IsLOSBlocked = LOSCheck.bBlockingHit;
+}
+
+FCollisionShape UExtendedCameraComponent::GetLineOfSightShape() const
+{
+    return UseSweptLineOfSight ? FCollisionShape::MakeSphere(LineOfSightProbeRadius) : FCollisionShape();
+}
+
+void UExtendedCameraComponent::DollyZoom(AActor *Owner, FMinimalViewInfo &DesiredView, FHitResult &LOSCheck)
+{
+
+    // Compute the theta now. This is just FOV at distance X
+    // const auto CurrentTheta = FMath::DegreesToRadians(DesiredView.FOV * 0.5f);
+    const auto DVL = DesiredView.Location;
+    const auto OAL = HasEvaluationContext(Owner) ? EvaluationContext.OwnerLocation : Owner->GetActorLocation();
+    const auto LIP = LOSCheck.Location;
+    // const auto CurrentDistanceSQ = FVector::DistSquared(OAL, DVL);
+    // const auto NewDistanceSQ = FVector::DistSquared(OAL, LIP);
+    // const auto DistanceRatio = FMath::Sqrt(CurrentDistanceSQ / NewDistanceSQ);
+
+    // DesiredView.FOV = 2 * FMath::RadiansToDegrees(FMath::Atan((FMath::Tan(CurrentTheta) * FVector::Dist(OAL, DVL) /
+    // FVector::Dist(OAL, LIP)))); DesiredView.FOV = 2 * FMath::RadiansToDegrees(FMath::Atan(FMath::Tan(CurrentTheta) *
+    // DistanceRatio));
+    DesiredView.FOV = DollyZoom(FVector::Dist(OAL, DVL), DesiredView.FOV, FVector::Dist(OAL, LIP));
+}
+
+float UExtendedCameraComponent::DollyZoom(float ReferenceDistance, float ReferenceFOV, float CurrentDistance)
+{
+    EXTCAM_STAGE_SCOPE(DollyZoom);
+
+    // A bit of theory
+    // A size of TD := 2(tan(0) * x) where theta is FOV/2
+    //     /|  -
+    //   /  |  |
+    // /__x_|  | TD
+    // \    |  |
+    //   \  |  |
+    //     \|  -
+    // This computes the width or height, depending on the which theta we use
+    // We only have horizontal FOV, but the FOV shouldn't be varying between zooms
+    //
+    // Ultimately, We want TD to remain the same as we move from x to x' and we care about theta prime
+    // 2(tan(0) * x) = 2(tan(0') * x')
+    // tan(0) * x = tan(0') * x'
+    // tan(0') = (tan(0) * x) / x'
+    // 0' = atan((tan(0) * x) / x')
+    //
+    // Finally, we can combine x / x' as a ratio between the distances
+    // 0' = atan(tan(0) * r)
+
+    return ExtendedCameraMath::DollyZoomFOV(ReferenceDistance, ReferenceFOV, CurrentDistance);
+}
+
+void UExtendedCameraComponent::BlendTrack(FExtendedCameraTrack &Track, const FVector &OwnerLocation,
+                                          float FallbackFOV, FMinimalViewInfo &DesiredView, FQuat &ViewRotation)
+{
+    // Set OffsetTrack for the blend if it's non-zero
+    float OffsetTrackFOV = FallbackFOV;
+    if (!FMath::IsNearlyZero(Track.FOV))
+    {
+        OffsetTrackFOV = bUseAdditiveOffset ? (Track.FOV + AdditiveFOVOffset) : Track.FOV;
+    }
+
+    const auto TrackLocation = Track.Transform.GetLocation();
+
+    // DollyZoom
+    if (Track.DollyZoomEnabled)
+    {
+        const auto TrackDistance = FVector::Dist(OwnerLocation, TrackLocation);
+
+        if (Track.DollyZoomDistanceLiveUpdate)
+        {
+            Track.DollyZoomReferenceDistance = TrackDistance;
+        }
+
+        OffsetTrackFOV = DollyZoom(Track.DollyZoomReferenceDistance, Track.FOV, TrackDistance);
+    }
+
+    // Snaps to the track when it's fully blended
+    if (RotationBlend == EExtendedCameraRotationBlend::EulerBlend)
+    {
+        ExtendedCameraMath::BlendView(DesiredView.Location, DesiredView.Rotation, DesiredView.FOV, TrackLocation,
+                                      Track.Transform.GetRotation().Rotator(), OffsetTrackFOV, Track.BlendAlpha);
+    }
+    else
+    {
+        ExtendedCameraMath::BlendViewQuat(DesiredView.Location, ViewRotation, DesiredView.FOV, TrackLocation,
+                                          Track.Transform.GetRotation(), OffsetTrackFOV, Track.BlendAlpha,
+                                          RotationBlend == EExtendedCameraRotationBlend::SlerpBlend);
+    }
+}
+
+void UExtendedCameraComponent::GetCameraView(float DeltaTime, FMinimalViewInfo &DesiredView)
+{
+    // Start a counter here so it captures the super call
+    EXTCAM_STAGE_SCOPE(GetCameraViewInc);
+
+    // Parent Call
+    Super::GetCameraView(DeltaTime, DesiredView);
+
+    // Start a second counter that excludes the parent view update
+    EXTCAM_STAGE_SCOPE(GetCameraViewExc);
+
+    // Take whatever Sequencer or Blueprint wrote to the named track properties since last frame
+    SyncNamedTrackProperties();
+
+    // A baked shot stands in for the whole evaluation while its bindings hold
+    if (HasPlayableBakedShot() && BakedShot->Evaluate(BakedShotTime, DesiredView))
+    {
+        INC_DWORD_STAT(STAT_ACIBakedViews);
+        return;
+    }
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    // One recorded frame per view, however many fixed steps it takes
+    if (Recorder)
+    {
+        const auto ComponentOwner = GetOwner();
+        RecordedFrame.DeltaTime = DeltaTime;
+        RecordedFrame.BaseLocation = DesiredView.Location;
+        RecordedFrame.BaseRotation = DesiredView.Rotation;
+        RecordedFrame.BaseFOV = DesiredView.FOV;
+        RecordedFrame.OwnerRotation = IsValid(ComponentOwner) ? ComponentOwner->GetActorQuat() : FQuat::Identity;
+        RecordedFrame.HasLineOfSight = false;
+    }
+
+    if (UseFixedTimestep)
+    {
+        StepFixedTimestep(DeltaTime, DesiredView);
+    }
+    else
+    {
+        EvaluateView(DeltaTime, DesiredView);
+    }
+
+    if (Recorder)
+    {
+        Recorder->WriteFrame(RecordedFrame);
+        INC_DWORD_STAT(STAT_ACIRecordedFrames);
+    }
+
+    // And hand back what tracking wrote, for them to read
+    SyncNamedTrackProperties();
+
+    if (CameraSubsystem)
+    {
+        CameraSubsystem->AddCameraTime(FPlatformTime::Cycles64() - StartCycles);
+    }
+}
+
+void UExtendedCameraComponent::EvaluateView(float DeltaTime, FMinimalViewInfo &DesiredView)
+{
+    // Get Owner
+    const auto ComponentOwner = GetOwner();
+
+    if (HasBatchedView())
+    {
+        // The subsystem already tracked and blended us this frame
+        DesiredView.Location = BatchedLocation;
+        DesiredView.Rotation = BatchedRotation;
+        DesiredView.FOV = BatchedFOV;
+    }
+    else
+    {
+        // Initialise the Offset
+        // The first track falls back to the FOV we held when LOS was blocked, later ones to the blend so far
+        float FallbackFOV = IsLOSBlocked ? StoredLOSFOV : DesiredView.FOV;
+
+        // The subsystem may have tracked us already, and a throttled tier holds last frame's tracks
+        if (ReplayedFrame || (!HasTrackedThisFrame() && IsSignificantFrame()))
+        {
+            // Resolve everything the handlers read exactly once. Later fixed steps read the first step's
+            if (ReplayedFrame && !RepeatingFixedStep)
+            {
+                ApplyReplayedContext(*ReplayedFrame);
+            }
+            else if (!RepeatingFixedStep)
+            {
+                BuildEvaluationContext(ComponentOwner);
+            }
+
+            EXTCAM_STAGE_SCOPE(Tracking);
+            EXTCAM_CALL(TrackingHandler, ComponentOwner, DesiredView, GetSignificanceDeltaTime(DeltaTime));
+        }
+        else
+        {
+            // Held tracks, but the blend, dolly zoom and aim below still need this frame's owner
+            RefreshEvaluationContext(ComponentOwner);
+        }
+
+        if (ReplayedFrame)
+        {
+            ApplyReplayedTracks(*ReplayedFrame);
+        }
+        else if (Recorder && !RepeatingFixedStep)
+        {
+            CaptureRecordedTracks();
+        }
+
+        // Nothing upstream moved, so last frame's blend still stands. LOS still runs, as things move into it
+        if (UseIncrementalEvaluation && IsViewIdle(DesiredView))
+        {
+            DesiredView.Location = ViewSnapshot.Location;
+            DesiredView.Rotation = ViewSnapshot.Rotation;
+            DesiredView.FOV = ViewSnapshot.FOV;
+            ++ViewSnapshot.IdleFrames;
+            INC_DWORD_STAT(STAT_ACIIdleViews);
+        }
+        else
+        {
+            // What the blend started from, for the incremental snapshot
+            const auto BaseLocation = DesiredView.Location;
+            const auto BaseRotation = DesiredView.Rotation;
+            const auto BaseFOV = DesiredView.FOV;
+
+            const auto &OwnerLocation = EvaluationContext.OwnerLocation;
+
+            // Blending
+            EXTCAM_STAGE_SCOPE(Blend);
+
+            // Quaternion blends carry the rotation through the stack, and only come back to a rotator at the end
+            const bool BlendAsQuat = RotationBlend != EExtendedCameraRotationBlend::EulerBlend;
+            FQuat ViewRotation = BlendAsQuat ? DesiredView.Rotation.Quaternion() : FQuat::Identity;
+            bool ViewRotationBlended = false;
+
+            for (auto &Track : CameraTracks)
+            {
+                // Tracks with no influence are skipped entirely
+                if (!FMath::IsNearlyZero(Track.BlendAlpha))
+                {
+                    BlendTrack(Track, OwnerLocation, FallbackFOV, DesiredView, ViewRotation);
+                    ViewRotationBlended = true;
+                }
+
+                FallbackFOV = DesiredView.FOV;
+            }
+
+            // Untouched, the base rotation stands as it was rather than taking a round trip
+            if (BlendAsQuat && ViewRotationBlended)
+            {
+                DesiredView.Rotation = ViewRotation.Rotator();
+            }
+
+            if (UseIncrementalEvaluation)
+            {
+                StoreViewSnapshot(BaseLocation, BaseRotation, BaseFOV, DesiredView);
+            }
+        }
+    }
+
+    // Now LOS
+    {
+        EXTCAM_STAGE_SCOPE(LineOfSight);
+
+        if (RepeatingFixedStep)
+        {
+            // Traced once a frame. The world hasn't moved since the first step
+            ReuseFixedStepLineOfSight(ComponentOwner, DesiredView);
+        }
+        else if (ReplayedFrame)
+        {
+            if (ReplayedFrame->HasLineOfSight)
+            {
+                // The recorded hit stands in for the trace, and everything after it runs as it did
+                FHitResult LOSCheck{};
+                LOSCheck.bBlockingHit = ReplayedFrame->LineOfSightBlocked;
+                LOSCheck.Location = ReplayedFrame->LineOfSightLocation;
+                LOSCheck.ImpactNormal = ReplayedFrame->LineOfSightNormal;
+
+                // How far along the segment it was blocked, for later fixed steps to place on theirs
+                const auto Aim = EXTCAM_CALL(GetAimLocation, ComponentOwner);
+                const auto Segment = DesiredView.Location - Aim;
+                const auto Along = FVector::DotProduct(LOSCheck.Location - Aim, Segment);
+                LOSCheck.Time =
+                    Segment.IsNearlyZero() ? 1.f : float(FMath::Clamp(Along / Segment.SizeSquared(), 0.0, 1.0));
+                LOSCheck.TraceStart = Aim;
+                LOSCheck.TraceEnd = DesiredView.Location;
+
+                ApplyLineOfSightHit(ComponentOwner, DesiredView, LOSCheck);
+            }
+        }
+        else if (TracesLineOfSightThisFrame() && IsLineOfSightScheduled())
+        {
+            // Cleared so a handler that never reaches a hit isn't reused later
+            HasLastLOSHit = false;
+
+            const uint64 StartCycles = FPlatformTime::Cycles64();
+            EXTCAM_CALL(LineOfCheckHandler, ComponentOwner, DesiredView);
+            LineOfSightCycles += FPlatformTime::Cycles64() - StartCycles;
+        }
+        else if (GetActiveSignificance().LineOfSight != EExtendedCameraSignificanceLOS::SkipLineOfSight)
+        {
+            // Between a throttled tier's traces, or while the schedule holds this camera's trace back
+            ReuseLineOfSight(ComponentOwner, DesiredView);
+        }
+        else
+        {
+            // Skipped. Nothing holds the view in, so a blocked view is let go
+            IsLOSBlocked = false;
+        }
+    }
+
+    // Do SmoothReturn first, otherwise we can push the camera back out of bounds
+    {
+        EXTCAM_STAGE_SCOPE(SmoothReturn);
+        EXTCAM_CALL(SmoothReturn, ComponentOwner, DesiredView, DeltaTime);
+    }
+}
+
+void UExtendedCameraComponent::StepFixedTimestep(float DeltaTime, FMinimalViewInfo &DesiredView)
+{
+    const float StepTime = 1.f / FMath::Max(FixedTimestepRate, 1.f);
+    const FMinimalViewInfo BaseView = DesiredView;
+
+    // Every step starts from this frame's base view. The world only moves once per frame, so only the first step
+    // reads it. The rest integrate tracking and smooth return from what it resolved
+    int32 FrameSteps = 0;
+    FixedStepLOSHit = false;
+
+    const auto Step = [this, StepTime, &BaseView, &FrameSteps]() {
+        RepeatingFixedStep = FrameSteps++ > 0;
+
+        FMinimalViewInfo StepView = BaseView;
+        EvaluateView(StepTime, StepView);
+
+        PreviousSimView = CurrentSimView;
+        CurrentSimView.Location = StepView.Location;
+        CurrentSimView.Rotation = StepView.Rotation.Quaternion();
+        CurrentSimView.FOV = StepView.FOV;
+        INC_DWORD_STAT(STAT_ACIFixedSteps);
+    };
+
+    // Nothing to interpolate from yet, so start with one step and hold it
+    if (!HasSimView)
+    {
+        Step();
+        PreviousSimView = CurrentSimView;
+        FixedTimestepAccumulator = 0.f;
+        HasSimView = true;
+    }
+
+    FixedTimestepAccumulator += FMath::Max(DeltaTime, 0.f);
+
+    int32 Steps = 0;
+    while (FixedTimestepAccumulator >= StepTime && Steps < FixedTimestepMaxSteps)
+    {
+        Step();
+        FixedTimestepAccumulator -= StepTime;
+        ++Steps;
+    }
+
+    RepeatingFixedStep = false;
+
+    // A hitch longer than we'll step through is dropped, not caught up on over the next frames
+    FixedTimestepAccumulator = FMath::Min(FixedTimestepAccumulator, StepTime);
+
+    // The view trails the simulation by up to one step
+    const float Alpha = FMath::Clamp(FixedTimestepAccumulator / StepTime, 0.f, 1.f);
+    DesiredView.Location = FMath::Lerp(PreviousSimView.Location, CurrentSimView.Location, Alpha);
+    DesiredView.Rotation = FQuat::Slerp(PreviousSimView.Rotation, CurrentSimView.Rotation, Alpha).Rotator();
+    DesiredView.FOV = FMath::Lerp(PreviousSimView.FOV, CurrentSimView.FOV, Alpha);
+}
+
+void UExtendedCameraComponent::ReuseFixedStepLineOfSight(AActor *Owner, FMinimalViewInfo &DesiredView)
+{
+    // The first step skipped LOS, or didn't want it
+    if (!FixedStepLOSHit)
+    {
+        return;
+    }
+
+    // The aim is read from the same context, so the first step's start still holds
+    FHitResult LOSCheck = LastLOSHit;
+    PlaceHitOnSegment(LOSCheck, LastLOSHit.TraceStart, DesiredView.Location);
+    INC_DWORD_STAT(STAT_ACIReusedLOS);
+
+    ApplyLineOfSightHit(Owner, DesiredView, LOSCheck);
+}
+
+void UExtendedCameraComponent::ResetFixedTimestep()
+{
+    FixedTimestepAccumulator = 0.f;
+    HasSimView = false;
+}
+
+void UExtendedCameraComponent::ApplyReplayedContext(const FExtendedCameraRecordedFrame &Frame)
+{
+    EvaluationContext.FrameNumber = GFrameCounter;
+    EvaluationContext.Owner = GetOwner();
+    EvaluationContext.OwnerLocation = Frame.OwnerLocation;
+    EvaluationContext.Tracks.SetNum(CameraTracks.Num(), false);
+
+    // Tracks the recording didn't have are left without a locator or aim
+    for (int32 Index = 0; Index < CameraTracks.Num(); ++Index)
+    {
+        auto &Context = EvaluationContext.Tracks[Index];
+        Context = FExtendedCameraTrackContext();
+
+        if (Frame.Tracks.IsValidIndex(Index))
+        {
+            const auto &Recorded = Frame.Tracks[Index];
+            Context.Alpha = Recorded.Alpha;
+            Context.HasLocator = Recorded.HasLocator;
+            Context.HasAim = Recorded.HasAim;
+            Context.Locator = Recorded.Locator;
+            Context.Aim = Recorded.Aim;
+            Context.AimPoint = Recorded.Aim.TransformPosition(CameraTracks[Index].AimOffset);
+        }
+    }
+}
+
+void UExtendedCameraComponent::ApplyReplayedTracks(const FExtendedCameraRecordedFrame &Frame)
+{
+    for (int32 Index = 0; Index < CameraTracks.Num(); ++Index)
+    {
+        auto &Track = CameraTracks[Index];
+        if (!Frame.Tracks.IsValidIndex(Index))
+        {
+            Track.BlendAlpha = 0.f;
+            continue;
+        }
+
+        const auto &Recorded = Frame.Tracks[Index];
+        Track.BlendAlpha = Recorded.Alpha;
+        Track.FOV = Recorded.FOV;
+
+        // Locator and aim driven tracks were rebuilt by tracking. Everything else is as recorded
+        if (!Recorded.HasLocator || !Recorded.HasAim)
+        {
+            Track.Transform.SetLocation(Recorded.Transform.GetLocation());
+            Track.Transform.SetRotation(Recorded.Transform.GetRotation());
+        }
+    }
+}
+
+void UExtendedCameraComponent::CaptureRecordedTracks()
+{
+    RecordedFrame.OwnerLocation = EvaluationContext.OwnerLocation;
+    RecordedFrame.Tracks.SetNum(CameraTracks.Num(), false);
+
+    for (int32 Index = 0; Index < CameraTracks.Num(); ++Index)
+    {
+        const auto &Track = CameraTracks[Index];
+        const auto &Context = EvaluationContext.Tracks[Index];
+        auto &Recorded = RecordedFrame.Tracks[Index];
+
+        Recorded.Transform = Track.Transform;
+        Recorded.Alpha = Track.BlendAlpha;
+        Recorded.FOV = Track.FOV;
+        Recorded.HasLocator = Context.HasLocator;
+        Recorded.HasAim = Context.HasAim;
+        Recorded.Locator = Context.Locator;
+        Recorded.Aim = Context.Aim;
+    }
+}
+
+bool UExtendedCameraComponent::IsViewIdle(const FMinimalViewInfo &BaseView) const
+{
+    const auto &Snapshot = ViewSnapshot;
+    if (!Snapshot.IsValid || Snapshot.IdleFrames >= IncrementalMaxIdleFrames)
+    {
+        return false;
+    }
+
+    // The first track's FOV falls back to the one held while LOS is blocked
+    if (!Snapshot.BaseLocation.Equals(BaseView.Location) || !Snapshot.BaseRotation.Equals(BaseView.Rotation) ||
+        !FMath::IsNearlyEqual(Snapshot.BaseFOV, BaseView.FOV) ||
+        !Snapshot.OwnerLocation.Equals(EvaluationContext.OwnerLocation) || Snapshot.LOSBlocked != IsLOSBlocked ||
+        (IsLOSBlocked && !FMath::IsNearlyEqual(Snapshot.LOSFOV, StoredLOSFOV)) ||
+        Snapshot.Tracks.Num() != CameraTracks.Num())
+    {
+        return false;
+    }
+
+    // Aim interpolation still in flight shows up here as a moving transform
+    for (int32 Index = 0; Index < CameraTracks.Num(); ++Index)
+    {
+        const auto &Track = CameraTracks[Index];
+        const auto &TrackSnapshot = Snapshot.Tracks[Index];
+        if (!TrackSnapshot.Transform.Equals(Track.Transform) || TrackSnapshot.FOV != Track.FOV ||
+            TrackSnapshot.BlendAlpha != Track.BlendAlpha || TrackSnapshot.DollyZoomEnabled != Track.DollyZoomEnabled ||
+            TrackSnapshot.DollyZoomReferenceDistance != Track.DollyZoomReferenceDistance)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void UExtendedCameraComponent::StoreViewSnapshot(const FVector &BaseLocation, const FRotator &BaseRotation,
+                                                 float BaseFOV, const FMinimalViewInfo &BlendedView)
+{
+    auto &Snapshot = ViewSnapshot;
+    Snapshot.BaseLocation = BaseLocation;
+    Snapshot.BaseRotation = BaseRotation;
+    Snapshot.BaseFOV = BaseFOV;
+    Snapshot.OwnerLocation = EvaluationContext.OwnerLocation;
+    Snapshot.LOSBlocked = IsLOSBlocked;
+    Snapshot.LOSFOV = StoredLOSFOV;
+
+    Snapshot.Tracks.SetNum(CameraTracks.Num());
+    for (int32 Index = 0; Index < CameraTracks.Num(); ++Index)
+    {
+        const auto &Track = CameraTracks[Index];
+        auto &TrackSnapshot = Snapshot.Tracks[Index];
+        TrackSnapshot.Transform = Track.Transform;
+        TrackSnapshot.FOV = Track.FOV;
+        TrackSnapshot.BlendAlpha = Track.BlendAlpha;
+        TrackSnapshot.DollyZoomEnabled = Track.DollyZoomEnabled;
+        TrackSnapshot.DollyZoomReferenceDistance = Track.DollyZoomReferenceDistance;
+    }
+
+    Snapshot.Location = BlendedView.Location;
+    Snapshot.Rotation = BlendedView.Rotation;
+    Snapshot.FOV = BlendedView.FOV;
+    Snapshot.IsValid = true;
+    Snapshot.IdleFrames = 0;
+}
+
+void UExtendedCameraComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    SyncNamedTrackProperties();
+
+    // Throttled tiers track on different frames from one camera to the next
+    SignificancePhase = PointerHash(this);
+
+    CameraSubsystem = UWorld::GetSubsystem<UExtendedCameraSubsystem>(GetWorld());
+    if (CameraSubsystem)
+    {
+        CameraSubsystem->RegisterCamera(this);
+    }
+
+    // Decides which events skip ProcessEvent, and whether tracking can run on workers
+    CacheScriptOverrides();
+
+    // Set up our temporary variables here
+    for (auto &Track : CameraTracks)
+    {
+        Track.PastFrameLookAt = Track.Transform.Rotator();
+        Track.PastFrameAimTarget = Track.PastFrameLookAt;
+        Track.AimVelocity = FRotator::ZeroRotator;
+        SelectTrackEvaluator(Track);
+    }
+}
+
+void UExtendedCameraComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    StopRecording();
+
+    if (CameraSubsystem)
+    {
+        CameraSubsystem->UnregisterCamera(this);
+        CameraSubsystem = nullptr;
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UExtendedCameraComponent::GetBaseView(FMinimalViewInfo &OutView) const
+{
+    // Mirrors UCameraComponent::GetCameraView
+    FTransform CameraToWorld = GetComponentToWorld();
+    OutView.FOV = FieldOfView;
+
+    if (bUseAdditiveOffset)
+    {
+        CameraToWorld = AdditiveOffset * CameraToWorld;
+        OutView.FOV += AdditiveFOVOffset;
+    }
+
+    OutView.Location = CameraToWorld.GetLocation();
+    OutView.Rotation = CameraToWorld.Rotator();
+}
+
+bool UExtendedCameraComponent::HasBatchedView() const
+{
+    return UseBatchedEvaluation && BatchedFrameNumber == GFrameCounter;
+}
+
+void UExtendedCameraComponent::Serialize(FArchive &Ar)
+{
+    Super::Serialize(Ar);
+
+    Ar.UsingCustomVersion(FExtendedCameraCustomVersion::GUID);
+}
+
+void UExtendedCameraComponent::PostLoad()
+{
+    Super::PostLoad();
+
+    // Older assets only have the named track properties
+    if (GetLinkerCustomVersion(FExtendedCameraCustomVersion::GUID) < FExtendedCameraCustomVersion::TracksAsArray)
+    {
+        MigrateNamedTrackProperties();
+    }
+
+    SyncNamedTrackProperties();
+}
+
+#if WITH_EDITOR
+void UExtendedCameraComponent::PostEditChangeProperty(FPropertyChangedEvent &PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    // Removing array entries in the details panel must not take the named tracks with them
+    SyncNamedTrackProperties();
+    MarkViewDirty();
 }
+#endif // WITH_EDITOR
 
-void UExtendedCameraComponent::SetCameraSecondaryRotation(FRotator &InRotation)
+void UExtendedCameraComponent::MigrateNamedTrackProperties()
 {
-    SecondaryTrackTransform.SetRotation(InRotation.Quaternion());
+    EnsureNamedTracks();
+
+#define EXTCAM_MIGRATE_PROPERTY(Property, TrackIndex, Field) CameraTracks[TrackIndex].Field = Property;
+    EXTCAM_NAMED_TRACK_PROPERTIES(EXTCAM_MIGRATE_PROPERTY)
+#undef EXTCAM_MIGRATE_PROPERTY
 }
 
-void UExtendedCameraComponent::SetCameraPrimaryLocation(FVector &InLocation)
+void UExtendedCameraComponent::SyncNamedTrackProperties()
 {
-    PrimaryTrackTransform.SetLocation(InLocation);
+    EnsureNamedTracks();
+
+    bool Written = false;
+#define EXTCAM_SYNC_PROPERTY(Property, TrackIndex, Field)                                                              \
+    Written |= SyncNamedTrackProperty(Property, SyncedNamedTracks[TrackIndex].Field, CameraTracks[TrackIndex].Field);
+    EXTCAM_NAMED_TRACK_PROPERTIES(EXTCAM_SYNC_PROPERTY)
+#undef EXTCAM_SYNC_PROPERTY
+
+    if (Written)
+    {
+        MarkViewDirty();
+    }
 }
 
-void UExtendedCameraComponent::SetCameraSecondaryLocation(FVector &InLocation)
+void UExtendedCameraComponent::SetCameraPrimaryTrack(FVector &&InLocation, FRotator &&InRotation, float InFOV)
 {
-    SecondaryTrackTransform.SetLocation(InLocation);
+    auto &Track = GetNamedTrack(PrimaryTrackIndex);
+    Track.Transform.SetLocation(MoveTemp(InLocation));
+    Track.Transform.SetRotation(MoveTemp(InRotation).Quaternion());
+    Track.FOV = InFOV;
 }
 
-void UExtendedCameraComponent::SetCameraPrimaryFOV(float InFOV)
+void UExtendedCameraComponent::SetCameraSecondaryTrack(FVector &&InLocation, FRotator &&InRotation, float InFOV)
 {
-    PrimaryTrackFOV = InFOV;
+    auto &Track = GetNamedTrack(SecondaryTrackIndex);
+    Track.Transform.SetLocation(MoveTemp(InLocation));
+    Track.Transform.SetRotation(MoveTemp(InRotation).Quaternion());
+    Track.FOV = InFOV;
 }
 
-void UExtendedCameraComponent::SetCameraSecondaryFOV(float InFOV)
+void UExtendedCameraComponent::SetCameraPrimaryLocationRotation(FVector &&InLocation, FRotator &&InRotation)
 {
-    SecondaryTrackFOV = InFOV;
+    auto &Track = GetNamedTrack(PrimaryTrackIndex);
+    Track.Transform.SetLocation(MoveTemp(InLocation));
+    Track.Transform.SetRotation(MoveTemp(InRotation).Quaternion());
 }
 
-bool UExtendedCameraComponent::GetUsePrimaryTrack()
+void UExtendedCameraComponent::SetCameraSecondaryLocationRotation(FVector &&InLocation, FRotator &&InRotation)
 {
-    return FMath::IsNearlyEqual(CameraPrimaryTrackBlendAlpha, 1.f);
+    auto &Track = GetNamedTrack(SecondaryTrackIndex);
+    Track.Transform.SetLocation(MoveTemp(InLocation));
+    Track.Transform.SetRotation(MoveTemp(InRotation).Quaternion());
 }
 
-bool UExtendedCameraComponent::GetUseSecondaryTrack()
+void UExtendedCameraComponent::SetCameraPrimaryRotation(FRotator &&InRotation)
 {
-    return FMath::IsNearlyEqual(CameraSecondaryTrackBlendAlpha, 1.f);
+    GetNamedTrack(PrimaryTrackIndex).Transform.SetRotation(MoveTemp(InRotation).Quaternion());
 }
 
-void UExtendedCameraComponent::SetCameraMode(EExtendedCameraMode NewMode)
+void UExtendedCameraComponent::SetCameraSecondaryRotation(FRotator &&InRotation)
 {
-    CameraLOSMode = NewMode;
+    GetNamedTrack(SecondaryTrackIndex).Transform.SetRotation(MoveTemp(InRotation).Quaternion());
 }
 
-TEnumAsByte<EExtendedCameraMode> UExtendedCameraComponent::GetCameraMode()
+void UExtendedCameraComponent::SetCameraPrimaryLocation(FVector &&InLocation)
 {
-    return CameraLOSMode;
+    GetNamedTrack(PrimaryTrackIndex).Transform.SetLocation(MoveTemp(InLocation));
 }
 
-void UExtendedCameraComponent::SetPrimaryTrackDollyZoomReferenceDistance(float Distance)
+void UExtendedCameraComponent::SetCameraSecondaryLocation(FVector &&InLocation)
 {
-    FirstTrackDollyZoomReferenceDistance = Distance;
+    GetNamedTrack(SecondaryTrackIndex).Transform.SetLocation(MoveTemp(InLocation));
 }
 
-void UExtendedCameraComponent::SetSecondaryTrackDollyZoomReferenceDistance(float Distance)
+void UExtendedCameraComponent::SetCameraTrackRotation(int32 TrackIndex, const FQuat &InRotation)
 {
-    SecondTrackDollyZoomReferenceDistance = Distance;
+    if (CameraTracks.IsValidIndex(TrackIndex))
+    {
+        CameraTracks[TrackIndex].Transform.SetRotation(InRotation);
+    }
+    else
+    {
+        UE_LOG(LogExtendedCamera, Warning, TEXT("Invalid Track Index (%d)"), TrackIndex);
+    }
 }
 
-void UExtendedCameraComponent::SetPrimaryTrackDollyZoomEnabled(bool Enabled)
+void UExtendedCameraComponent::EvaluateRecordedFrame(const FExtendedCameraRecordedFrame &Frame,
+                                                     FMinimalViewInfo &OutView)
 {
-    FirstTrackDollyZoomEnabled = Enabled;
+    OutView.Location = Frame.BaseLocation;
+    OutView.Rotation = Frame.BaseRotation;
+    OutView.FOV = Frame.BaseFOV;
+
+    // A fixed timestep camera was recorded a frame at a time, and steps through it the same way
+    ReplayedFrame = &Frame;
+    if (UseFixedTimestep)
+    {
+        StepFixedTimestep(Frame.DeltaTime, OutView);
+    }
+    else
+    {
+        EvaluateView(Frame.DeltaTime, OutView);
+    }
+    ReplayedFrame = nullptr;
 }
 
-void UExtendedCameraComponent::SetSecondaryTrackDollyZoomEnabled(bool Enabled)
+void UExtendedCameraComponent::CaptureRecordingState(FExtendedCameraRecordedState &OutState) const
 {
-    SecondTrackDollyZoomEnabled = Enabled;
+    OutState.Tracks.SetNum(CameraTracks.Num());
+    for (int32 Index = 0; Index < CameraTracks.Num(); ++Index)
+    {
+        const auto &Track = CameraTracks[Index];
+        auto &TrackState = OutState.Tracks[Index];
+        TrackState.PastFrameLookAt = Track.PastFrameLookAt;
+        TrackState.PastFrameAimTarget = Track.PastFrameAimTarget;
+        TrackState.AimVelocity = Track.AimVelocity;
+        TrackState.DollyZoomReferenceDistance = Track.DollyZoomReferenceDistance;
+    }
+
+    OutState.IsLOSBlocked = IsLOSBlocked;
+    OutState.StoredLOSFOV = StoredLOSFOV;
+    OutState.WasLineOfSightBlockedRecently = WasLineOfSightBlockedRecently;
+    OutState.StoredPreviousLocationForReturn = StoredPreviousLocationForReturn;
+    OutState.SmoothReturnVelocity = SmoothReturnVelocity;
+    OutState.SmoothReturnTarget = SmoothReturnTarget;
 }
 
-void UExtendedCameraComponent::SetPrimaryTrackDollyZoomLiveUpdate(bool Enabled)
+void UExtendedCameraComponent::RestoreRecordingState(const FExtendedCameraRecordedState &State)
 {
-    FirstTrackDollyZoomDistanceLiveUpdate = Enabled;
+    for (int32 Index = 0; Index < FMath::Min(CameraTracks.Num(), State.Tracks.Num()); ++Index)
+    {
+        auto &Track = CameraTracks[Index];
+        const auto &TrackState = State.Tracks[Index];
+        Track.PastFrameLookAt = TrackState.PastFrameLookAt;
+        Track.PastFrameAimTarget = TrackState.PastFrameAimTarget;
+        Track.AimVelocity = TrackState.AimVelocity;
+        Track.DollyZoomReferenceDistance = TrackState.DollyZoomReferenceDistance;
+    }
+
+    IsLOSBlocked = State.IsLOSBlocked;
+    StoredLOSFOV = State.StoredLOSFOV;
+    WasLineOfSightBlockedRecently = State.WasLineOfSightBlockedRecently;
+    StoredPreviousLocationForReturn = State.StoredPreviousLocationForReturn;
+    SmoothReturnVelocity = State.SmoothReturnVelocity;
+    SmoothReturnTarget = State.SmoothReturnTarget;
+    MarkViewDirty();
+
+    // Recordings start the fixed steps over
+    ResetFixedTimestep();
 }
 
-void UExtendedCameraComponent::SetSecondaryTrackDollyZoomLiveUpdate(bool Enabled)
+bool UExtendedCameraComponent::SetPrimaryLocatorBoneName(FName TrackedBoneName)
 {
-    SecondTrackDollyZoomDistanceLiveUpdate = Enabled;
+    return SetTrackLocatorBone(GetNamedTrack(PrimaryTrackIndex), TrackedBoneName);
 }
 
-void UExtendedCameraComponent::SetPrimaryTrackedCamera(ACameraActor *TrackedCamera)
+bool UExtendedCameraComponent::SetSecondaryLocatorBoneName(FName TrackedBoneName)
 {
-    PrimaryTrackedCamera = TrackedCamera;
+    return SetTrackLocatorBone(GetNamedTrack(SecondaryTrackIndex), TrackedBoneName);
 }
 
-void UExtendedCameraComponent::SetSecondaryTrackedCamera(ACameraActor *TrackedCamera)
+bool UExtendedCameraComponent::SetPrimaryLocatorAimName(FName TrackedAimName)
 {
-    SecondaryTrackedCamera = TrackedCamera;
+    return SetTrackAimBone(GetNamedTrack(PrimaryTrackIndex), TrackedAimName);
 }
 
-void UExtendedCameraComponent::SetPrimaryTrackLocator(AActor *TrackedActor)
+bool UExtendedCameraComponent::SetSecondaryLocatorAimName(FName TrackedAimName)
 {
-    PrimaryTrackLocator = TrackedActor;
+    return SetTrackAimBone(GetNamedTrack(SecondaryTrackIndex), TrackedAimName);
 }
 
-void UExtendedCameraComponent::SetSecondaryTrackLocator(AActor *TrackedActor)
+void UExtendedCameraComponent::SetFOVCheckOffsetInRadians(float FOVOffset)
 {
-    SecondaryTrackLocator = TrackedActor;
+    FOVCheckOffsetInRadians = FOVOffset;
+    MarkViewDirty();
 }
 
-void UExtendedCameraComponent::SetPrimaryTrackAim(AActor *TrackedActor)
+void UExtendedCameraComponent::SetUseDollyZoom(bool NewState)
 {
-    PrimaryTrackLocator = TrackedActor;
+    UseDollyZoomForLOS = NewState;
+    MarkViewDirty();
 }
 
-void UExtendedCameraComponent::SetSecondaryTrackAim(AActor *TrackedActor)
+void UExtendedCameraComponent::SetVisibilityProbes(const TArray<FName> &ProbeBones,
+                                                   const TArray<FVector> &ProbeOffsets)
 {
-    SecondaryTrackAim = TrackedActor;
+    VisibilityProbeBones = ProbeBones;
+    VisibilityProbeOffsets = ProbeOffsets;
+    MarkViewDirty();
 }
 
-void UExtendedCameraComponent::SetPrimaryTrackAimInterpolationSpeed(float Speed)
+void UExtendedCameraComponent::SetVisibilityThreshold(float Threshold, int32 RayBudget)
 {
-    PrimaryTrackAimInterpolationSpeed = Speed;
+    VisibilityThreshold = FMath::Clamp(Threshold, 0.f, 1.f);
+    VisibilityRayBudget = FMath::Max(RayBudget, 1);
+    MarkViewDirty();
 }
 
-void UExtendedCameraComponent::SetSecondaryTrackAimInterpolationSpeed(float Speed)
+float UExtendedCameraComponent::GetVisibilityScore() const
 {
-    SecondaryTrackAimInterpolationSpeed = Speed;
+    return VisibilityScore;
 }
 
-void UExtendedCameraComponent::SetSecondaryTrackAimOffset(FVector &AimOffset)
+void UExtendedCameraComponent::SetUseSweptLineOfSight(bool NewState, float ProbeRadius, float Pushback)
 {
-    SecondaryTrackAimOffset = AimOffset;
+    UseSweptLineOfSight = NewState;
+    LineOfSightProbeRadius = FMath::Max(ProbeRadius, 0.f);
+    LineOfSightPushback = FMath::Max(Pushback, 0.f);
+
+    // Results from the other shape don't apply
+    LOSCache.Reset();
+    MarkViewDirty();
 }
 
-void UExtendedCameraComponent::SetPrimaryTrackAimOffset(FVector &AimOffset)
+void UExtendedCameraComponent::SetUseAsyncLineOfSight(bool NewState)
 {
-    PrimaryTrackAimOffset = AimOffset;
+    UseAsyncLineOfSight = NewState;
+
+    // Stale endpoints would extrapolate wildly on the first async frame
+    HasAsyncLOSHistory = false;
+    AsyncLOSHandle.Invalidate();
+    MarkViewDirty();
 }
 
-void UExtendedCameraComponent::KeepInFrameLineOfSight_Implementation(AActor *Owner, FMinimalViewInfo &DesiredView)
+void UExtendedCameraComponent::SetAsyncLineOfSightExtrapolation(float Extrapolation)
 {
-    CommonKeepLineOfSight(Owner, DesiredView);
+    AsyncLineOfSightExtrapolation = Extrapolation;
 }
 
-void UExtendedCameraComponent::KeepAnyLineOfSight_Implementation(AActor *Owner, FMinimalViewInfo &DesiredView)
+void UExtendedCameraComponent::SetUseBatchedEvaluation(bool NewState)
 {
-    CommonKeepLineOfSight(Owner, DesiredView);
+    UseBatchedEvaluation = NewState;
 }
 
-void UExtendedCameraComponent::CommonKeepLineOfSight_Implementation(AActor *Owner, FMinimalViewInfo &DesiredView)
+void UExtendedCameraComponent::SetUseIncrementalEvaluation(bool NewState, int32 MaxIdleFrames)
 {
-    auto World = GetWorld();
-
-    if (World)
-    {
-        // Cast from owner to pawn
-        FCollisionQueryParams params{};
-        params.AddIgnoredActor(Owner);
-        FHitResult LOSCheck{};
+    UseIncrementalEvaluation = NewState;
+    IncrementalMaxIdleFrames = FMath::Max(MaxIdleFrames, 0);
+    MarkViewDirty();
+}
 
-        // Owner Location is assumed to be aim. It's not always though. So we need to get the aim
-        auto Aim = GetAimLocation(Owner);
+void UExtendedCameraComponent::SetUseFixedTimestep(bool NewState, float Rate)
+{
+    UseFixedTimestep = NewState;
+    FixedTimestepRate = FMath::Max(Rate, 1.f);
+    ResetFixedTimestep();
+}
 
-        World->LineTraceSingleByChannel(LOSCheck, Aim, DesiredView.Location, this->GetCollisionObjectType(), params);
+bool UExtendedCameraComponent::StartRecording(const FString &Filename)
+{
+    StopRecording();
 
-#if ENABLE_DRAW_DEBUG
-        if (PrimaryTrackAimDebug || SecondaryTrackAimDebug)
-        {
-            DrawDebugLine(GetWorld(), Aim, DesiredView.Location, FColor::Red);
+    const auto Path =
+        FPaths::IsRelative(Filename) ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("CameraRecordings"), Filename)
+                                     : Filename;
 
-            DrawDebugSolidBox(GetWorld(), Aim, FVector(12.f), FColor(200, 20, 132, 128));
-            DrawDebugBox(GetWorld(), Aim, FVector(12.f), FColor::Black);
-        }
-#endif // ENABLE_DRAW_DEBUG
+    // The replay starts its fixed steps over, so the recording does too
+    ResetFixedTimestep();
 
-        if (LOSCheck.bBlockingHit)
-        {
-            if (!IsLOSBlocked)
-            {
-                StoredLOSFOV = DesiredView.FOV;
-            }
+    FExtendedCameraRecordedState State;
+    CaptureRecordingState(State);
 
-            if (UseDollyZoomForLOS)
-            {
-                DollyZoom(Owner, DesiredView, LOSCheck);
-            }
+    Recorder = MakeUnique<FExtendedCameraRecordingWriter>();
+    if (!Recorder->Open(Path, State))
+    {
+        UE_LOG(LogExtendedCamera, Warning, TEXT("Couldn't open camera recording %s"), *Path);
+        Recorder.Reset();
+        return false;
+    }
 
-            // Must be done after dollyzoom, otherwise we'll lerp nothing
-            DesiredView.Location = LOSCheck.ImpactPoint; // + LOSCheck.ImpactNormal * 0.1f;
+    // The replay starts without a snapshot, so neither can the recording
+    MarkViewDirty();
+    return true;
+}
 
-            // Update to reflect the offset position of the camera
-            // We need it later when the hit is not blocked
-            if (SmoothReturnOnLineOfSight)
-            {
-                // This gets set back to false when the lerp ends
-                WasLineOfSightBlockedRecently = true;
-                StoredPreviousLocationForReturn = LOSCheck.ImpactPoint;
-            }
-        }
-        IsLOSBlocked = LOSCheck.bBlockingHit;
-    }
-    else
+void UExtendedCameraComponent::StopRecording()
+{
+    if (Recorder)
     {
-        // How did we get here?
-        checkNoEntry();
+        Recorder->Close();
+        Recorder.Reset();
     }
 }
 
-void UExtendedCameraComponent::DollyZoom(AActor *Owner, FMinimalViewInfo &DesiredView, FHitResult &LOSCheck)
+bool UExtendedCameraComponent::IsRecording() const
 {
-
-    // Compute the theta now. This is just FOV at distance X
-    // const auto CurrentTheta = FMath::DegreesToRadians(DesiredView.FOV * 0.5f);
-    const auto DVL = DesiredView.Location;
-    const auto OAL = Owner->GetActorLocation();
-    const auto LIP = LOSCheck.ImpactPoint;
-    // const auto CurrentDistanceSQ = FVector::DistSquared(OAL, DVL);
-    // const auto NewDistanceSQ = FVector::DistSquared(OAL, LIP);
-    // const auto DistanceRatio = FMath::Sqrt(CurrentDistanceSQ / NewDistanceSQ);
-
-    // DesiredView.FOV = 2 * FMath::RadiansToDegrees(FMath::Atan((FMath::Tan(CurrentTheta) * FVector::Dist(OAL, DVL) /
-    // FVector::Dist(OAL, LIP)))); DesiredView.FOV = 2 * FMath::RadiansToDegrees(FMath::Atan(FMath::Tan(CurrentTheta) *
-    // DistanceRatio));
-    DesiredView.FOV = DollyZoom(FVector::Dist(OAL, DVL), DesiredView.FOV, FVector::Dist(OAL, LIP));
+    return Recorder.IsValid();
 }
 
-float UExtendedCameraComponent::DollyZoom(float ReferenceDistance, float ReferenceFOV, float CurrentDistance)
+bool UExtendedCameraComponent::BakeShot(UMovieSceneSequencePlayer *Player, UExtendedCameraBakedShot *Shot,
+                                        float SampleRate)
 {
-    // A bit of theory
-    // A size of TD := 2(tan(0) * x) where theta is FOV/2
-    //     /|  -
-    //   /  |  |
-    // /__x_|  | TD
-    // \    |  |
-    //   \  |  |
-    //     \|  -
-    // This computes the width or height, depending on the which theta we use
-    // We only have horizontal FOV, but the FOV shouldn't be varying between zooms
-    //
-    // Ultimately, We want TD to remain the same as we move from x to x' and we care about theta prime
-    // 2(tan(0) * x) = 2(tan(0') * x')
-    // tan(0) * x = tan(0') * x'
-    // tan(0') = (tan(0) * x) / x'
-    // 0' = atan((tan(0) * x) / x')
-    //
-    // Finally, we can combine x / x' as a ratio between the distances
-    // 0' = atan(tan(0) * r)
+    if (!IsValid(Player) || !IsValid(Shot))
+    {
+        UE_LOG(LogExtendedCamera, Warning, TEXT("BakeShot needs a sequence player and a shot to bake into"));
+        return false;
+    }
 
-    const auto ReferenceTheta = FMath::DegreesToRadians(ReferenceFOV * 0.5f);
-    const auto DistanceRatio = ReferenceDistance / CurrentDistance;
-    return 2 * FMath::RadiansToDegrees(FMath::Atan(FMath::Tan(ReferenceTheta) * DistanceRatio));
-}
+    const float Rate = FMath::Max(SampleRate, 1.f);
+    const double Start = Player->GetStartTime().AsSeconds();
+    const double Duration = Player->GetDuration().AsSeconds();
+    const int32 NumKeys = FMath::FloorToInt(Duration * Rate) + 1;
 
-void UExtendedCameraComponent::GetCameraView(float DeltaTime, FMinimalViewInfo &DesiredView)
-{
-    // Start a counter here so it captures the super call
-    DECLARE_SCOPE_CYCLE_COUNTER(TEXT("GetCameraView (Including Super::)"), STAT_ACIGetCameraViewInc,
-                                STATGROUP_ACIExtCam);
+    // Bake what the camera does live, not what it's playing back
+    const auto PlayingShot = BakedShot;
+    BakedShot = nullptr;
+    BakingShot = true;
 
-    // Parent Call
-    Super::GetCameraView(DeltaTime, DesiredView);
+    // Baking runs the camera through the whole shot. Everything it moves is put back afterwards
+    const double PlayerTime = Player->GetCurrentTime().AsSeconds();
+    FExtendedCameraRecordedState State;
+    CaptureRecordingState(State);
+    const float SavedAccumulator = FixedTimestepAccumulator;
+    const auto SavedPreviousSimView = PreviousSimView;
+    const auto SavedCurrentSimView = CurrentSimView;
+    const bool SavedHasSimView = HasSimView;
 
-    // Start a second counter that excludes the parent view update
-    DECLARE_SCOPE_CYCLE_COUNTER(TEXT("GetCameraView (Excluding Super::)"), STAT_ACIGetCameraViewExc,
-                                STATGROUP_ACIExtCam);
+    // Nor is any of it part of a recording in progress
+    auto PausedRecorder = MoveTemp(Recorder);
 
-    // Get Owner
-    const auto ComponentOwner = GetOwner();
+    Shot->Reset(Rate, GetBindingsSignature());
+
+    for (int32 Key = 0; Key < NumKeys; ++Key)
+    {
+        Player->SetPlaybackPosition(
+            FMovieSceneSequencePlaybackParams(float(Start + Key / Rate), EUpdatePositionMethod::Jump));
+
+        // Sequencer only sets the animation. Nothing ticks between keys, so pose it now
+        RefreshTrackedPoses();
+
+        // Every key is a full evaluation, even when several land in one engine frame
+        TrackedFrameNumber = MAX_uint64;
+        BatchedFrameNumber = MAX_uint64;
+        BatchedLOSFrameNumber = MAX_uint64;
+        VisibilityRaysFrameNumber = MAX_uint64;
+        for (auto &Probe : VisibilityProbes)
+        {
+            Probe.BatchedFrameNumber = MAX_uint64;
+        }
+
+        FMinimalViewInfo View;
+        GetCameraView(Key == 0 ? 0.f : 1.f / Rate, View);
+        Shot->AddKey(View);
+    }
+
+    Player->SetPlaybackPosition(FMovieSceneSequencePlaybackParams(float(PlayerTime), EUpdatePositionMethod::Jump));
+    RefreshTrackedPoses();
 
-    // Initialise the Offset
-    float OffsetTrackFOV = IsLOSBlocked ? StoredLOSFOV : DesiredView.FOV;
+    Recorder = MoveTemp(PausedRecorder);
+    RestoreRecordingState(State);
+    FixedTimestepAccumulator = SavedAccumulator;
+    PreviousSimView = SavedPreviousSimView;
+    CurrentSimView = SavedCurrentSimView;
+    HasSimView = SavedHasSimView;
 
-    TrackingHandler(ComponentOwner, DesiredView, DeltaTime);
+    // Traced against the shot, not where the camera is now
+    LOSCache.Reset();
+    HasLastLOSHit = false;
+
+    BakedShot = PlayingShot;
+    BakingShot = false;
+    Shot->Compress();
+    Shot->MarkPackageDirty();
+    return true;
+}
 
-    // Blending
-    // Set OffsetTrack for the primary blend if it's non-zero
-    if (!FMath::IsNearlyZero(PrimaryTrackFOV))
+void UExtendedCameraComponent::RefreshTrackedPoses()
+{
+    TArray<AActor *, TInlineAllocator<8>> Actors;
+    Actors.AddUnique(GetOwner());
+    for (const auto &Track : CameraTracks)
     {
-        OffsetTrackFOV = bUseAdditiveOffset ? (PrimaryTrackFOV + AdditiveFOVOffset) : PrimaryTrackFOV;
+        Actors.AddUnique(Track.Locator);
+        Actors.AddUnique(Track.Aim);
     }
 
-    // Check for the primary track
-    if (!FMath::IsNearlyZero(CameraPrimaryTrackBlendAlpha))
+    for (auto Actor : Actors)
     {
-        // DollyZoom
-        if (FirstTrackDollyZoomEnabled)
+        if (!IsValid(Actor))
         {
-            if (FirstTrackDollyZoomDistanceLiveUpdate)
-            {
-                FirstTrackDollyZoomReferenceDistance =
-                    FVector::Dist(ComponentOwner->GetActorLocation(), PrimaryTrackTransform.GetLocation());
-            }
-
-            OffsetTrackFOV =
-                DollyZoom(FirstTrackDollyZoomReferenceDistance, SecondaryTrackFOV,
-                          FVector::Dist(ComponentOwner->GetActorLocation(), PrimaryTrackTransform.GetLocation()));
+            continue;
         }
 
-        if (GetUsePrimaryTrack())
+        TInlineComponentArray<USkeletalMeshComponent *> Meshes(Actor);
+        for (auto Mesh : Meshes)
         {
-            DesiredView.Location = PrimaryTrackTransform.GetLocation();
-            DesiredView.Rotation = PrimaryTrackTransform.GetRotation().Rotator();
-            DesiredView.FOV = OffsetTrackFOV;
-        }
-        else
-        {
-            DesiredView.Location =
-                FMath::Lerp(DesiredView.Location, PrimaryTrackTransform.GetLocation(), CameraPrimaryTrackBlendAlpha);
-            DesiredView.Rotation = FMath::Lerp(DesiredView.Rotation, PrimaryTrackTransform.GetRotation().Rotator(),
-                                               CameraPrimaryTrackBlendAlpha);
-            DesiredView.FOV = FMath::Lerp(DesiredView.FOV, OffsetTrackFOV, CameraPrimaryTrackBlendAlpha);
+            Mesh->TickAnimation(0.f, false);
+            Mesh->RefreshBoneTransforms();
+            Mesh->FinalizeBoneTransform();
         }
     }
+}
 
-    // Set OffsetTrack for the second if it's non-zero
-    if (!FMath::IsNearlyZero(SecondaryTrackFOV))
-    {
-        OffsetTrackFOV = bUseAdditiveOffset ? (SecondaryTrackFOV + AdditiveFOVOffset) : SecondaryTrackFOV;
-    }
-    else
+void UExtendedCameraComponent::SetBakedShot(UExtendedCameraBakedShot *Shot)
+{
+    BakedShot = Shot;
+    MarkViewDirty();
+}
+
+bool UExtendedCameraComponent::HasPlayableBakedShot()
+{
+    if (!BakedShot)
     {
-        // Initialise the Offset, again
-        OffsetTrackFOV = DesiredView.FOV;
+        return false;
     }
 
-    // Are we fully blended to the either game or primary track
-    if (!FMath::IsNearlyZero(CameraSecondaryTrackBlendAlpha))
+    // The names are only hashed again when something was rebound
+    const auto Key = GetBindingsKey();
+    if (Key != BakedShotBindingsKey)
     {
-        // DollyZoom
-        if (SecondTrackDollyZoomEnabled)
-        {
-            if (SecondTrackDollyZoomDistanceLiveUpdate)
-            {
-                SecondTrackDollyZoomReferenceDistance =
-                    FVector::Dist(ComponentOwner->GetActorLocation(), SecondaryTrackTransform.GetLocation());
-            }
-
-            OffsetTrackFOV =
-                DollyZoom(SecondTrackDollyZoomReferenceDistance, SecondaryTrackFOV,
-                          FVector::Dist(ComponentOwner->GetActorLocation(), SecondaryTrackTransform.GetLocation()));
-        }
+        BakedShotBindingsKey = Key;
+        BakedShotBindingsMatch = GetBindingsSignature() == BakedShot->GetBindingsSignature();
 
-        // Are we fully blended to the secondary track
-        if (GetUseSecondaryTrack())
-        {
-            DesiredView.Location = SecondaryTrackTransform.GetLocation();
-            DesiredView.Rotation = SecondaryTrackTransform.GetRotation().Rotator();
-            DesiredView.FOV = OffsetTrackFOV;
-        }
-
-        // We need to blend!
-        else
+        if (!BakedShotBindingsMatch)
         {
-            DesiredView.Location = FMath::Lerp(DesiredView.Location, SecondaryTrackTransform.GetLocation(),
-                                               CameraSecondaryTrackBlendAlpha);
-            DesiredView.Rotation = FMath::Lerp(DesiredView.Rotation, SecondaryTrackTransform.GetRotation().Rotator(),
-                                               CameraSecondaryTrackBlendAlpha);
-            DesiredView.FOV = FMath::Lerp(DesiredView.FOV, OffsetTrackFOV, CameraSecondaryTrackBlendAlpha);
+            UE_LOG(LogExtendedCamera, Warning, TEXT("%s no longer has the bindings %s was baked with. Evaluating live"),
+                   *GetPathName(), *BakedShot->GetName());
         }
     }
 
-    // Now LOS
-    LineOfCheckHandler(ComponentOwner, DesiredView);
-
-    // Do SmoothReturn first, otherwise we can push the camera back out of bounds
-    SmoothReturn(ComponentOwner, DesiredView, DeltaTime);
+    return BakedShotBindingsMatch && BakedShot->GetNumKeys() > 0;
 }
 
-void UExtendedCameraComponent::BeginPlay()
+uint32 UExtendedCameraComponent::GetBindingsKey() const
 {
-    Super::BeginPlay();
+    uint32 Key = HashCombine(GetTypeHash(BakedShot), GetTypeHash(CameraTracks.Num()));
+    Key = HashCombine(Key, GetTypeHash(uint8(CameraLOSMode)));
+    Key = HashCombine(Key, GetTypeHash(uint8(RotationBlend)));
 
-    // Set up our temporary variables here
-    PrimaryTrackPastFrameLookAt = PrimaryTrackTransform.Rotator();
-    SecondaryTrackPastFrameLookAt = SecondaryTrackTransform.Rotator();
-}
+    for (const auto &Track : CameraTracks)
+    {
+        Key = HashCombine(Key, GetTypeHash(uint8(Track.DriverMode)));
+        Key = HashCombine(Key, GetTypeHash(Track.TrackedCamera));
+        Key = HashCombine(Key, GetTypeHash(Track.Locator));
+        Key = HashCombine(Key, GetTypeHash(Track.Aim));
+        Key = HashCombine(Key, GetTypeHash(Track.LocatorBoneName));
+        Key = HashCombine(Key, GetTypeHash(Track.AimBoneName));
+        Key = HashCombine(Key, GetTypeHash(Track.AimOffset));
+    }
 
-void UExtendedCameraComponent::SetCameraPrimaryTrack(FVector &&InLocation, FRotator &&InRotation, float InFOV)
-{
-    PrimaryTrackTransform.SetLocation(MoveTemp(InLocation));
-    PrimaryTrackTransform.SetRotation(MoveTemp(InRotation).Quaternion());
-    PrimaryTrackFOV = InFOV;
+    return Key;
 }
 
-void UExtendedCameraComponent::SetCameraSecondaryTrack(FVector &&InLocation, FRotator &&InRotation, float InFOV)
+uint32 UExtendedCameraComponent::GetBindingsSignature() const
 {
-    SecondaryTrackTransform.SetLocation(MoveTemp(InLocation));
-    SecondaryTrackTransform.SetRotation(MoveTemp(InRotation).Quaternion());
-    SecondaryTrackFOV = InFOV;
-}
+    // Pointers and FName hashes only hold for one session. Sequencer names each spawnable's actor afresh every time
+    // it's spawned, so those are known by their binding instead
+    const auto NameOf = [](UObject *Object) {
+        if (!Object)
+        {
+            return 0u;
+        }
 
-void UExtendedCameraComponent::SetCameraPrimaryLocationRotation(FVector &&InLocation, FRotator &&InRotation)
-{
-    PrimaryTrackTransform.SetLocation(MoveTemp(InLocation));
-    PrimaryTrackTransform.SetRotation(MoveTemp(InRotation).Quaternion());
+        const auto Spawnable = FMovieSceneSpawnableAnnotation::Find(Object);
+        return Spawnable ? GetTypeHash(Spawnable->ObjectBindingID) : FCrc::StrCrc32(*Object->GetName());
+    };
+
+    uint32 Signature = HashCombine(uint32(CameraTracks.Num()), uint32(CameraLOSMode));
+    Signature = HashCombine(Signature, uint32(RotationBlend));
+
+    for (const auto &Track : CameraTracks)
+    {
+        Signature = HashCombine(Signature, uint32(Track.DriverMode));
+        Signature = HashCombine(Signature, NameOf(Track.TrackedCamera));
+        Signature = HashCombine(Signature, NameOf(Track.Locator));
+        Signature = HashCombine(Signature, NameOf(Track.Aim));
+        Signature = HashCombine(Signature, FCrc::StrCrc32(*Track.LocatorBoneName.ToString()));
+        Signature = HashCombine(Signature, FCrc::StrCrc32(*Track.AimBoneName.ToString()));
+        Signature = FCrc::MemCrc32(&Track.AimOffset, sizeof(Track.AimOffset), Signature);
+    }
+
+    return Signature;
 }
 
-void UExtendedCameraComponent::SetCameraSecondaryLocationRotation(FVector &&InLocation, FRotator &&InRotation)
+void UExtendedCameraComponent::SetUseSignificance(bool NewState)
 {
-    SecondaryTrackTransform.SetLocation(MoveTemp(InLocation));
-    SecondaryTrackTransform.SetRotation(MoveTemp(InRotation).Quaternion());
+    UseSignificance = NewState;
+
+    if (CameraSubsystem)
+    {
+        if (NewState)
+        {
+            CameraSubsystem->RegisterSignificance(this);
+        }
+        else
+        {
+            CameraSubsystem->UnregisterSignificance(this);
+        }
+    }
+
+    if (!NewState)
+    {
+        SetSignificanceTier(EExtendedCameraSignificance::SignificanceFull, FExtendedCameraSignificanceTier());
+    }
 }
 
-void UExtendedCameraComponent::SetCameraPrimaryRotation(FRotator &&InRotation)
+EExtendedCameraSignificance UExtendedCameraComponent::GetSignificanceTier() const
 {
-    PrimaryTrackTransform.SetRotation(MoveTemp(InRotation).Quaternion());
+    return SignificanceTier;
 }
 
-void UExtendedCameraComponent::SetCameraSecondaryRotation(FRotator &&InRotation)
+void UExtendedCameraComponent::SetSignificanceTier(EExtendedCameraSignificance Tier,
+                                                   const FExtendedCameraSignificanceTier &Settings)
 {
-    SecondaryTrackTransform.SetRotation(MoveTemp(InRotation).Quaternion());
+    SignificanceTier = Tier;
+    SignificanceSettings = Settings;
+    SignificanceSettings.TrackingInterval = FMath::Max(Settings.TrackingInterval, 1);
 }
 
-void UExtendedCameraComponent::SetCameraPrimaryLocation(FVector &&InLocation)
+const FExtendedCameraSignificanceTier &UExtendedCameraComponent::GetActiveSignificance() const
 {
-    PrimaryTrackTransform.SetLocation(MoveTemp(InLocation));
+    static const FExtendedCameraSignificanceTier FullSignificance;
+
+    // A recording or a bake has to see every frame the way it ran
+    return UseSignificance && !Recorder && !ReplayedFrame && !BakingShot ? SignificanceSettings : FullSignificance;
 }
 
-void UExtendedCameraComponent::SetCameraSecondaryLocation(FVector &&InLocation)
+bool UExtendedCameraComponent::IsSignificantFrame() const
 {
-    SecondaryTrackTransform.SetLocation(MoveTemp(InLocation));
+    const uint32 Interval = uint32(GetActiveSignificance().TrackingInterval);
+    return Interval <= 1 || (uint32(GFrameCounter) + SignificancePhase) % Interval == 0;
 }
 
-bool UExtendedCameraComponent::SetPrimaryLocatorBoneName(FName TrackedBoneName)
+bool UExtendedCameraComponent::TracesLineOfSightThisFrame() const
 {
-    PrimaryLocatorBoneName = TrackedBoneName;
-
-    if (FirstTrackCameraDriverMode == EExtendedCameraDriverMode::SkeletonLocator ||
-        FirstTrackCameraDriverMode == EExtendedCameraDriverMode::Skeleton)
+    const auto LineOfSight = GetActiveSignificance().LineOfSight;
+    if (LineOfSight == EExtendedCameraSignificanceLOS::SkipLineOfSight)
     {
-        return BoneCheck(PrimaryTrackLocator, TrackedBoneName);
+        return false;
     }
 
-    return false;
+    // Reused results are retraced on tracked frames, or when there's nothing to reuse yet
+    return LineOfSight != EExtendedCameraSignificanceLOS::ReuseLineOfSight || !HasLastLOSHit ||
+           IsSignificantFrame();
 }
 
-bool UExtendedCameraComponent::SetSecondaryLocatorBoneName(FName TrackedBoneName)
+float UExtendedCameraComponent::GetSignificanceDeltaTime(float DeltaTime) const
 {
-    SecondaryLocatorBoneName = TrackedBoneName;
+    return DeltaTime * GetActiveSignificance().TrackingInterval;
+}
 
-    if (SecondTrackCameraDriverMode == EExtendedCameraDriverMode::SkeletonLocator ||
-        SecondTrackCameraDriverMode == EExtendedCameraDriverMode::Skeleton)
+void UExtendedCameraComponent::ReuseLineOfSight(AActor *Owner, FMinimalViewInfo &DesiredView)
+{
+    // A trace held back before the camera's first has nothing to stand in for it
+    if (!Owner || !HasLastLOSHit)
     {
-        return BoneCheck(SecondaryTrackLocator, TrackedBoneName);
+        return;
     }
 
-    return false;
+    const auto Aim = EXTCAM_CALL(GetAimLocation, Owner);
+
+    FHitResult LOSCheck = LastLOSHit;
+    PlaceHitOnSegment(LOSCheck, Aim, DesiredView.Location);
+    INC_DWORD_STAT(STAT_ACIReusedLOS);
+
+    ApplyLineOfSightHit(Owner, DesiredView, LOSCheck);
 }
 
-bool UExtendedCameraComponent::SetPrimaryLocatorAimName(FName TrackedAimName)
+bool UExtendedCameraComponent::IsLineOfSightScheduled() const
 {
-    PrimaryAimBoneName = TrackedAimName;
+    // Without a budget everything runs when it's asked for
+    return BakingShot || !CameraSubsystem || !CameraSubsystem->IsScheduling() ||
+           LineOfSightScheduledFrame == GFrameCounter;
+}
 
-    if (FirstTrackCameraDriverMode == EExtendedCameraDriverMode::SkeletonAim ||
-        FirstTrackCameraDriverMode == EExtendedCameraDriverMode::Skeleton
-        )
-    {
-        return BoneCheck(PrimaryTrackAim, TrackedAimName);
-    }
+bool UExtendedCameraComponent::IsBoneResolutionScheduled() const
+{
+    return BakingShot || !CameraSubsystem || !CameraSubsystem->IsScheduling() ||
+           BoneResolutionScheduledFrame == GFrameCounter;
+}
 
-    return false;
+bool UExtendedCameraComponent::NeedsBoneResolution() const
+{
+    return CameraTracks.ContainsByPredicate([](const FExtendedCameraTrack &Track) { return NeedsBoneLookup(Track); });
 }
 
-bool UExtendedCameraComponent::SetSecondaryLocatorAimName(FName TrackedAimName)
+void UExtendedCameraComponent::MarkViewDirty()
 {
-    SecondaryAimBoneName = TrackedAimName;
+    ViewSnapshot.IsValid = false;
+}
 
-    if (SecondTrackCameraDriverMode == EExtendedCameraDriverMode::SkeletonAim ||
-        SecondTrackCameraDriverMode == EExtendedCameraDriverMode::Skeleton)
-    {
-        return BoneCheck(SecondaryTrackAim, TrackedAimName);
-    }
+void UExtendedCameraComponent::SetUseParallelTracking(bool NewState)
+{
+    UseParallelTracking = NewState;
+    MarkViewDirty();
+}
 
-    return false;
+void UExtendedCameraComponent::SetUseBatchedLineOfSight(bool NewState)
+{
+    UseBatchedLineOfSight = NewState;
+    MarkViewDirty();
 }
 
-void UExtendedCameraComponent::SetFOVCheckOffsetInRadians(float FOVOffset)
+void UExtendedCameraComponent::SetUseLineOfSightCache(bool NewState)
 {
-    FOVCheckOffsetInRadians = FOVOffset;
+    UseLineOfSightCache = NewState;
+    LOSCache.Reset();
+    MarkViewDirty();
 }
 
-void UExtendedCameraComponent::SetUseDollyZoom(bool NewState)
+void UExtendedCameraComponent::SetLineOfSightCacheTolerances(float PositionTolerance, float RotationTolerance,
+                                                             int32 MaxAge)
 {
-    UseDollyZoomForLOS = NewState;
+    LineOfSightCachePositionTolerance = FMath::Max(PositionTolerance, 0.f);
+    LineOfSightCacheRotationTolerance = FMath::Max(RotationTolerance, 0.f);
+    LineOfSightCacheMaxAge = FMath::Max(MaxAge, 0);
+    MarkViewDirty();
 }
 
 void UExtendedCameraComponent::SetSmoothReturn(bool NewState)
 {
     SmoothReturnOnLineOfSight = NewState;
+    MarkViewDirty();
 }
 
 void UExtendedCameraComponent::SetSmoothReturnSpeed(float NewReturnSpeed)
 {
     SmoothReturnSpeed = NewReturnSpeed;
+    MarkViewDirty();
+}
+
+void UExtendedCameraComponent::SetSmoothReturnTime(float NewReturnTime)
+{
+    SmoothReturnTime = FMath::Max(NewReturnTime, 0.f);
+    MarkViewDirty();
 }
 
 void UExtendedCameraComponent::SetSmoothReturnDeadzone(float NewDeadzone)
@@ -939,25 +2917,28 @@ void UExtendedCameraComponent::SetSmoothReturnDeadzone(float NewDeadzone)
 
 void UExtendedCameraComponent::SetPrimaryTrackMode(EExtendedCameraDriverMode NewMode)
 {
-    FirstTrackCameraDriverMode = NewMode;
+    auto &Track = GetNamedTrack(PrimaryTrackIndex);
+    Track.DriverMode = NewMode;
+    SelectTrackEvaluator(Track);
 }
 
 void UExtendedCameraComponent::SetSecondaryTrackMode(EExtendedCameraDriverMode NewMode)
 {
-    SecondTrackCameraDriverMode = NewMode;
+    auto &Track = GetNamedTrack(SecondaryTrackIndex);
+    Track.DriverMode = NewMode;
+    SelectTrackEvaluator(Track);
 }
 
 void UExtendedCameraComponent::SetPrimaryTrackAimDebug(bool Enabled)
 {
 #if ENABLE_DRAW_DEBUG
-    PrimaryTrackAimDebug = Enabled;
+    GetNamedTrack(PrimaryTrackIndex).AimDebug = Enabled;
 #endif // ENABLE_DRAW_DEBUG
 }
 
 void UExtendedCameraComponent::SetSecondaryTrackAimDebug(bool Enabled)
 {
 #if ENABLE_DRAW_DEBUG
-    SecondaryTrackAimDebug = Enabled;
+    GetNamedTrack(SecondaryTrackIndex).AimDebug = Enabled;
 #endif // ENABLE_DRAW_DEBUG
 }
-
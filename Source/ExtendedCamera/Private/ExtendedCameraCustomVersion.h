@@ -0,0 +1,31 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Guid.h"
+
+// Custom serialization version for the extended camera
+struct FExtendedCameraCustomVersion
+{
+    enum Type
+    {
+        // Before any version changes were made in the plugin
+        BeforeCustomVersionWasAdded = 0,
+
+        // Primary and Secondary track properties moved into CameraTracks
+        TracksAsArray,
+
+        // -----<new versions can be added above this line>-------------------------------------------------
+        VersionPlusOne,
+        LatestVersion = VersionPlusOne - 1
+    };
+
+    // The GUID for this custom version number
+    const static FGuid GUID;
+
+private:
+    FExtendedCameraCustomVersion()
+    {
+    }
+};
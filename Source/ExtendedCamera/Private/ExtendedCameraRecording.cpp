@@ -0,0 +1,682 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#include "ExtendedCameraRecording.h"
+#include "ExtendedCameraComponent.h"
+#include "HAL/FileManager.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogExtendedCameraRecording, Warning, All);
+
+namespace ExtendedCameraRecording
+{
+// Sanity limit on tracks, so a damaged count can't allocate the world
+constexpr uint32 MaxTracks = 256;
+
+// Which of a frame's groups follow. The LOS flags are values rather than changes
+enum EFrameBits : uint16
+{
+    DeltaTimeBit = 1 << 0,
+    BaseLocationBit = 1 << 1,
+    BaseRotationBit = 1 << 2,
+    BaseFOVBit = 1 << 3,
+    OwnerLocationBit = 1 << 4,
+    OwnerRotationBit = 1 << 5,
+    TrackCountBit = 1 << 6,
+    HasLineOfSightBit = 1 << 7,
+    LineOfSightBlockedBit = 1 << 8,
+    LineOfSightLocationBit = 1 << 9,
+    LineOfSightNormalBit = 1 << 10,
+};
+
+// Which of a track's groups follow. The locator and aim flags are values rather than changes
+enum ETrackBits : uint8
+{
+    HasLocatorBit = 1 << 0,
+    HasAimBit = 1 << 1,
+    AlphaBit = 1 << 2,
+    FOVBit = 1 << 3,
+    TransformLocationBit = 1 << 4,
+    TransformRotationBit = 1 << 5,
+    LocatorBit = 1 << 6,
+    AimBit = 1 << 7,
+};
+
+///// ///// ////////// ///// /////
+// Bits
+//
+
+// Values are compared and stored as their bits, so a replay sees exactly what was recorded
+inline uint32 ToBits(float Value)
+{
+    uint32 Bits;
+    FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+    return Bits;
+}
+
+inline uint64 ToBits(double Value)
+{
+    uint64 Bits;
+    FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+    return Bits;
+}
+
+template <typename T, typename BitsType> T FromBits(BitsType Bits)
+{
+    static_assert(sizeof(T) == sizeof(BitsType), "Bits must be the size of the value");
+    T Value;
+    FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+    return Value;
+}
+
+/**
+ * Write Bits
+ *
+ * Writes which bits changed as a header byte and the bytes between the lowest
+ * and highest that changed. The header's low nibble is the first byte, the
+ * high nibble how many follow. Unchanged is a zero header and nothing else
+ */
+template <typename BitsType> void WriteBits(FArchive &Ar, BitsType Previous, BitsType Current)
+{
+    const BitsType Changed = Previous ^ Current;
+
+    int32 First = 0;
+    int32 Count = 0;
+    if (Changed != 0)
+    {
+        int32 Last = sizeof(BitsType) - 1;
+        while (((Changed >> (First * 8)) & 0xFF) == 0)
+        {
+            ++First;
+        }
+        while (((Changed >> (Last * 8)) & 0xFF) == 0)
+        {
+            --Last;
+        }
+        Count = Last - First + 1;
+    }
+
+    uint8 Header = uint8((Count << 4) | First);
+    Ar << Header;
+
+    for (int32 Byte = First; Byte < First + Count; ++Byte)
+    {
+        uint8 Value = uint8(Changed >> (Byte * 8));
+        Ar << Value;
+    }
+}
+
+// Apply the changed bits to Value. False if the header can't be from WriteBits
+template <typename BitsType> bool ReadBits(FArchive &Ar, BitsType &Value)
+{
+    uint8 Header = 0;
+    Ar << Header;
+
+    const int32 First = Header & 0xF;
+    const int32 Count = Header >> 4;
+    if (First + Count > int32(sizeof(BitsType)))
+    {
+        return false;
+    }
+
+    BitsType Changed = 0;
+    for (int32 Byte = First; Byte < First + Count; ++Byte)
+    {
+        uint8 Bits = 0;
+        Ar << Bits;
+        Changed |= BitsType(Bits) << (Byte * 8);
+    }
+
+    Value ^= Changed;
+    return !Ar.IsError();
+}
+
+///// ///// ////////// ///// /////
+// Values
+//
+// Writes bring Previous up to date, so it stays what the reader will have
+//
+
+inline bool Differs(float A, float B)
+{
+    return ToBits(A) != ToBits(B);
+}
+
+inline bool Differs(double A, double B)
+{
+    return ToBits(A) != ToBits(B);
+}
+
+inline bool Differs(const FVector &A, const FVector &B)
+{
+    return Differs(A.X, B.X) || Differs(A.Y, B.Y) || Differs(A.Z, B.Z);
+}
+
+inline bool Differs(const FRotator &A, const FRotator &B)
+{
+    return Differs(A.Pitch, B.Pitch) || Differs(A.Yaw, B.Yaw) || Differs(A.Roll, B.Roll);
+}
+
+inline bool Differs(const FQuat &A, const FQuat &B)
+{
+    return Differs(A.X, B.X) || Differs(A.Y, B.Y) || Differs(A.Z, B.Z) || Differs(A.W, B.W);
+}
+
+template <typename T> void WriteDelta(FArchive &Ar, T &Previous, T Current)
+{
+    WriteBits(Ar, ToBits(Previous), ToBits(Current));
+    Previous = Current;
+}
+
+template <typename T> bool ReadDelta(FArchive &Ar, T &Value)
+{
+    auto Bits = ToBits(Value);
+    const bool Success = ReadBits(Ar, Bits);
+    Value = FromBits<T>(Bits);
+    return Success;
+}
+
+inline void WriteDelta(FArchive &Ar, FVector &Previous, const FVector &Current)
+{
+    WriteDelta(Ar, Previous.X, Current.X);
+    WriteDelta(Ar, Previous.Y, Current.Y);
+    WriteDelta(Ar, Previous.Z, Current.Z);
+}
+
+inline bool ReadDelta(FArchive &Ar, FVector &Value)
+{
+    return ReadDelta(Ar, Value.X) && ReadDelta(Ar, Value.Y) && ReadDelta(Ar, Value.Z);
+}
+
+inline void WriteDelta(FArchive &Ar, FRotator &Previous, const FRotator &Current)
+{
+    WriteDelta(Ar, Previous.Pitch, Current.Pitch);
+    WriteDelta(Ar, Previous.Yaw, Current.Yaw);
+    WriteDelta(Ar, Previous.Roll, Current.Roll);
+}
+
+inline bool ReadDelta(FArchive &Ar, FRotator &Value)
+{
+    return ReadDelta(Ar, Value.Pitch) && ReadDelta(Ar, Value.Yaw) && ReadDelta(Ar, Value.Roll);
+}
+
+inline void WriteDelta(FArchive &Ar, FQuat &Previous, const FQuat &Current)
+{
+    WriteDelta(Ar, Previous.X, Current.X);
+    WriteDelta(Ar, Previous.Y, Current.Y);
+    WriteDelta(Ar, Previous.Z, Current.Z);
+    WriteDelta(Ar, Previous.W, Current.W);
+}
+
+inline bool ReadDelta(FArchive &Ar, FQuat &Value)
+{
+    return ReadDelta(Ar, Value.X) && ReadDelta(Ar, Value.Y) && ReadDelta(Ar, Value.Z) && ReadDelta(Ar, Value.W);
+}
+
+// Transforms are kept as a location and a rotation. Cameras don't scale
+inline bool DiffersInLocation(const FTransform &A, const FTransform &B)
+{
+    return Differs(A.GetLocation(), B.GetLocation());
+}
+
+inline bool DiffersInRotation(const FTransform &A, const FTransform &B)
+{
+    return Differs(A.GetRotation(), B.GetRotation());
+}
+
+inline void WriteLocationDelta(FArchive &Ar, FTransform &Previous, const FTransform &Current)
+{
+    auto Location = Previous.GetLocation();
+    WriteDelta(Ar, Location, Current.GetLocation());
+    Previous.SetLocation(Location);
+}
+
+inline bool ReadLocationDelta(FArchive &Ar, FTransform &Value)
+{
+    auto Location = Value.GetLocation();
+    const bool Success = ReadDelta(Ar, Location);
+    Value.SetLocation(Location);
+    return Success;
+}
+
+inline void WriteRotationDelta(FArchive &Ar, FTransform &Previous, const FTransform &Current)
+{
+    auto Rotation = Previous.GetRotation();
+    WriteDelta(Ar, Rotation, Current.GetRotation());
+    Previous.SetRotation(Rotation);
+}
+
+inline bool ReadRotationDelta(FArchive &Ar, FTransform &Value)
+{
+    auto Rotation = Value.GetRotation();
+    const bool Success = ReadDelta(Ar, Rotation);
+    Value.SetRotation(Rotation);
+    return Success;
+}
+} // namespace ExtendedCameraRecording
+
+FArchive &operator<<(FArchive &Ar, FExtendedCameraRecordedState &State)
+{
+    int32 NumTracks = State.Tracks.Num();
+    Ar << NumTracks;
+
+    if (Ar.IsLoading())
+    {
+        if (NumTracks < 0 || uint32(NumTracks) > ExtendedCameraRecording::MaxTracks)
+        {
+            Ar.SetError();
+            return Ar;
+        }
+        State.Tracks.SetNum(NumTracks);
+    }
+
+    for (auto &Track : State.Tracks)
+    {
+        Ar << Track.PastFrameLookAt;
+        Ar << Track.PastFrameAimTarget;
+        Ar << Track.AimVelocity;
+        Ar << Track.DollyZoomReferenceDistance;
+    }
+
+    Ar << State.IsLOSBlocked;
+    Ar << State.StoredLOSFOV;
+    Ar << State.WasLineOfSightBlockedRecently;
+    Ar << State.StoredPreviousLocationForReturn;
+    Ar << State.SmoothReturnVelocity;
+    Ar << State.SmoothReturnTarget;
+    return Ar;
+}
+
+///// ///// ////////// ///// /////
+// Writer
+//
+
+FExtendedCameraRecordingWriter::~FExtendedCameraRecordingWriter()
+{
+    Close();
+}
+
+bool FExtendedCameraRecordingWriter::Open(const FString &Filename, const FExtendedCameraRecordedState &State)
+{
+    Close();
+
+    File.Reset(IFileManager::Get().CreateFileWriter(*Filename));
+    if (!File)
+    {
+        return false;
+    }
+
+    uint32 FileMagic = Magic;
+    uint32 FileVersion = Version;
+    auto FileState = State;
+    *File << FileMagic;
+    *File << FileVersion;
+    *File << FileState;
+
+    Pending.Reset();
+    Previous = FExtendedCameraRecordedFrame();
+    NumFrames = 0;
+    return !File->IsError();
+}
+
+void FExtendedCameraRecordingWriter::Close()
+{
+    if (File)
+    {
+        Flush();
+        File->Close();
+        File.Reset();
+    }
+}
+
+bool FExtendedCameraRecordingWriter::IsOpen() const
+{
+    return File.IsValid();
+}
+
+void FExtendedCameraRecordingWriter::WriteFrame(const FExtendedCameraRecordedFrame &Frame)
+{
+    using namespace ExtendedCameraRecording;
+
+    if (!File)
+    {
+        return;
+    }
+
+    auto &P = Previous;
+
+    uint16 Mask = 0;
+    Mask |= Differs(P.DeltaTime, Frame.DeltaTime) ? DeltaTimeBit : 0;
+    Mask |= Differs(P.BaseLocation, Frame.BaseLocation) ? BaseLocationBit : 0;
+    Mask |= Differs(P.BaseRotation, Frame.BaseRotation) ? BaseRotationBit : 0;
+    Mask |= Differs(P.BaseFOV, Frame.BaseFOV) ? BaseFOVBit : 0;
+    Mask |= Differs(P.OwnerLocation, Frame.OwnerLocation) ? OwnerLocationBit : 0;
+    Mask |= Differs(P.OwnerRotation, Frame.OwnerRotation) ? OwnerRotationBit : 0;
+    Mask |= P.Tracks.Num() != Frame.Tracks.Num() ? TrackCountBit : 0;
+
+    // Without a check the last hit is kept, so the next one only writes what moved since
+    if (Frame.HasLineOfSight)
+    {
+        Mask |= HasLineOfSightBit;
+        Mask |= Frame.LineOfSightBlocked ? LineOfSightBlockedBit : 0;
+        Mask |= Differs(P.LineOfSightLocation, Frame.LineOfSightLocation) ? LineOfSightLocationBit : 0;
+        Mask |= Differs(P.LineOfSightNormal, Frame.LineOfSightNormal) ? LineOfSightNormalBit : 0;
+    }
+
+    FMemoryWriter Ar(Pending, false, true);
+    Ar << Mask;
+
+    if (Mask & DeltaTimeBit)
+    {
+        WriteDelta(Ar, P.DeltaTime, Frame.DeltaTime);
+    }
+    if (Mask & BaseLocationBit)
+    {
+        WriteDelta(Ar, P.BaseLocation, Frame.BaseLocation);
+    }
+    if (Mask & BaseRotationBit)
+    {
+        WriteDelta(Ar, P.BaseRotation, Frame.BaseRotation);
+    }
+    if (Mask & BaseFOVBit)
+    {
+        WriteDelta(Ar, P.BaseFOV, Frame.BaseFOV);
+    }
+    if (Mask & OwnerLocationBit)
+    {
+        WriteDelta(Ar, P.OwnerLocation, Frame.OwnerLocation);
+    }
+    if (Mask & OwnerRotationBit)
+    {
+        WriteDelta(Ar, P.OwnerRotation, Frame.OwnerRotation);
+    }
+    if (Mask & TrackCountBit)
+    {
+        uint32 NumTracks = FMath::Min(uint32(Frame.Tracks.Num()), MaxTracks);
+        Ar.SerializeIntPacked(NumTracks);
+        P.Tracks.SetNum(NumTracks);
+    }
+
+    P.HasLineOfSight = Frame.HasLineOfSight;
+    if (Frame.HasLineOfSight)
+    {
+        P.LineOfSightBlocked = Frame.LineOfSightBlocked;
+        if (Mask & LineOfSightLocationBit)
+        {
+            WriteDelta(Ar, P.LineOfSightLocation, Frame.LineOfSightLocation);
+        }
+        if (Mask & LineOfSightNormalBit)
+        {
+            WriteDelta(Ar, P.LineOfSightNormal, Frame.LineOfSightNormal);
+        }
+    }
+
+    for (int32 Index = 0; Index < P.Tracks.Num(); ++Index)
+    {
+        const auto &Track = Frame.Tracks[Index];
+        auto &PT = P.Tracks[Index];
+
+        // Locator and aim driven transforms come back from tracking, so they aren't worth the bytes
+        const bool KeepTransform = !Track.HasLocator || !Track.HasAim;
+
+        uint8 TrackMask = 0;
+        TrackMask |= Track.HasLocator ? HasLocatorBit : 0;
+        TrackMask |= Track.HasAim ? HasAimBit : 0;
+        TrackMask |= Differs(PT.Alpha, Track.Alpha) ? AlphaBit : 0;
+        TrackMask |= Differs(PT.FOV, Track.FOV) ? FOVBit : 0;
+        TrackMask |= KeepTransform && DiffersInLocation(PT.Transform, Track.Transform) ? TransformLocationBit : 0;
+        TrackMask |= KeepTransform && DiffersInRotation(PT.Transform, Track.Transform) ? TransformRotationBit : 0;
+        TrackMask |= Track.HasLocator && Differs(PT.Locator, Track.Locator) ? LocatorBit : 0;
+        TrackMask |= Track.HasAim && (DiffersInLocation(PT.Aim, Track.Aim) || DiffersInRotation(PT.Aim, Track.Aim))
+                         ? AimBit
+                         : 0;
+        Ar << TrackMask;
+
+        PT.HasLocator = Track.HasLocator;
+        PT.HasAim = Track.HasAim;
+
+        if (TrackMask & AlphaBit)
+        {
+            WriteDelta(Ar, PT.Alpha, Track.Alpha);
+        }
+        if (TrackMask & FOVBit)
+        {
+            WriteDelta(Ar, PT.FOV, Track.FOV);
+        }
+        if (TrackMask & TransformLocationBit)
+        {
+            WriteLocationDelta(Ar, PT.Transform, Track.Transform);
+        }
+        if (TrackMask & TransformRotationBit)
+        {
+            WriteRotationDelta(Ar, PT.Transform, Track.Transform);
+        }
+        if (TrackMask & LocatorBit)
+        {
+            WriteDelta(Ar, PT.Locator, Track.Locator);
+        }
+        if (TrackMask & AimBit)
+        {
+            WriteLocationDelta(Ar, PT.Aim, Track.Aim);
+            WriteRotationDelta(Ar, PT.Aim, Track.Aim);
+        }
+    }
+
+    ++NumFrames;
+
+    if (Pending.Num() >= FlushSize)
+    {
+        Flush();
+    }
+}
+
+int32 FExtendedCameraRecordingWriter::GetNumFrames() const
+{
+    return NumFrames;
+}
+
+void FExtendedCameraRecordingWriter::Flush()
+{
+    if (File && Pending.Num() > 0)
+    {
+        File->Serialize(Pending.GetData(), Pending.Num());
+    }
+    Pending.Reset();
+}
+
+///// ///// ////////// ///// /////
+// Reader
+//
+
+bool FExtendedCameraRecordingReader::Open(const FString &Filename, FExtendedCameraRecordedState &OutState)
+{
+    Close();
+
+    File.Reset(IFileManager::Get().CreateFileReader(*Filename));
+    if (!File)
+    {
+        return false;
+    }
+
+    uint32 FileMagic = 0;
+    uint32 FileVersion = 0;
+    *File << FileMagic;
+    *File << FileVersion;
+
+    if (FileMagic != FExtendedCameraRecordingWriter::Magic || FileVersion != FExtendedCameraRecordingWriter::Version)
+    {
+        UE_LOG(LogExtendedCameraRecording, Warning, TEXT("%s is not a camera recording this version can read"),
+               *Filename);
+        Close();
+        return false;
+    }
+
+    *File << OutState;
+    if (File->IsError())
+    {
+        UE_LOG(LogExtendedCameraRecording, Warning, TEXT("%s has a damaged header"), *Filename);
+        Close();
+        return false;
+    }
+
+    Previous = FExtendedCameraRecordedFrame();
+    return true;
+}
+
+void FExtendedCameraRecordingReader::Close()
+{
+    if (File)
+    {
+        File->Close();
+        File.Reset();
+    }
+}
+
+bool FExtendedCameraRecordingReader::ReadFrame(FExtendedCameraRecordedFrame &OutFrame)
+{
+    using namespace ExtendedCameraRecording;
+
+    if (!File || File->AtEnd())
+    {
+        return false;
+    }
+
+    auto &Ar = *File;
+    auto &P = Previous;
+    bool Success = true;
+
+    uint16 Mask = 0;
+    Ar << Mask;
+
+    if (Mask & DeltaTimeBit)
+    {
+        Success &= ReadDelta(Ar, P.DeltaTime);
+    }
+    if (Mask & BaseLocationBit)
+    {
+        Success &= ReadDelta(Ar, P.BaseLocation);
+    }
+    if (Mask & BaseRotationBit)
+    {
+        Success &= ReadDelta(Ar, P.BaseRotation);
+    }
+    if (Mask & BaseFOVBit)
+    {
+        Success &= ReadDelta(Ar, P.BaseFOV);
+    }
+    if (Mask & OwnerLocationBit)
+    {
+        Success &= ReadDelta(Ar, P.OwnerLocation);
+    }
+    if (Mask & OwnerRotationBit)
+    {
+        Success &= ReadDelta(Ar, P.OwnerRotation);
+    }
+    if (Mask & TrackCountBit)
+    {
+        uint32 NumTracks = 0;
+        Ar.SerializeIntPacked(NumTracks);
+        if (NumTracks > MaxTracks)
+        {
+            Success = false;
+        }
+        else
+        {
+            P.Tracks.SetNum(NumTracks);
+        }
+    }
+
+    P.HasLineOfSight = (Mask & HasLineOfSightBit) != 0;
+    if (P.HasLineOfSight)
+    {
+        P.LineOfSightBlocked = (Mask & LineOfSightBlockedBit) != 0;
+        if (Mask & LineOfSightLocationBit)
+        {
+            Success &= ReadDelta(Ar, P.LineOfSightLocation);
+        }
+        if (Mask & LineOfSightNormalBit)
+        {
+            Success &= ReadDelta(Ar, P.LineOfSightNormal);
+        }
+    }
+
+    for (int32 Index = 0; Success && Index < P.Tracks.Num(); ++Index)
+    {
+        auto &PT = P.Tracks[Index];
+
+        uint8 TrackMask = 0;
+        Ar << TrackMask;
+
+        PT.HasLocator = (TrackMask & HasLocatorBit) != 0;
+        PT.HasAim = (TrackMask & HasAimBit) != 0;
+
+        if (TrackMask & AlphaBit)
+        {
+            Success &= ReadDelta(Ar, PT.Alpha);
+        }
+        if (TrackMask & FOVBit)
+        {
+            Success &= ReadDelta(Ar, PT.FOV);
+        }
+        if (TrackMask & TransformLocationBit)
+        {
+            Success &= ReadLocationDelta(Ar, PT.Transform);
+        }
+        if (TrackMask & TransformRotationBit)
+        {
+            Success &= ReadRotationDelta(Ar, PT.Transform);
+        }
+        if (TrackMask & LocatorBit)
+        {
+            Success &= ReadDelta(Ar, PT.Locator);
+        }
+        if (TrackMask & AimBit)
+        {
+            Success &= ReadLocationDelta(Ar, PT.Aim);
+            Success &= ReadRotationDelta(Ar, PT.Aim);
+        }
+    }
+
+    if (!Success || Ar.IsError())
+    {
+        UE_LOG(LogExtendedCameraRecording, Warning, TEXT("Camera recording is damaged, stopping"));
+        Close();
+        return false;
+    }
+
+    OutFrame = P;
+    return true;
+}
+
+///// ///// ////////// ///// /////
+// Player
+//
+
+bool FExtendedCameraRecordingPlayer::Open(const FString &Filename, UExtendedCameraComponent &Camera)
+{
+    FExtendedCameraRecordedState State;
+    if (!Reader.Open(Filename, State))
+    {
+        return false;
+    }
+
+    Camera.RestoreRecordingState(State);
+    FrameNumber = 0;
+    return true;
+}
+
+bool FExtendedCameraRecordingPlayer::Step(UExtendedCameraComponent &Camera, FMinimalViewInfo &OutView)
+{
+    if (!Reader.ReadFrame(Frame))
+    {
+        return false;
+    }
+
+    Camera.EvaluateRecordedFrame(Frame, OutView);
+    ++FrameNumber;
+    return true;
+}
+
+int32 FExtendedCameraRecordingPlayer::GetFrameNumber() const
+{
+    return FrameNumber;
+}
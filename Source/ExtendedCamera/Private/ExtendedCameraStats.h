@@ -0,0 +1,79 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExtendedCameraComponent.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+
+// Defined in ExtendedCamera.cpp. STATGROUP_ACIExtCam itself is declared in ExtendedCameraComponent.h
+
+CSV_DECLARE_CATEGORY_EXTERN(ExtendedCamera);
+
+///// ///// ////////// ///// /////
+// Pipeline stages
+//
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GetCameraView (Including Super::)"), STAT_ACIGetCameraViewInc, STATGROUP_ACIExtCam, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GetCameraView (Excluding Super::)"), STAT_ACIGetCameraViewExc, STATGROUP_ACIExtCam, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Aim Resolution"), STAT_ACIAimResolution, STATGROUP_ACIExtCam, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tracking"), STAT_ACITracking, STATGROUP_ACIExtCam, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Blend"), STAT_ACIBlend, STATGROUP_ACIExtCam, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Line of Sight"), STAT_ACILineOfSight, STATGROUP_ACIExtCam, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Dolly Zoom"), STAT_ACIDollyZoom, STATGROUP_ACIExtCam, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Smooth Return"), STAT_ACISmoothReturn, STATGROUP_ACIExtCam, );
+
+///// ///// ////////// ///// /////
+// Subsystem stages
+//
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parallel Tracking"), STAT_ACIParallelTracking, STATGROUP_ACIExtCam, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Serial Tracking"), STAT_ACISerialTracking, STATGROUP_ACIExtCam, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batch Gather"), STAT_ACIBatchGather, STATGROUP_ACIExtCam, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batch Evaluate"), STAT_ACIBatchEvaluate, STATGROUP_ACIExtCam, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batch Scatter"), STAT_ACIBatchScatter, STATGROUP_ACIExtCam, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batch Line of Sight"), STAT_ACIBatchLineOfSight, STATGROUP_ACIExtCam, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Significance"), STAT_ACISignificance, STATGROUP_ACIExtCam, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Schedule"), STAT_ACISchedule, STATGROUP_ACIExtCam, );
+
+///// ///// ////////// ///// /////
+// Counters
+//
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces Issued"), STAT_ACITraces, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("LOS Blocks"), STAT_ACILOSBlocks, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bone Lookups"), STAT_ACIBoneLookups, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bone Cache Hits"), STAT_ACIBoneCacheHits, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("LOS Cache Hits"), STAT_ACILOSCacheHits, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("LOS Cache Misses"), STAT_ACILOSCacheMisses, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Visibility Probe Rays"), STAT_ACIVisibilityRays, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Idle Camera Views"), STAT_ACIIdleViews, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Fixed Timesteps"), STAT_ACIFixedSteps, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Recorded Frames"), STAT_ACIRecordedFrames, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Baked Views"), STAT_ACIBakedViews, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Parallel Tracked Cameras"), STAT_ACIParallelTrackedCameras,
+                                  STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Serial Tracked Cameras"), STAT_ACISerialTrackedCameras, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Batched Cameras"), STAT_ACIBatchedCameras, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Batched LOS Traces"), STAT_ACIBatchedLOSTraces, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Throttled Cameras"), STAT_ACISignificanceThrottled, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Reused LOS Results"), STAT_ACIReusedLOS, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Significance Bias"), STAT_ACISignificanceBias, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Camera Time (us)"), STAT_ACICameraMicroseconds, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Scheduled Work"), STAT_ACIScheduledWork, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Overdue Work Forced"), STAT_ACIForcedWork, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deferred LOS Traces"), STAT_ACIDeferredLOS, STATGROUP_ACIExtCam, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deferred Bone Lookups"), STAT_ACIDeferredBoneLookups, STATGROUP_ACIExtCam, );
+
+/**
+ * Stage Scope
+ *
+ * Times one stage in the stat system, the CSV profiler and Insights at once.
+ * Stage is the stat name without the STAT_ACI prefix
+ */
+#define EXTCAM_STAGE_SCOPE(Stage)                                                                                      \
+    SCOPE_CYCLE_COUNTER(STAT_ACI##Stage);                                                                              \
+    CSV_SCOPED_TIMING_STAT(ExtendedCamera, Stage);                                                                     \
+    TRACE_CPUPROFILER_EVENT_SCOPE(ExtendedCamera_##Stage)
@@ -0,0 +1,853 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#include "ExtendedCameraSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/World.h"
+#include "ExtendedCameraComponent.h"
+#include "ExtendedCameraMath.h"
+#include "ExtendedCameraStats.h"
+#include "GameFramework/PlayerController.h"
+#include "SignificanceManager.h"
+
+// Registered with the significance manager under this tag
+static const FName SignificanceTag(TEXT("ExtendedCamera"));
+
+// Tiers are ranked as significances, Full highest
+static float SignificanceFromTier(int32 Tier)
+{
+    return float(EExtendedCameraSignificance::TOTAL_SIGNIFICANCE_TIERS - 1 - Tier);
+}
+
+static int32 TierFromSignificance(float Significance)
+{
+    const int32 Tier = EExtendedCameraSignificance::TOTAL_SIGNIFICANCE_TIERS - 1 - FMath::RoundToInt(Significance);
+    return FMath::Clamp(Tier, 0, int32(EExtendedCameraSignificance::SignificanceDormant));
+}
+
+// Pixels in the largest render target the camera's owner captures to. Zero if it isn't captured
+static int32 GetCapturePixels(const UExtendedCameraComponent &Camera)
+{
+    int32 Pixels = 0;
+    if (const auto Owner = Camera.GetOwner())
+    {
+        Owner->ForEachComponent<USceneCaptureComponent2D>(false, [&Pixels](const USceneCaptureComponent2D *Capture) {
+            const auto Target = Capture->TextureTarget;
+            if (Target && Capture->IsActive() && (Capture->bCaptureEveryFrame || Capture->bCaptureOnMovement))
+            {
+                Pixels = FMath::Max(Pixels, Target->SizeX * Target->SizeY);
+            }
+        });
+    }
+    return Pixels;
+}
+
+void FExtendedCameraBatch::Reset(int32 InNumCameras, int32 InNumLayers)
+{
+    NumCameras = InNumCameras;
+    NumLayers = InNumLayers;
+
+    const int32 NumTracks = NumCameras * NumLayers;
+
+    for (auto Array : {&OwnerX, &OwnerY, &OwnerZ, &ViewX, &ViewY, &ViewZ, &ViewQX, &ViewQY, &ViewQZ, &ViewQW})
+    {
+        Array->SetNumUninitialized(NumCameras, false);
+    }
+
+    RotationBlend.SetNumUninitialized(NumCameras, false);
+
+    for (auto Array : {&ViewPitch, &ViewYaw, &ViewRoll, &ViewFOV, &FallbackFOV})
+    {
+        Array->SetNumUninitialized(NumCameras, false);
+    }
+
+    // Cameras with fewer tracks than the deepest stack leave their upper layers at zero alpha
+    for (auto Array : {&TrackX, &TrackY, &TrackZ, &TrackQX, &TrackQY, &TrackQZ, &TrackQW})
+    {
+        Array->SetNumZeroed(NumTracks, false);
+    }
+
+    for (auto Array : {&TrackFOV, &TrackOffsetFOV, &TrackAlpha, &DollyReferenceDistance})
+    {
+        Array->SetNumZeroed(NumTracks, false);
+    }
+
+    DollyEnabled.SetNumZeroed(NumTracks, false);
+    DollyLiveUpdate.SetNumZeroed(NumTracks, false);
+}
+
+UExtendedCameraSubsystem::UExtendedCameraSubsystem()
+    : SignificanceBudget(1000.f)
+    , SignificanceBudgetFrames(30)
+    , SignificanceReducedDistance(3000.f)
+    , SignificanceMinimalDistance(10000.f)
+    , SignificanceFullResolution(512 * 512)
+    , UpdateSignificanceManager(true)
+    , ScheduleBudget(0.f)
+    , ScheduleMaxDeferredFrames(8)
+    , AverageLineOfSightMicroseconds(20.0)
+    , AverageBoneResolutionMicroseconds(10.0)
+    , CameraCycles(0)
+    , AverageCameraMicroseconds(0.0)
+    , SignificanceBias(0)
+    , FramesSinceBiasChange(0)
+{
+    SignificanceTiers.SetNum(EExtendedCameraSignificance::TOTAL_SIGNIFICANCE_TIERS);
+
+    auto &Reduced = SignificanceTiers[EExtendedCameraSignificance::SignificanceReduced];
+    Reduced.TrackingInterval = 2;
+    Reduced.LineOfSight = EExtendedCameraSignificanceLOS::ReuseLineOfSight;
+
+    auto &Minimal = SignificanceTiers[EExtendedCameraSignificance::SignificanceMinimal];
+    Minimal.TrackingInterval = 4;
+    Minimal.LineOfSight = EExtendedCameraSignificanceLOS::ReuseLineOfSight;
+    Minimal.SmoothAim = false;
+
+    auto &Dormant = SignificanceTiers[EExtendedCameraSignificance::SignificanceDormant];
+    Dormant.TrackingInterval = 15;
+    Dormant.LineOfSight = EExtendedCameraSignificanceLOS::SkipLineOfSight;
+    Dormant.SmoothAim = false;
+}
+
+void UExtendedCameraSubsystem::RegisterCamera(UExtendedCameraComponent *Camera)
+{
+    Cameras.AddUnique(Camera);
+
+    if (Camera->UseSignificance)
+    {
+        RegisterSignificance(Camera);
+    }
+}
+
+void UExtendedCameraSubsystem::UnregisterCamera(UExtendedCameraComponent *Camera)
+{
+    UnregisterSignificance(Camera);
+    Cameras.RemoveSingleSwap(Camera);
+}
+
+void UExtendedCameraSubsystem::RegisterSignificance(UExtendedCameraComponent *Camera)
+{
+    auto Manager = USignificanceManager::Get(GetWorld());
+    if (!Manager || Camera->SignificanceRegistered)
+    {
+        return;
+    }
+
+    // The significance function may run on workers, so it only reads what UpdateSignificance gathered
+    Manager->RegisterObject(
+        Camera, SignificanceTag,
+        [this](USignificanceManager::FManagedObjectInfo *Info, const FTransform &Viewpoint) {
+            return GetCameraSignificance(*CastChecked<UExtendedCameraComponent>(Info->GetObject()), Viewpoint);
+        },
+        USignificanceManager::EPostSignificanceType::Sequential,
+        [this](USignificanceManager::FManagedObjectInfo *Info, float, float Significance, bool) {
+            ApplySignificance(*CastChecked<UExtendedCameraComponent>(Info->GetObject()), Significance);
+        });
+
+    Camera->SignificanceRegistered = true;
+}
+
+void UExtendedCameraSubsystem::UnregisterSignificance(UExtendedCameraComponent *Camera)
+{
+    if (!Camera->SignificanceRegistered)
+    {
+        return;
+    }
+
+    if (auto Manager = USignificanceManager::Get(GetWorld()))
+    {
+        Manager->UnregisterObject(Camera);
+    }
+
+    Camera->SignificanceRegistered = false;
+}
+
+void UExtendedCameraSubsystem::AddCameraTime(uint64 Cycles)
+{
+    CameraCycles += Cycles;
+}
+
+bool UExtendedCameraSubsystem::IsScheduling() const
+{
+    return ScheduleBudget > 0.f;
+}
+
+void UExtendedCameraSubsystem::SetScheduleBudget(float Microseconds, int32 MaxDeferredFrames)
+{
+    ScheduleBudget = FMath::Max(Microseconds, 0.f);
+    ScheduleMaxDeferredFrames = FMath::Max(MaxDeferredFrames, 0);
+}
+
+bool UExtendedCameraSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UExtendedCameraSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UExtendedCameraSubsystem, STATGROUP_ACIExtCam);
+}
+
+void UExtendedCameraSubsystem::Tick(float DeltaTime)
+{
+    // Last frame's cameras, before this frame's start counting
+    UpdateBudget();
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    // Sequencer and Blueprint write the named track properties. Everything below reads CameraTracks
+    for (auto Camera : Cameras)
+    {
+        if (IsValid(Camera))
+        {
+            Camera->SyncNamedTrackProperties();
+        }
+    }
+
+    // Runs after the tick groups, so bones and owners have moved, but before the camera managers update
+    UpdateSignificance();
+    ScheduleWork();
+    TrackCameras(DeltaTime);
+    GatherBatch(DeltaTime);
+
+    if (Batch.NumCameras > 0)
+    {
+        EvaluateBatch();
+        ScatterBatch();
+        TraceBatch();
+    }
+
+    AddCameraTime(FPlatformTime::Cycles64() - StartCycles);
+}
+
+void UExtendedCameraSubsystem::UpdateBudget()
+{
+    const double Microseconds = FPlatformTime::ToMilliseconds64(CameraCycles) * 1000.0;
+    CameraCycles = 0;
+
+    AverageCameraMicroseconds = FMath::Lerp(AverageCameraMicroseconds, Microseconds, 0.1);
+    SET_DWORD_STAT(STAT_ACICameraMicroseconds, uint32(Microseconds));
+
+    if (SignificanceBudget <= 0.f)
+    {
+        SignificanceBias = 0;
+    }
+    else if (++FramesSinceBiasChange >= SignificanceBudgetFrames)
+    {
+        // Well under budget before raising tiers back up, so one change doesn't undo the last
+        const int32 MaxBias = EExtendedCameraSignificance::SignificanceMinimal;
+        if (AverageCameraMicroseconds > SignificanceBudget && SignificanceBias < MaxBias)
+        {
+            ++SignificanceBias;
+            FramesSinceBiasChange = 0;
+        }
+        else if (AverageCameraMicroseconds < SignificanceBudget * 0.5 && SignificanceBias > 0)
+        {
+            --SignificanceBias;
+            FramesSinceBiasChange = 0;
+        }
+    }
+
+    SET_DWORD_STAT(STAT_ACISignificanceBias, SignificanceBias);
+}
+
+void UExtendedCameraSubsystem::UpdateSignificance()
+{
+    EXTCAM_STAGE_SCOPE(Significance);
+
+    const auto World = GetWorld();
+
+    Viewpoints.Reset();
+    ViewTargets.Reset();
+    for (auto Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+    {
+        const auto Controller = Iterator->Get();
+        if (Controller && Controller->IsLocalController())
+        {
+            FVector Location;
+            FRotator Rotation;
+            Controller->GetPlayerViewPoint(Location, Rotation);
+            Viewpoints.Emplace(Rotation, Location);
+            ViewTargets.Add(Controller->GetViewTarget());
+        }
+    }
+
+    int32 NumThrottled = 0;
+    for (auto Camera : Cameras)
+    {
+        if (!IsValid(Camera))
+        {
+            continue;
+        }
+
+        // Ranked or not, the schedule never holds a view target back
+        Camera->SignificanceIsViewTarget = Camera->IsActive() && ViewTargets.Contains(Camera->GetOwner());
+
+        if (!Camera->UseSignificance)
+        {
+            continue;
+        }
+
+        Camera->SignificanceCapturePixels = GetCapturePixels(*Camera);
+        NumThrottled += !Camera->IsSignificantFrame();
+    }
+
+    SET_DWORD_STAT(STAT_ACISignificanceThrottled, NumThrottled);
+
+    // With nobody watching there's nothing to rank against, so tiers hold
+    auto Manager = USignificanceManager::Get(World);
+    if (UpdateSignificanceManager && Manager && Viewpoints.Num() > 0)
+    {
+        Manager->Update(Viewpoints);
+    }
+}
+
+float UExtendedCameraSubsystem::GetCameraSignificance(const UExtendedCameraComponent &Camera,
+                                                      const FTransform &Viewpoint) const
+{
+    if (Camera.SignificanceIsViewTarget)
+    {
+        return SignificanceFromTier(EExtendedCameraSignificance::SignificanceFull);
+    }
+
+    // Not viewed and not captured, so nobody sees it
+    if (Camera.SignificanceCapturePixels == 0)
+    {
+        return SignificanceFromTier(EExtendedCameraSignificance::SignificanceDormant);
+    }
+
+    int32 Tier = Camera.SignificanceCapturePixels >= SignificanceFullResolution
+                     ? EExtendedCameraSignificance::SignificanceFull
+                     : EExtendedCameraSignificance::SignificanceReduced;
+
+    const auto DistanceSquared = FVector::DistSquared(Viewpoint.GetLocation(), Camera.GetComponentLocation());
+    Tier += DistanceSquared > FMath::Square(SignificanceReducedDistance);
+    Tier += DistanceSquared > FMath::Square(SignificanceMinimalDistance);
+
+    return SignificanceFromTier(FMath::Min(Tier, int32(EExtendedCameraSignificance::SignificanceMinimal)));
+}
+
+void UExtendedCameraSubsystem::ApplySignificance(UExtendedCameraComponent &Camera, float Significance) const
+{
+    int32 Tier = TierFromSignificance(Significance);
+
+    // The budget never takes a view target below Full, and never wakes a dormant camera
+    if (!Camera.SignificanceIsViewTarget && Tier != EExtendedCameraSignificance::SignificanceDormant)
+    {
+        Tier = FMath::Min(Tier + SignificanceBias, int32(EExtendedCameraSignificance::SignificanceMinimal));
+    }
+
+    Camera.SetSignificanceTier(EExtendedCameraSignificance(Tier), SignificanceTiers.IsValidIndex(Tier)
+                                                                      ? SignificanceTiers[Tier]
+                                                                      : FExtendedCameraSignificanceTier());
+}
+
+void UExtendedCameraSubsystem::ScheduleWork()
+{
+    EXTCAM_STAGE_SCOPE(Schedule);
+
+    // What last frame's granted work took becomes the estimate for this frame's
+    for (auto Camera : Cameras)
+    {
+        if (!IsValid(Camera))
+        {
+            continue;
+        }
+
+        if (Camera->LineOfSightCycles > 0)
+        {
+            const double Microseconds = FPlatformTime::ToMilliseconds64(Camera->LineOfSightCycles) * 1000.0;
+            AverageLineOfSightMicroseconds = FMath::Lerp(AverageLineOfSightMicroseconds, Microseconds, 0.1);
+            Camera->LineOfSightCycles = 0;
+        }
+
+        if (Camera->BoneResolutionCycles > 0)
+        {
+            const double Microseconds = FPlatformTime::ToMilliseconds64(Camera->BoneResolutionCycles) * 1000.0;
+            AverageBoneResolutionMicroseconds = FMath::Lerp(AverageBoneResolutionMicroseconds, Microseconds, 0.1);
+            Camera->BoneResolutionCycles = 0;
+        }
+    }
+
+    if (!IsScheduling())
+    {
+        return;
+    }
+
+    ScheduledWork.Reset();
+    for (auto Camera : Cameras)
+    {
+        // Baked shots do neither, and recordings aren't held back so they replay as they ran
+        if (!IsValid(Camera) || !Camera->IsActive() || Camera->IsRecording() || Camera->HasPlayableBakedShot())
+        {
+            continue;
+        }
+
+        // Older work climbs a tier a frame, so a dormant camera isn't overtaken forever
+        const int32 Tier = Camera->UseSignificance ? int32(Camera->SignificanceTier)
+                                                   : int32(EExtendedCameraSignificance::SignificanceFull);
+        const float Priority = SignificanceFromTier(Tier);
+
+        if (Camera->NeedsBoneResolution())
+        {
+            ScheduledWork.Add({Camera, EExtendedCameraWork::BoneResolution,
+                               Priority + Camera->BoneResolutionDeferredFrames});
+        }
+
+        // Whether the view will want it isn't known until it's evaluated, so any camera that may trace asks
+        if (Camera->CameraLOSMode != EExtendedCameraMode::Ignore && Camera->TracesLineOfSightThisFrame())
+        {
+            ScheduledWork.Add({Camera, EExtendedCameraWork::LineOfSight, Priority + Camera->LineOfSightDeferredFrames});
+        }
+    }
+
+    const auto ByPriority = [](const FExtendedCameraScheduledWork &A, const FExtendedCameraScheduledWork &B) {
+        return A.Priority > B.Priority;
+    };
+    ScheduledWork.Heapify(ByPriority);
+
+    double RemainingMicroseconds = ScheduleBudget;
+    int32 NumGranted = 0;
+    int32 NumForced = 0;
+    int32 NumDeferredLOS = 0;
+    int32 NumDeferredBones = 0;
+
+    while (ScheduledWork.Num() > 0)
+    {
+        FExtendedCameraScheduledWork Work;
+        ScheduledWork.HeapPop(Work, ByPriority, false);
+
+        auto &Camera = *Work.Camera;
+        const bool IsLineOfSight = Work.Work == EExtendedCameraWork::LineOfSight;
+        int32 &DeferredFrames = IsLineOfSight ? Camera.LineOfSightDeferredFrames : Camera.BoneResolutionDeferredFrames;
+        const double Cost = IsLineOfSight ? AverageLineOfSightMicroseconds : AverageBoneResolutionMicroseconds;
+
+        // Work that doesn't fit waits, unless it's for a view target or has already waited as long as it may
+        const bool Fits = Cost <= RemainingMicroseconds;
+        if (Fits || Camera.SignificanceIsViewTarget || DeferredFrames >= ScheduleMaxDeferredFrames)
+        {
+            (IsLineOfSight ? Camera.LineOfSightScheduledFrame : Camera.BoneResolutionScheduledFrame) = GFrameCounter;
+            DeferredFrames = 0;
+            RemainingMicroseconds -= Cost;
+            ++NumGranted;
+            NumForced += !Fits;
+        }
+        else
+        {
+            ++DeferredFrames;
+            ++(IsLineOfSight ? NumDeferredLOS : NumDeferredBones);
+        }
+    }
+
+    SET_DWORD_STAT(STAT_ACIScheduledWork, NumGranted);
+    SET_DWORD_STAT(STAT_ACIForcedWork, NumForced);
+    SET_DWORD_STAT(STAT_ACIDeferredLOS, NumDeferredLOS);
+    SET_DWORD_STAT(STAT_ACIDeferredBoneLookups, NumDeferredBones);
+}
+
+void UExtendedCameraSubsystem::TrackCameras(float DeltaTime)
+{
+    ParallelTrackedCameras.Reset();
+    SerialTrackedCameras.Reset();
+
+    for (auto Camera : Cameras)
+    {
+        // Fixed timestep cameras track in their own steps, and recording ones read their own inputs
+        // Baked shots aren't tracked at all
+        if (!IsValid(Camera) || !Camera->IsActive() || Camera->UseFixedTimestep || Camera->IsRecording() ||
+            Camera->HasPlayableBakedShot())
+        {
+            continue;
+        }
+
+        // Throttled tiers keep last frame's tracks
+        if (!Camera->IsSignificantFrame())
+        {
+            continue;
+        }
+
+        if (Camera->CanTrackInParallel())
+        {
+            ParallelTrackedCameras.Add(Camera);
+        }
+        else if (Camera->UseParallelTracking || Camera->UseBatchedEvaluation)
+        {
+            SerialTrackedCameras.Add(Camera);
+        }
+    }
+
+    SET_DWORD_STAT(STAT_ACIParallelTrackedCameras, ParallelTrackedCameras.Num());
+    SET_DWORD_STAT(STAT_ACISerialTrackedCameras, SerialTrackedCameras.Num());
+
+    {
+        EXTCAM_STAGE_SCOPE(ParallelTracking);
+
+        // Each camera only writes its own tracks and context
+        ParallelFor(ParallelTrackedCameras.Num(),
+                    [this, DeltaTime](int32 Index) { ParallelTrackedCameras[Index]->UpdateTracking(DeltaTime); });
+    }
+
+    {
+        EXTCAM_STAGE_SCOPE(SerialTracking);
+
+        for (auto Camera : SerialTrackedCameras)
+        {
+            Camera->UpdateTracking(DeltaTime);
+        }
+    }
+}
+
+void UExtendedCameraSubsystem::GatherBatch(float DeltaTime)
+{
+    EXTCAM_STAGE_SCOPE(BatchGather);
+
+    BatchedCameras.Reset();
+
+    int32 NumLayers = 0;
+    for (auto Camera : Cameras)
+    {
+        if (IsValid(Camera) && Camera->UseBatchedEvaluation && !Camera->UseFixedTimestep && !Camera->IsRecording() &&
+            !Camera->HasPlayableBakedShot() && Camera->IsActive())
+        {
+            BatchedCameras.Add(Camera);
+            NumLayers = FMath::Max(NumLayers, Camera->CameraTracks.Num());
+        }
+    }
+
+    SET_DWORD_STAT(STAT_ACIBatchedCameras, BatchedCameras.Num());
+
+    const int32 NumCameras = BatchedCameras.Num();
+    Batch.Reset(NumCameras, NumLayers);
+
+    for (int32 CameraIndex = 0; CameraIndex < NumCameras; ++CameraIndex)
+    {
+        auto Camera = BatchedCameras[CameraIndex];
+
+        FMinimalViewInfo View;
+        Camera->GetBaseView(View);
+
+        // TrackCameras has already written the track transforms we're about to read. Throttled tiers hold theirs
+        if (!Camera->HasTrackedThisFrame() && Camera->IsSignificantFrame())
+        {
+            Camera->UpdateTracking(DeltaTime);
+        }
+        else
+        {
+            Camera->RefreshEvaluationContext(Camera->GetOwner());
+        }
+
+        const auto &OwnerLocation = Camera->EvaluationContext.OwnerLocation;
+        Batch.OwnerX[CameraIndex] = OwnerLocation.X;
+        Batch.OwnerY[CameraIndex] = OwnerLocation.Y;
+        Batch.OwnerZ[CameraIndex] = OwnerLocation.Z;
+        Batch.ViewX[CameraIndex] = View.Location.X;
+        Batch.ViewY[CameraIndex] = View.Location.Y;
+        Batch.ViewZ[CameraIndex] = View.Location.Z;
+        Batch.ViewFOV[CameraIndex] = View.FOV;
+        Batch.FallbackFOV[CameraIndex] = Camera->IsLOSBlocked ? Camera->StoredLOSFOV : View.FOV;
+
+        Batch.RotationBlend[CameraIndex] = Camera->RotationBlend;
+        Batch.ViewPitch[CameraIndex] = View.Rotation.Pitch;
+        Batch.ViewYaw[CameraIndex] = View.Rotation.Yaw;
+        Batch.ViewRoll[CameraIndex] = View.Rotation.Roll;
+
+        if (Camera->RotationBlend != EExtendedCameraRotationBlend::EulerBlend)
+        {
+            const auto ViewQuat = View.Rotation.Quaternion();
+            Batch.ViewQX[CameraIndex] = ViewQuat.X;
+            Batch.ViewQY[CameraIndex] = ViewQuat.Y;
+            Batch.ViewQZ[CameraIndex] = ViewQuat.Z;
+            Batch.ViewQW[CameraIndex] = ViewQuat.W;
+        }
+
+        for (int32 Layer = 0; Layer < Camera->CameraTracks.Num(); ++Layer)
+        {
+            const auto &Track = Camera->CameraTracks[Layer];
+            const int32 Index = Layer * NumCameras + CameraIndex;
+
+            // No conversion here. Only Euler blending cameras need the angles, and only for tracks with weight
+            const auto Location = Track.Transform.GetLocation();
+            const auto Rotation = Track.Transform.GetRotation();
+            Batch.TrackX[Index] = Location.X;
+            Batch.TrackY[Index] = Location.Y;
+            Batch.TrackZ[Index] = Location.Z;
+            Batch.TrackQX[Index] = Rotation.X;
+            Batch.TrackQY[Index] = Rotation.Y;
+            Batch.TrackQZ[Index] = Rotation.Z;
+            Batch.TrackQW[Index] = Rotation.W;
+            Batch.TrackFOV[Index] = Track.FOV;
+
+            // Zero means fall back to the blend so far
+            Batch.TrackOffsetFOV[Index] = FMath::IsNearlyZero(Track.FOV)
+                                              ? 0.f
+                                              : (Camera->bUseAdditiveOffset ? Track.FOV + Camera->AdditiveFOVOffset
+                                                                            : Track.FOV);
+
+            // Snap the ends so the blend below needs no special cases
+            Batch.TrackAlpha[Index] = FMath::IsNearlyZero(Track.BlendAlpha)        ? 0.f
+                                      : FMath::IsNearlyEqual(Track.BlendAlpha, 1.f) ? 1.f
+                                                                                     : Track.BlendAlpha;
+
+            Batch.DollyReferenceDistance[Index] = Track.DollyZoomReferenceDistance;
+            Batch.DollyEnabled[Index] = Track.DollyZoomEnabled;
+            Batch.DollyLiveUpdate[Index] = Track.DollyZoomDistanceLiveUpdate;
+        }
+    }
+}
+
+void UExtendedCameraSubsystem::EvaluateBatch()
+{
+    EXTCAM_STAGE_SCOPE(BatchEvaluate);
+
+    const int32 NumCameras = Batch.NumCameras;
+
+    for (int32 Layer = 0; Layer < Batch.NumLayers; ++Layer)
+    {
+        const int32 LayerOffset = Layer * NumCameras;
+
+        // Dolly zoom. Rare, so the tracks using it are packed and zoomed four at a time
+        Batch.DollyIndex.Reset();
+        Batch.DollyReference.Reset();
+        Batch.DollyFOV.Reset();
+        Batch.DollyDistance.Reset();
+
+        for (int32 Camera = 0; Camera < NumCameras; ++Camera)
+        {
+            const int32 Index = LayerOffset + Camera;
+            if (Batch.DollyEnabled[Index] && Batch.TrackAlpha[Index] > 0.f)
+            {
+                const float Distance = float(FMath::Sqrt(FMath::Square(Batch.OwnerX[Camera] - Batch.TrackX[Index]) +
+                                                         FMath::Square(Batch.OwnerY[Camera] - Batch.TrackY[Index]) +
+                                                         FMath::Square(Batch.OwnerZ[Camera] - Batch.TrackZ[Index])));
+
+                if (Batch.DollyLiveUpdate[Index])
+                {
+                    Batch.DollyReferenceDistance[Index] = Distance;
+                }
+
+                Batch.DollyIndex.Add(Index);
+                Batch.DollyReference.Add(Batch.DollyReferenceDistance[Index]);
+                Batch.DollyFOV.Add(Batch.TrackFOV[Index]);
+                Batch.DollyDistance.Add(Distance);
+            }
+        }
+
+        // Within ExtendedCameraMath::FastDollyZoomMaxError of the scalar zoom
+        ExtendedCameraMath::DollyZoomFOVBatch(Batch.DollyReference.GetData(), Batch.DollyFOV.GetData(),
+                                              Batch.DollyDistance.GetData(), Batch.DollyFOV.GetData(),
+                                              Batch.DollyIndex.Num());
+
+        for (int32 Dolly = 0; Dolly < Batch.DollyIndex.Num(); ++Dolly)
+        {
+            Batch.TrackOffsetFOV[Batch.DollyIndex[Dolly]] = Batch.DollyFOV[Dolly];
+        }
+
+        // Blend. Straight-line math over contiguous arrays so it vectorises
+        const FVector::FReal *RESTRICT TrackX = Batch.TrackX.GetData() + LayerOffset;
+        const FVector::FReal *RESTRICT TrackY = Batch.TrackY.GetData() + LayerOffset;
+        const FVector::FReal *RESTRICT TrackZ = Batch.TrackZ.GetData() + LayerOffset;
+        const float *RESTRICT TrackOffsetFOV = Batch.TrackOffsetFOV.GetData() + LayerOffset;
+        const float *RESTRICT TrackAlpha = Batch.TrackAlpha.GetData() + LayerOffset;
+        FVector::FReal *RESTRICT ViewX = Batch.ViewX.GetData();
+        FVector::FReal *RESTRICT ViewY = Batch.ViewY.GetData();
+        FVector::FReal *RESTRICT ViewZ = Batch.ViewZ.GetData();
+        float *RESTRICT ViewFOV = Batch.ViewFOV.GetData();
+        float *RESTRICT FallbackFOV = Batch.FallbackFOV.GetData();
+
+        for (int32 Camera = 0; Camera < NumCameras; ++Camera)
+        {
+            const float Alpha = TrackAlpha[Camera];
+            const float OffsetFOV = TrackOffsetFOV[Camera] != 0.f ? TrackOffsetFOV[Camera] : FallbackFOV[Camera];
+
+            ViewX[Camera] += (TrackX[Camera] - ViewX[Camera]) * Alpha;
+            ViewY[Camera] += (TrackY[Camera] - ViewY[Camera]) * Alpha;
+            ViewZ[Camera] += (TrackZ[Camera] - ViewZ[Camera]) * Alpha;
+
+            ViewFOV[Camera] += (OffsetFOV - ViewFOV[Camera]) * Alpha;
+            FallbackFOV[Camera] = ViewFOV[Camera];
+        }
+
+        // Rotation. Kept apart so the loop above has no branches
+        for (int32 Camera = 0; Camera < NumCameras; ++Camera)
+        {
+            const float Alpha = Batch.TrackAlpha[LayerOffset + Camera];
+            if (Alpha == 0.f)
+            {
+                continue;
+            }
+
+            const int32 Index = LayerOffset + Camera;
+            const FQuat TrackRotation(Batch.TrackQX[Index], Batch.TrackQY[Index], Batch.TrackQZ[Index],
+                                      Batch.TrackQW[Index]);
+
+            if (Batch.RotationBlend[Camera] == EExtendedCameraRotationBlend::EulerBlend)
+            {
+                // FMath::Lerp for FRotator takes the shortest way round each axis
+                const auto Rotation = TrackRotation.Rotator();
+                Batch.ViewPitch[Camera] +=
+                    ExtendedCameraMath::NormalizeAxis(float(Rotation.Pitch) - Batch.ViewPitch[Camera]) * Alpha;
+                Batch.ViewYaw[Camera] +=
+                    ExtendedCameraMath::NormalizeAxis(float(Rotation.Yaw) - Batch.ViewYaw[Camera]) * Alpha;
+                Batch.ViewRoll[Camera] +=
+                    ExtendedCameraMath::NormalizeAxis(float(Rotation.Roll) - Batch.ViewRoll[Camera]) * Alpha;
+                continue;
+            }
+
+            // Alpha was snapped to exactly one for fully weighted tracks
+            FQuat ViewRotation = TrackRotation;
+            if (Alpha != 1.f)
+            {
+                const FQuat Current(Batch.ViewQX[Camera], Batch.ViewQY[Camera], Batch.ViewQZ[Camera],
+                                    Batch.ViewQW[Camera]);
+                ViewRotation = Batch.RotationBlend[Camera] == EExtendedCameraRotationBlend::SlerpBlend
+                                   ? ExtendedCameraMath::SlerpQuat(Current, TrackRotation, Alpha)
+                                   : ExtendedCameraMath::NLerpQuat(Current, TrackRotation, Alpha);
+            }
+
+            Batch.ViewQX[Camera] = ViewRotation.X;
+            Batch.ViewQY[Camera] = ViewRotation.Y;
+            Batch.ViewQZ[Camera] = ViewRotation.Z;
+            Batch.ViewQW[Camera] = ViewRotation.W;
+        }
+    }
+}
+
+void UExtendedCameraSubsystem::ScatterBatch()
+{
+    EXTCAM_STAGE_SCOPE(BatchScatter);
+
+    const int32 NumCameras = Batch.NumCameras;
+
+    for (int32 CameraIndex = 0; CameraIndex < NumCameras; ++CameraIndex)
+    {
+        auto Camera = BatchedCameras[CameraIndex];
+
+        Camera->BatchedLocation = FVector(Batch.ViewX[CameraIndex], Batch.ViewY[CameraIndex], Batch.ViewZ[CameraIndex]);
+
+        // The only conversion a quaternion blending camera's view makes
+        Camera->BatchedRotation =
+            Batch.RotationBlend[CameraIndex] == EExtendedCameraRotationBlend::EulerBlend
+                ? FRotator(Batch.ViewPitch[CameraIndex], Batch.ViewYaw[CameraIndex], Batch.ViewRoll[CameraIndex])
+                : FQuat(Batch.ViewQX[CameraIndex], Batch.ViewQY[CameraIndex], Batch.ViewQZ[CameraIndex],
+                        Batch.ViewQW[CameraIndex])
+                      .Rotator();
+        Camera->BatchedFOV = Batch.ViewFOV[CameraIndex];
+        Camera->BatchedFrameNumber = GFrameCounter;
+
+        // Live dolly zoom distances belong to the track
+        for (int32 Layer = 0; Layer < Camera->CameraTracks.Num(); ++Layer)
+        {
+            const int32 Index = Layer * NumCameras + CameraIndex;
+            if (Batch.DollyLiveUpdate[Index] && Batch.DollyEnabled[Index] && Batch.TrackAlpha[Index] > 0.f)
+            {
+                Camera->CameraTracks[Layer].DollyZoomReferenceDistance = Batch.DollyReferenceDistance[Index];
+            }
+        }
+    }
+}
+
+void UExtendedCameraSubsystem::TraceBatch()
+{
+    EXTCAM_STAGE_SCOPE(BatchLineOfSight);
+
+    LOSQueries.Reset();
+
+    // Gather on the game thread, the aim may be resolved in script
+    for (auto Camera : BatchedCameras)
+    {
+        // Tiers that reuse or skip LOS this frame don't need a trace, nor do cameras the schedule holds back
+        if (!Camera->UseBatchedLineOfSight || !Camera->TracesLineOfSightThisFrame() ||
+            !Camera->IsLineOfSightScheduled())
+        {
+            continue;
+        }
+
+        auto Owner = Camera->GetOwner();
+        if (!Owner)
+        {
+            continue;
+        }
+
+        FMinimalViewInfo View;
+        View.Location = Camera->BatchedLocation;
+        View.Rotation = Camera->BatchedRotation;
+        View.FOV = Camera->BatchedFOV;
+
+        const auto &OwnerLocation = Camera->HasEvaluationContext(Owner) ? Camera->EvaluationContext.OwnerLocation
+                                                                        : Owner->GetActorLocation();
+        if (!Camera->WantsLineOfSight(OwnerLocation, View))
+        {
+            continue;
+        }
+
+        auto &Query = LOSQueries.AddDefaulted_GetRef();
+        Query.Camera = Camera;
+        Query.Start = Camera->CallsScript(EExtendedCameraScriptEvent::GetAimLocation)
+                          ? Camera->GetAimLocation(Owner)
+                          : Camera->GetAimLocation_Implementation(Owner);
+        Query.End = View.Location;
+        Query.Channel = Camera->GetCollisionObjectType();
+        Query.Shape = Camera->GetLineOfSightShape();
+        Query.Params.AddIgnoredActor(Owner);
+
+        // The probes this frame's round robin picks go in with it, as rays. The camera keeps the same pick
+        if (Camera->CameraLOSMode == EExtendedCameraMode::KeepLosPartial)
+        {
+            const uint64 StartCycles = FPlatformTime::Cycles64();
+            Camera->GetVisibilityProbes(Owner);
+            Camera->GatherVisibilityRays(Owner, View.Location);
+            Camera->LineOfSightCycles += FPlatformTime::Cycles64() - StartCycles;
+
+            for (const int32 Ray : Camera->VisibilityRays)
+            {
+                auto &ProbeQuery = LOSQueries.AddDefaulted_GetRef();
+                ProbeQuery.Camera = Camera;
+                ProbeQuery.Probe = Ray;
+                ProbeQuery.Start = Camera->VisibilityProbes[Ray].Location;
+                ProbeQuery.End = View.Location;
+                ProbeQuery.Channel = Camera->GetCollisionObjectType();
+                ProbeQuery.Params.AddIgnoredActor(Owner);
+            }
+        }
+    }
+
+    SET_DWORD_STAT(STAT_ACIBatchedLOSTraces, LOSQueries.Num());
+    INC_DWORD_STAT_BY(STAT_ACITraces, LOSQueries.Num());
+
+    const auto World = GetWorld();
+
+    // Scene queries only take read locks, so these can all be in flight together
+    ParallelFor(LOSQueries.Num(), [this, World](int32 Index) {
+        auto &Query = LOSQueries[Index];
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        World->SweepSingleByChannel(Query.Hit, Query.Start, Query.End, FQuat::Identity, Query.Channel, Query.Shape,
+                                    Query.Params);
+
+        // A miss leaves these unset, and the camera matches on them
+        Query.Hit.TraceStart = Query.Start;
+        Query.Hit.TraceEnd = Query.End;
+        Query.Cycles = FPlatformTime::Cycles64() - StartCycles;
+    });
+
+    for (auto &Query : LOSQueries)
+    {
+        // Traced in parallel, but each camera is charged for its own work as if it had traced it itself
+        Query.Camera->LineOfSightCycles += Query.Cycles;
+
+        if (Query.Probe == INDEX_NONE)
+        {
+            Query.Camera->BatchedLOSHit = Query.Hit;
+            Query.Camera->BatchedLOSFrameNumber = GFrameCounter;
+            continue;
+        }
+
+        auto &Probe = Query.Camera->VisibilityProbes[Query.Probe];
+        Probe.BatchedVisible = !Query.Hit.bBlockingHit;
+        Probe.BatchedStart = Query.Start;
+        Probe.BatchedEnd = Query.End;
+        Probe.BatchedTime = Query.Hit.bBlockingHit ? Query.Hit.Time : 1.f;
+        Probe.BatchedNormal = Query.Hit.ImpactNormal;
+        Probe.BatchedFrameNumber = GFrameCounter;
+    }
+}
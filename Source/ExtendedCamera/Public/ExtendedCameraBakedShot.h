@@ -0,0 +1,90 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#pragma once
+
+#include "Camera/CameraTypes.h"
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ExtendedCameraCurve.h"
+
+#include "ExtendedCameraBakedShot.generated.h"
+
+/**
+ * Baked Shot
+ *
+ * An extended camera's views for one shot, sampled at a fixed rate by
+ * UExtendedCameraComponent::BakeShot. Playing it back is a lookup and an
+ * interpolation, with no tracking, blending or traces. The bindings signature
+ * is the camera's at bake time, and playback only uses the shot while the
+ * camera still matches it
+ *
+ * Keys are collected uncompressed, then Compress drops those that interpolate
+ * back within the tolerances and quantises the rest. Only the compressed curve
+ * is saved
+ */
+UCLASS(BlueprintType)
+class EXTENDEDCAMERA_API UExtendedCameraBakedShot : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    // Clear the keys for a new bake
+    void Reset(float InSampleRate, uint32 InBindingsSignature);
+
+    // Append the view for the next sample
+    void AddKey(const FMinimalViewInfo &View);
+
+    // Encode the keys added since Reset into the curve that's played back, and free them
+    void Compress();
+
+    // The view Time seconds into the shot, held at either end. False if nothing was baked
+    bool Evaluate(float Time, FMinimalViewInfo &OutView) const;
+
+    UFUNCTION(BlueprintPure, Category = "Extended Camera|Baked Shot")
+    float GetDuration() const;
+
+    // Keys kept by compression
+    UFUNCTION(BlueprintPure, Category = "Extended Camera|Baked Shot")
+    int32 GetNumKeys() const;
+
+    uint32 GetBindingsSignature() const;
+
+    virtual void PostLoad() override;
+    virtual void PostDuplicate(bool bDuplicateForPIE) override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent &PropertyChangedEvent) override;
+    virtual void PostEditUndo() override;
+#endif
+
+protected:
+    UPROPERTY(VisibleAnywhere, Category = "Baked Shot", meta = (Units = Hz))
+    float SampleRate = 30.f;
+
+    // UExtendedCameraComponent::GetBindingsSignature of the camera that was baked
+    UPROPERTY(VisibleAnywhere, Category = "Baked Shot")
+    uint32 BindingsSignature = 0;
+
+    // How far the compressed curve may stray from the baked views
+    UPROPERTY(EditAnywhere, Category = "Baked Shot|Compression", meta = (ClampMin = 0, Units = cm))
+    float PositionTolerance = 0.1f;
+
+    UPROPERTY(EditAnywhere, Category = "Baked Shot|Compression", meta = (ClampMin = 0, Units = deg))
+    float AngleTolerance = 0.05f;
+
+    UPROPERTY(EditAnywhere, Category = "Baked Shot|Compression", meta = (ClampMin = 0, Units = deg))
+    float FOVTolerance = 0.05f;
+
+    // ExtendedCameraCurve::Encode of the baked views
+    UPROPERTY()
+    TArray<uint8> CurveData;
+
+    // Views added since Reset, until Compress
+    TArray<ExtendedCameraCurve::FCurveKey> Keys;
+
+    // Reads CurveData. Keeps the last pair of keys, so playing forward rarely seeks. Closed whenever CurveData is
+    // replaced and reopened once it's settled, so it never points at freed bytes
+    mutable ExtendedCameraCurve::FCurveDecoder Decoder;
+
+    // Point the decoder at CurveData, or leave it closed if that doesn't hold a curve
+    void OpenCurve();
+};
@@ -5,6 +5,9 @@
 #include "Camera/CameraActor.h"
 #include "Camera/CameraComponent.h"
 #include "CoreMinimal.h"
+#include "ExtendedCameraRecording.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "WorldCollision.h"
 
 #include "ExtendedCameraComponent.generated.h"
 
@@ -22,6 +25,7 @@ enum EExtendedCameraMode
     KeepLos UMETA(DisplayName = "Keep LOS to Owner in Frame"),
     KeepLosNoDot UMETA(DisplayName = "Always Keep Line of Sight"),
     KeepLosWithinLimit UMETA(DisplayName = "Use FOV Offset as Limit"),
+    KeepLosPartial UMETA(DisplayName = "Keep Partial Visibility"),
     TOTAL_CAMERA_MODES UMETA(Hidden)
 };
 
@@ -39,53 +43,359 @@ enum EExtendedCameraDriverMode
     TOTAL_CAMERA_DRIVER_MODES UMETA(Hidden)
 };
 
-UCLASS(config = Game, BlueprintType, Blueprintable, ClassGroup = Camera, meta = (BlueprintSpawnableComponent))
-class EXTENDEDCAMERA_API UExtendedCameraComponent : public UCameraComponent
+UENUM(BlueprintType)
+enum EExtendedCameraRotationBlend
+{
+    EulerBlend UMETA(DisplayName = "Euler Angles"),
+    NLerpBlend UMETA(DisplayName = "Quaternion Lerp"),
+    SlerpBlend UMETA(DisplayName = "Quaternion Slerp"),
+
+    TOTAL_ROTATION_BLENDS UMETA(Hidden)
+};
+
+/**
+ * Significance
+ *
+ * How much of the pipeline a camera runs, ranked by the subsystem through the
+ * significance manager. Full is a local player's view target. Dormant is a
+ * camera nobody can see
+ */
+UENUM(BlueprintType)
+enum EExtendedCameraSignificance
+{
+    SignificanceFull UMETA(DisplayName = "Full"),
+    SignificanceReduced UMETA(DisplayName = "Reduced"),
+    SignificanceMinimal UMETA(DisplayName = "Minimal"),
+    SignificanceDormant UMETA(DisplayName = "Dormant"),
+
+    TOTAL_SIGNIFICANCE_TIERS UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum EExtendedCameraSignificanceLOS
+{
+    TraceLineOfSight UMETA(DisplayName = "Trace"),
+    ReuseLineOfSight UMETA(DisplayName = "Reuse Last Result"),
+    SkipLineOfSight UMETA(DisplayName = "Skip"),
+
+    TOTAL_SIGNIFICANCE_LOS UMETA(Hidden)
+};
+
+// What one significance tier runs
+USTRUCT(BlueprintType)
+struct FExtendedCameraSignificanceTier
 {
     GENERATED_BODY()
 
-protected:
-    // DollyZoom
-    UPROPERTY(SaveGame)
-    bool IsLOSBlocked;
+    // Track every this many frames. Each tracked frame stands for all of them
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance", meta = (ClampMin = "1"))
+    int32 TrackingInterval = 1;
 
-    UPROPERTY(SaveGame, BlueprintReadOnly, Category = "Extended Camera")
-    float StoredLOSFOV;
+    // Reused results are retraced on tracked frames
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+    TEnumAsByte<EExtendedCameraSignificanceLOS> LineOfSight = EExtendedCameraSignificanceLOS::TraceLineOfSight;
 
-    ///// ///// ////////// ///// /////
-    // Dolly Zooms
-    //
+    // Off snaps aims to their targets, skipping the interpolation and the aim spring
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+    bool SmoothAim = true;
+};
+
+class USkeletalMeshComponent;
+
+/**
+ * Resolved Bone
+ *
+ * Caches the mesh and bone index for a locator or aim bone so the per-frame
+ * path does not search the skeleton by name. It is rebuilt only when the mesh
+ * component, the skeletal mesh asset or the bone name changes
+ */
+struct FExtendedCameraBoneCache
+{
+    TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+    TWeakObjectPtr<const UObject> MeshAsset;
+    FName BoneName;
+    int32 BoneIndex = INDEX_NONE;
+
+    void Reset()
+    {
+        Mesh.Reset();
+        MeshAsset.Reset();
+        BoneName = NAME_None;
+        BoneIndex = INDEX_NONE;
+    }
+};
+
+/**
+ * Visibility Probe
+ *
+ * One point the Keep Partial Visibility mode tests, and what was last seen of
+ * it. Probes are told apart by where they come from rather than by their
+ * index, so results survive probes being added, removed or not resolving
+ */
+struct FExtendedCameraVisibilityProbe
+{
+    // A bone on the owner's mesh, an owner space offset when Bone is None, or the aim when neither is set
+    FName Bone;
+    FVector Offset = FVector::ZeroVector;
+    bool IsAim = false;
+    FExtendedCameraBoneCache BoneCache;
+
+    // World space point this frame. Unresolved bones have none, and aren't traced or counted
+    FVector Location = FVector::ZeroVector;
+    bool Resolved = false;
+
+    // Last result, and the segment and frame it was traced on. Unseen probes count as visible
+    bool Visible = true;
+    FVector TracedStart = FVector::ZeroVector;
+    FVector TracedEnd = FVector::ZeroVector;
+    uint64 TracedFrameNumber = MAX_uint64;
+
+    // Where a blocked probe's segment was blocked, as a fraction from the probe to the view, and the surface's normal
+    float BlockedTime = 1.f;
+    FVector BlockedNormal = FVector::ZeroVector;
+
+    // Trace submitted through the async queue, read back next frame
+    FTraceHandle AsyncHandle;
+
+    // Written by the subsystem
+    bool BatchedVisible = true;
+    FVector BatchedStart = FVector::ZeroVector;
+    FVector BatchedEnd = FVector::ZeroVector;
+    float BatchedTime = 1.f;
+    FVector BatchedNormal = FVector::ZeroVector;
+    uint64 BatchedFrameNumber = MAX_uint64;
+
+    bool IsSameProbe(const FExtendedCameraVisibilityProbe &Other) const
+    {
+        return Bone == Other.Bone && Offset == Other.Offset && IsAim == Other.IsAim;
+    }
+};
+
+/**
+ * Script Events
+ *
+ * The BlueprintNativeEvents a Blueprint subclass may override, as bits of
+ * UExtendedCameraComponent::ScriptOverrides
+ */
+enum class EExtendedCameraScriptEvent : uint8
+{
+    GetAimLocation,
+    GetActorTrackLocation,
+    GetActorAimLocation,
+    SmoothReturn,
+    LineOfCheckHandler,
+    TrackingHandler,
+    KeepInFrameLineOfSight,
+    KeepAnyLineOfSight,
+    KeepPartialLineOfSight,
+    CommonKeepLineOfSight,
+
+    TOTAL_SCRIPT_EVENTS
+};
+
+/**
+ * Line of Sight Cache
+ *
+ * The last LOS segment that was traced, the view it was traced for, and
+ * what it hit
+ */
+struct FExtendedCameraLOSCache
+{
+    FVector Start = FVector::ZeroVector;
+    FVector End = FVector::ZeroVector;
+    FRotator Rotation = FRotator::ZeroRotator;
+    FHitResult Hit;
+    uint64 FrameNumber = MAX_uint64;
+
+    void Reset()
+    {
+        FrameNumber = MAX_uint64;
+    }
+};
+
+/**
+ * Track Evaluation
+ *
+ * Locator and aim data for one track, as read at the start of the frame
+ */
+struct FExtendedCameraTrackContext
+{
+    FVector Locator = FVector::ZeroVector;
+    FTransform Aim = FTransform::Identity;
+
+    // Aim with the track's aim offset applied
+    FVector AimPoint = FVector::ZeroVector;
+
+    float Alpha = 0.f;
+    bool HasLocator = false;
+    bool HasAim = false;
+};
+
+/**
+ * Camera Evaluation Context
+ *
+ * Filled once at the top of GetCameraView and read by every handler after it,
+ * so each locator and aim is only resolved once per frame
+ */
+struct FExtendedCameraEvaluationContext
+{
+    uint64 FrameNumber = MAX_uint64;
+
+    // Only used to match the context against the handler's owner
+    const AActor *Owner = nullptr;
+    FVector OwnerLocation = FVector::ZeroVector;
+
+    // One entry per CameraTracks entry
+    TArray<FExtendedCameraTrackContext, TInlineAllocator<8>> Tracks;
+};
+
+/**
+ * View Snapshot
+ *
+ * Everything the blend reads, as of the last full evaluation, and the view
+ * it blended to. If none of it has changed, neither has the blend
+ */
+struct FExtendedCameraTrackSnapshot
+{
+    FTransform Transform;
+    float FOV = 0.f;
+    float BlendAlpha = 0.f;
+    float DollyZoomReferenceDistance = 0.f;
+    bool DollyZoomEnabled = false;
+};
+
+struct FExtendedCameraViewSnapshot
+{
+    // Inputs
+    FVector BaseLocation = FVector::ZeroVector;
+    FRotator BaseRotation = FRotator::ZeroRotator;
+    float BaseFOV = 0.f;
+    FVector OwnerLocation = FVector::ZeroVector;
+    bool LOSBlocked = false;
+    float LOSFOV = 0.f;
+    TArray<FExtendedCameraTrackSnapshot, TInlineAllocator<8>> Tracks;
+
+    // Output, before LOS
+    FVector Location = FVector::ZeroVector;
+    FRotator Rotation = FRotator::ZeroRotator;
+    float FOV = 0.f;
+
+    bool IsValid = false;
+
+    // Frames the output has been reused for
+    int32 IdleFrames = 0;
+};
+
+// One fixed timestep's view, for interpolating between at render time
+struct FExtendedCameraSimView
+{
+    FVector Location = FVector::ZeroVector;
+    FQuat Rotation = FQuat::Identity;
+    float FOV = 0.f;
+};
+
+class UExtendedCameraBakedShot;
+class UExtendedCameraComponent;
+class UExtendedCameraSubsystem;
+class UMovieSceneSequencePlayer;
+struct FExtendedCameraTrack;
+
+// One driver mode's tracking for one track. See UExtendedCameraComponent::TrackCameraAs
+using FExtendedCameraTrackEvaluator = void (*)(UExtendedCameraComponent &Camera, FExtendedCameraTrack &Track,
+                                               const FExtendedCameraTrackContext *Context, float DeltaTime,
+                                               const FColor &DebugColour);
+
+/**
+ * Camera Track
+ *
+ * One layer of the blend stack. Each track is blended over everything beneath
+ * it by BlendAlpha, in array order
+ */
+USTRUCT(BlueprintType)
+struct EXTENDEDCAMERA_API FExtendedCameraTrack
+{
+    GENERATED_BODY()
+
+    // Track transform. Written by the driver mode, or set by users in Direct Data Driven mode
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera")
+    FTransform Transform;
 
     /**
-     * Dolly Zoom Reference Distance
-     *
-     * This variable is used to apply the FOV neutrally to the camera. At this
-     * distance, the FOV is the set FOV in the camera.
-     *
-     * This feature only functions when SecondTrackDollyZoomEnabled is true,
-     * and this variable will automatically update when
-     * SecondTrackDollyZoomDistanceLiveUpdate is true
+     * Track FOV
+     * Zero disables FOV blending
      */
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track|Dolly Zoom")
-    float SecondTrackDollyZoomReferenceDistance;
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera",
+              meta = (UIMin = "0.0", UIMax = "175", ClampMin = "0.0", ClampMax = "360.0", Units = deg))
+    float FOV = 0.f;
+
+    // Blend Amount
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera",
+              meta = (UIMin = "0.0", UIMax = "1.0"))
+    float BlendAlpha = 0.f;
+
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera")
+    TEnumAsByte<EExtendedCameraDriverMode> DriverMode = EExtendedCameraDriverMode::Compat;
+
+    ///// ///// ////////// ///// /////
+    // Reference Camera
+    //
+
+    // Target Camera
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Reference Camera")
+    ACameraActor *TrackedCamera = nullptr;
 
     /**
-     * Dolly Zoom Enabled for Second Track
-     *
-     * This enables the Dolly zoom for the second track
-     * See SecondTrackDollyZoomReferenceDistance for more information
+     * You can either null the TrackedCamera or -- and this is easier in sequencer -- you can disable it here
      */
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track|Dolly Zoom")
-    bool SecondTrackDollyZoomEnabled;
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Reference Camera")
+    bool IgnoreTrackedCamera = false;
+
+    ///// ///// ////////// ///// /////
+    // Locator
+    //
+
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Locator")
+    AActor *Locator = nullptr;
+
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Locator")
+    AActor *Aim = nullptr;
+
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Locator")
+    FVector AimOffset = FVector::ZeroVector;
+
+    UPROPERTY(SaveGame, BlueprintReadOnly, Category = "Extended Camera|Locator")
+    FRotator PastFrameLookAt = FRotator::ZeroRotator;
+
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Locator")
+    float AimInterpolationSpeed = 0.f;
 
     /**
-     * Dolly Zoom Live Update Enabled for Second Track
+     * Aim Smooth Time
      *
-     * This enables the live update of the reference distance
-     * See SecondTrackDollyZoomReferenceDistance for more information
+     * Above zero the aim follows with a critically damped spring instead of
+     * AimInterpolationSpeed, taking roughly this long to settle. Unlike the
+     * interpolation, it behaves the same at any frame rate
      */
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track|Dolly Zoom")
-    bool SecondTrackDollyZoomDistanceLiveUpdate;
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Locator",
+              meta = (ClampMin = "0.0", Units = s))
+    float AimSmoothTime = 0.f;
+
+    // Aim spring state. Degrees per second, and last frame's look at target
+    FRotator AimVelocity = FRotator::ZeroRotator;
+    FRotator PastFrameAimTarget = FRotator::ZeroRotator;
+
+    UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Locator")
+    bool AimDebug = false;
+
+    UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Locator")
+    FName LocatorBoneName;
+
+    UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Locator")
+    FName AimBoneName;
+
+    ///// ///// ////////// ///// /////
+    // Dolly Zoom
+    //
 
     /**
      * Dolly Zoom Reference Distance
@@ -93,139 +403,203 @@ protected:
      * This variable is used to apply the FOV neutrally to the camera. At this
      * distance, the FOV is the set FOV in the camera.
      *
-     * This feature only functions when SecondTrackDollyZoomEnabled is true,
+     * This feature only functions when DollyZoomEnabled is true,
      * and this variable will automatically update when
-     * SecondTrackDollyZoomDistanceLiveUpdate is true
+     * DollyZoomDistanceLiveUpdate is true
      */
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Dolly Zoom")
-    float FirstTrackDollyZoomReferenceDistance;
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Dolly Zoom")
+    float DollyZoomReferenceDistance = 0.f;
 
     /**
-     * Dolly Zoom Enabled for Second Track
+     * Dolly Zoom Enabled
      *
-     * This enables the Dolly zoom for the second track
-     * See SecondTrackDollyZoomReferenceDistance for more information
+     * See DollyZoomReferenceDistance for more information
      */
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Dolly Zoom")
-    bool FirstTrackDollyZoomEnabled;
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Dolly Zoom")
+    bool DollyZoomEnabled = false;
 
     /**
-     * Dolly Zoom Live Update Enabled for Second Track
+     * Dolly Zoom Live Update
      *
      * This enables the live update of the reference distance
-     * See SecondTrackDollyZoomReferenceDistance for more information
+     * See DollyZoomReferenceDistance for more information
      */
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Dolly Zoom")
-    bool FirstTrackDollyZoomDistanceLiveUpdate;
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Dolly Zoom")
+    bool DollyZoomDistanceLiveUpdate = false;
 
     ///// ///// ////////// ///// /////
-    // Extended Camera Blend Point
+    // Resolved Bones
     //
 
-    // Target Camera
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Reference Camera")
-    ACameraActor *PrimaryTrackedCamera;
+    FExtendedCameraBoneCache LocatorBoneCache;
+    FExtendedCameraBoneCache AimBoneCache;
 
-    // Target Camera
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track|Reference Camera")
-    ACameraActor *SecondaryTrackedCamera;
+    ///// ///// ////////// ///// /////
+    // Driver Mode Evaluator
+    //
 
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Locator")
-    AActor *PrimaryTrackLocator;
+    // Selected for EvaluatorMode. Reselected whenever DriverMode no longer matches it
+    FExtendedCameraTrackEvaluator Evaluator = nullptr;
+    TEnumAsByte<EExtendedCameraDriverMode> EvaluatorMode = EExtendedCameraDriverMode::TOTAL_CAMERA_DRIVER_MODES;
+};
 
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Locator")
-    AActor *PrimaryTrackAim;
+UCLASS(config = Game, BlueprintType, Blueprintable, ClassGroup = Camera, meta = (BlueprintSpawnableComponent))
+class EXTENDEDCAMERA_API UExtendedCameraComponent : public UCameraComponent
+{
+    GENERATED_BODY()
 
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Locator")
-    FVector PrimaryTrackAimOffset;
+    friend class UExtendedCameraSubsystem;
 
-    UPROPERTY(SaveGame, BlueprintReadOnly, Category = "Extended Camera|First Track|Locator")
-    FRotator PrimaryTrackPastFrameLookAt;
+protected:
+    // DollyZoom
+    UPROPERTY(SaveGame)
+    bool IsLOSBlocked;
 
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Locator")
-    float PrimaryTrackAimInterpolationSpeed;
+    UPROPERTY(SaveGame, BlueprintReadOnly, Category = "Extended Camera")
+    float StoredLOSFOV;
 
-//#if ENABLE_DRAW_DEBUG
-    UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Locator")
-    bool PrimaryTrackAimDebug;
-//#endif // ENABLE_DRAW_DEBUG
+    ///// ///// ////////// ///// /////
+    // Extended Camera Blend Stack
+    //
 
-    UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Locator")
-    FName PrimaryLocatorBoneName;
+    /**
+     * Camera Tracks
+     *
+     * Blended in order over the camera's own view. The first two are the
+     * Primary and Secondary tracks used by the named setters and properties
+     */
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera")
+    TArray<FExtendedCameraTrack> CameraTracks;
 
-    UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Locator")
-    FName PrimaryAimBoneName;
+    static constexpr int32 PrimaryTrackIndex = 0;
+    static constexpr int32 SecondaryTrackIndex = 1;
+
+    ///// ///// ////////// ///// /////
+    // Named Track Properties
+    //
+
+    /**
+     * Named Track Properties
+     *
+     * The Primary and Secondary tracks' fields under the names they had
+     * before CameraTracks. Sequencer can't key fields of array elements, so
+     * these are what level sequences bind to, and what Blueprints read and
+     * write. Each is kept in step with its field of CameraTracks[0] or [1]
+     * before the camera is evaluated, and after
+     */
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track")
+    FTransform PrimaryTrackTransform;
+
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track")
+    FTransform SecondaryTrackTransform;
+
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track",
+              meta = (UIMin = "0.0", UIMax = "175", ClampMin = "0.0", ClampMax = "360.0", Units = deg))
+    float PrimaryTrackFOV = 0.f;
+
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track",
+              meta = (UIMin = "0.0", UIMax = "175", ClampMin = "0.0", ClampMax = "360.0", Units = deg))
+    float SecondaryTrackFOV = 0.f;
+
+    UPROPERTY(SaveGame, Interp, Category = "Extended Camera|First Track")
+    float CameraPrimaryTrackBlendAlpha = 0.f;
+
+    UPROPERTY(SaveGame, Interp, Category = "Extended Camera|Second Track")
+    float CameraSecondaryTrackBlendAlpha = 0.f;
+
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track")
+    TEnumAsByte<EExtendedCameraDriverMode> FirstTrackCameraDriverMode = EExtendedCameraDriverMode::Compat;
+
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track")
+    TEnumAsByte<EExtendedCameraDriverMode> SecondTrackCameraDriverMode = EExtendedCameraDriverMode::Compat;
+
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite,
+              Category = "Extended Camera|First Track|Reference Camera")
+    ACameraActor *PrimaryTrackedCamera = nullptr;
+
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite,
+              Category = "Extended Camera|Second Track|Reference Camera")
+    ACameraActor *SecondaryTrackedCamera = nullptr;
+
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite,
+              Category = "Extended Camera|First Track|Reference Camera")
+    bool IgnorePrimaryTrackedCamera = false;
+
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite,
+              Category = "Extended Camera|Second Track|Reference Camera")
+    bool IgnoreSecondTrackedCamera = false;
+
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Locator")
+    AActor *PrimaryTrackLocator = nullptr;
 
     UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track|Locator")
-    AActor *SecondaryTrackLocator;
+    AActor *SecondaryTrackLocator = nullptr;
+
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Locator")
+    AActor *PrimaryTrackAim = nullptr;
 
     UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track|Locator")
-    AActor *SecondaryTrackAim;
+    AActor *SecondaryTrackAim = nullptr;
+
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Locator")
+    FVector PrimaryTrackAimOffset = FVector::ZeroVector;
 
     UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track|Locator")
-    FVector SecondaryTrackAimOffset;
+    FVector SecondaryTrackAimOffset = FVector::ZeroVector;
 
-    UPROPERTY(SaveGame, BlueprintReadOnly, Category = "Extended Camera|Second Track|Locator")
-    FRotator SecondaryTrackPastFrameLookAt;
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Locator")
+    float PrimaryTrackAimInterpolationSpeed = 0.f;
 
     UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track|Locator")
-    float SecondaryTrackAimInterpolationSpeed;
+    float SecondaryTrackAimInterpolationSpeed = 0.f;
+
+    UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Locator")
+    bool PrimaryTrackAimDebug = false;
 
-//#if ENABLE_DRAW_DEBUG
     UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track|Locator")
-    bool SecondaryTrackAimDebug;
-//#endif // ENABLE_DRAW_DEBUG
+    bool SecondaryTrackAimDebug = false;
+
+    UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Locator")
+    FName PrimaryLocatorBoneName;
 
     UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track|Locator")
     FName SecondaryLocatorBoneName;
 
+    UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Locator")
+    FName PrimaryAimBoneName;
+
     UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track|Locator")
     FName SecondaryAimBoneName;
 
-    // Write Tracked Camera to Secondary Track, otherwise Primary
-    // UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera")
-    // bool WriteTrackedToSecondary;
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Dolly Zoom")
+    float FirstTrackDollyZoomReferenceDistance = 0.f;
 
-    /**
-     * You can either null the TrackedCamera or -- and this is easier in sequencer -- you can disable it here
-     */
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera")
-    bool IgnorePrimaryTrackedCamera;
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track|Dolly Zoom")
+    float SecondTrackDollyZoomReferenceDistance = 0.f;
 
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera")
-    bool IgnoreSecondTrackedCamera;
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Dolly Zoom")
+    bool FirstTrackDollyZoomEnabled = false;
 
-    // Primary Track - Set by users
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera")
-    FTransform PrimaryTrackTransform;
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track|Dolly Zoom")
+    bool SecondTrackDollyZoomEnabled = false;
 
-    /**
-     * Primary FOV
-     * Zero disables FOV blending
-     */
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera",
-              meta = (UIMin = "0.0", UIMax = "175", ClampMin = "0.0", ClampMax = "360.0", Units = deg))
-    float PrimaryTrackFOV = 0.f;
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track|Dolly Zoom")
+    bool FirstTrackDollyZoomDistanceLiveUpdate = false;
 
-    // Secondary Track - Set by users
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera")
-    FTransform SecondaryTrackTransform;
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track|Dolly Zoom")
+    bool SecondTrackDollyZoomDistanceLiveUpdate = false;
 
     /**
-     * Secondary FOV
-     * Zero disables FOV blending
+     * Rotation Blend
+     *
+     * How track rotations are blended. Euler lerps each axis on its own, and
+     * can swing the long way round when an axis wraps at 180 degrees. The
+     * quaternion blends take the shortest arc and keep the rotation as a
+     * quaternion through the whole stack, converting to a rotator once at the
+     * end. Slerp turns at a constant rate, NLerp is cheaper
      */
-    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera",
-              meta = (UIMin = "0.0", UIMax = "175", ClampMin = "0.0", ClampMax = "360.0", Units = deg))
-    float SecondaryTrackFOV = 0.f;
-
-    // Blend Amount for the first channel
-    UPROPERTY(SaveGame, Interp, Category = "Extended Camera")
-    float CameraPrimaryTrackBlendAlpha;
-
-    // Blend Amount
-    UPROPERTY(SaveGame, Interp, Category = "Extended Camera")
-    float CameraSecondaryTrackBlendAlpha;
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera")
+    TEnumAsByte<EExtendedCameraRotationBlend> RotationBlend;
 
     // LOS Mode
     UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera")
@@ -235,10 +609,428 @@ protected:
     UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera")
     float FOVCheckOffsetInRadians;
 
+    ///// ///// ////////// ///// /////
+    // Partial Visibility
+    //
+
+    /**
+     * Visibility Probe Bones
+     *
+     * Bones on the owner's mesh that are tested for visibility in the Keep
+     * Partial Visibility mode. Bones that can't be found are skipped
+     */
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Line of Sight|Visibility")
+    TArray<FName> VisibilityProbeBones;
+
+    // Owner-space points tested alongside the bones
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Line of Sight|Visibility")
+    TArray<FVector> VisibilityProbeOffsets;
+
+    // The camera only pulls in when less than this fraction of the probes can be seen
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Line of Sight|Visibility",
+              meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float VisibilityThreshold;
+
+    // Probes retraced per frame. The rest keep their last result
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Line of Sight|Visibility",
+              meta = (ClampMin = "1"))
+    int32 VisibilityRayBudget;
+
+    // Fraction of the probes visible as of the last check
+    UPROPERTY(Transient, BlueprintReadOnly, Category = "Extended Camera|Line of Sight|Visibility")
+    float VisibilityScore;
+
+    // Every probe, bones first
+    TArray<FExtendedCameraVisibilityProbe> VisibilityProbes;
+
+    // Round robin position
+    int32 NextVisibilityProbe;
+
+    // Probes due a trace this frame. Chosen once a frame, so the subsystem's batch and the camera agree
+    TArray<int32, TInlineAllocator<16>> VisibilityRays;
+    uint64 VisibilityRaysFrameNumber;
+
+    // Rebuild the probes from the bones and offsets, keeping each one's results, and place them in the world.
+    // Falls back to the aim when none of them resolve
+    void GetVisibilityProbes(AActor *Owner);
+
+    // Pick this frame's probes to trace from ViewLocation. Probes the LOS cache still covers are passed over
+    void GatherVisibilityRays(AActor *Owner, const FVector &ViewLocation);
+
+    // Trace one probe, or take its result from the subsystem's batch or the async queue
+    void TraceVisibilityProbe(AActor *Owner, FExtendedCameraVisibilityProbe &Probe, const FVector &ViewLocation,
+                              const FCollisionQueryParams &Params);
+
     // DollyZoom for LOS Modes
     UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Line of Sight")
     bool UseDollyZoomForLOS;
 
+    /**
+     * Swept Line of Sight
+     *
+     * Sweeps a sphere of LineOfSightProbeRadius instead of tracing a line, so
+     * the camera stops short of geometry rather than on its surface. Costs
+     * the same single query as the line trace
+     */
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Line of Sight")
+    bool UseSweptLineOfSight;
+
+    // Radius of the LOS sweep. Should cover the near clip plane
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Line of Sight",
+              meta = (ClampMin = "0.0", EditCondition = "UseSweptLineOfSight"))
+    float LineOfSightProbeRadius;
+
+    // Extra distance the camera is pushed off the blocking surface, along its normal
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Line of Sight",
+              meta = (ClampMin = "0.0"))
+    float LineOfSightPushback;
+
+    // Shape every LOS query uses. A line unless sweeping
+    FCollisionShape GetLineOfSightShape() const;
+
+    /**
+     * Asynchronous Line of Sight
+     *
+     * Submits the LOS trace through the world's async trace queue and uses the
+     * result on the following frame. The blocking trace is only used when no
+     * result is available, such as on the first frame
+     */
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Line of Sight")
+    bool UseAsyncLineOfSight;
+
+    /**
+     * Async LOS Extrapolation
+     *
+     * How much of last frame's motion is used to predict where the trace
+     * endpoints will be when the result is consumed. Zero traces where the
+     * camera is now, one predicts a full frame ahead
+     */
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Line of Sight",
+              meta = (UIMin = "0.0", UIMax = "1.0", ClampMin = "0.0", ClampMax = "2.0"))
+    float AsyncLineOfSightExtrapolation;
+
+    // Trace submitted last frame
+    FTraceHandle AsyncLOSHandle;
+
+    // Trace endpoints from last frame, for extrapolation
+    FVector AsyncLOSPreviousAim;
+    FVector AsyncLOSPreviousLocation;
+    bool HasAsyncLOSHistory;
+
+    /**
+     * Batched Line of Sight
+     *
+     * Batched cameras have their LOS trace submitted by the subsystem with
+     * every other batched camera's, traced across worker threads. The result
+     * is only used if the aim and view haven't been changed since
+     */
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Line of Sight")
+    bool UseBatchedLineOfSight;
+
+    // Written by the subsystem
+    FHitResult BatchedLOSHit;
+    uint64 BatchedLOSFrameNumber;
+
+    // True if the mode wants a LOS check for this view
+    bool WantsLineOfSight(const FVector &OwnerLocation, const FMinimalViewInfo &DesiredView) const;
+
+    // True when the subsystem traced this exact segment this frame
+    bool HasBatchedLineOfSight(const FVector &Aim, const FVector &Location) const;
+
+    /**
+     * Line of Sight Cache
+     *
+     * Reuses the last LOS result while the aim and view stay within the
+     * tolerances below, so static framings skip the physics query
+     */
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Line of Sight")
+    bool UseLineOfSightCache;
+
+    // How far either end of the LOS segment may move before we retrace
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Line of Sight",
+              meta = (ClampMin = "0.0", EditCondition = "UseLineOfSightCache"))
+    float LineOfSightCachePositionTolerance;
+
+    // How far the view may rotate, in degrees, before we retrace
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Line of Sight",
+              meta = (ClampMin = "0.0", EditCondition = "UseLineOfSightCache"))
+    float LineOfSightCacheRotationTolerance;
+
+    // Frames a result may be reused for. Catches things moving into a still camera's view
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Line of Sight",
+              meta = (ClampMin = "0", EditCondition = "UseLineOfSightCache"))
+    int32 LineOfSightCacheMaxAge;
+
+    FExtendedCameraLOSCache LOSCache;
+
+    // Fill LOSCheck from the cache, placed on this segment. False if we need to trace
+    bool QueryLineOfSightCache(const FVector &Aim, const FMinimalViewInfo &DesiredView, FHitResult &LOSCheck) const;
+
+    // Remember a freshly traced result
+    void StoreLineOfSightCache(const FVector &Aim, const FMinimalViewInfo &DesiredView, const FHitResult &LOSCheck);
+
+    ///// ///// ////////// ///// /////
+    // Batched Evaluation
+    //
+
+    /**
+     * Batched Evaluation
+     *
+     * Tracking and blending are done for every batched camera at once by the
+     * world's UExtendedCameraSubsystem, and GetCameraView reads the result.
+     * Line of sight and smooth return still run per camera. HMD locking is not
+     * applied to the batched view
+     */
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Performance")
+    bool UseBatchedEvaluation;
+
+    /**
+     * Parallel Tracking
+     *
+     * Driver modes are evaluated by the world's UExtendedCameraSubsystem for
+     * all such cameras at once, across worker threads. Cameras that override
+     * TrackingHandler, GetActorTrackLocation or GetActorAimLocation in
+     * Blueprint, or have aim debugging on, are tracked serially instead
+     */
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Performance")
+    bool UseParallelTracking;
+
+    // Set once tracking has run for GFrameCounter
+    uint64 TrackedFrameNumber;
+
+    // Resolve the evaluation context and run the driver modes for this frame
+    virtual void UpdateTracking(float DeltaTime);
+
+    // True if UpdateTracking may run off the game thread
+    bool CanTrackInParallel() const;
+
+    // True when tracking has already run this frame
+    bool HasTrackedThisFrame() const;
+
+    // Written by the subsystem
+    FVector BatchedLocation;
+    FRotator BatchedRotation;
+    float BatchedFOV;
+    uint64 BatchedFrameNumber;
+
+    // The view Super::GetCameraView starts from, without HMD locking
+    void GetBaseView(FMinimalViewInfo &OutView) const;
+
+    // True when the subsystem evaluated this camera this frame
+    bool HasBatchedView() const;
+
+    ///// ///// ////////// ///// /////
+    // Incremental Evaluation
+    //
+
+    /**
+     * Incremental Evaluation
+     *
+     * Reuse last frame's blend when none of the tracks, the owner or the base
+     * view have moved and nothing is still interpolating. Tracking still runs
+     * so driver inputs are seen, and LOS and smooth return still run so
+     * anything moving into the view is seen. Turn on the LOS cache to make
+     * those cheap too. Has no effect on batched cameras
+     */
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Performance")
+    bool UseIncrementalEvaluation;
+
+    // Reblend at least this often
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Performance",
+              meta = (ClampMin = "0", EditCondition = "UseIncrementalEvaluation"))
+    int32 IncrementalMaxIdleFrames;
+
+    FExtendedCameraViewSnapshot ViewSnapshot;
+
+    // True if the last view still stands for this base view
+    bool IsViewIdle(const FMinimalViewInfo &BaseView) const;
+
+    void StoreViewSnapshot(const FVector &BaseLocation, const FRotator &BaseRotation, float BaseFOV,
+                           const FMinimalViewInfo &BlendedView);
+
+    ///// ///// ////////// ///// /////
+    // Fixed Timestep
+    //
+
+    /**
+     * Fixed Timestep
+     *
+     * Run tracking, blending and smooth return in fixed steps of
+     * 1 / FixedTimestepRate, and interpolate the view between the last two.
+     * The render delta only feeds the accumulator, so aims, springs and smooth
+     * return see the same steps on every machine, and a high refresh display
+     * doesn't run them any more often. The world is only read, and LOS only
+     * traced, on a frame's first step. The view trails the simulation by up
+     * to one step. Fixed timestep cameras are left out of the subsystem's
+     * parallel tracking and batched evaluation
+     */
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Performance")
+    bool UseFixedTimestep;
+
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Performance",
+              meta = (ClampMin = "1.0", EditCondition = "UseFixedTimestep", Units = Hz))
+    float FixedTimestepRate;
+
+    // Most steps taken in one frame. A longer hitch is dropped rather than caught up on
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Performance",
+              meta = (ClampMin = "1", EditCondition = "UseFixedTimestep"))
+    int32 FixedTimestepMaxSteps;
+
+    float FixedTimestepAccumulator;
+    FExtendedCameraSimView PreviousSimView;
+    FExtendedCameraSimView CurrentSimView;
+    bool HasSimView;
+
+    // Set for every step after a frame's first. The world hasn't moved since, so they reuse its context and LOS
+    bool RepeatingFixedStep;
+
+    // Set when this frame's first step applied a LOS hit for the later steps to reuse
+    bool FixedStepLOSHit;
+
+    // Place the first step's LOS hit on this step's segment and apply it
+    void ReuseFixedStepLineOfSight(AActor *Owner, FMinimalViewInfo &DesiredView);
+
+    // Advance the fixed steps by a frame's DeltaTime and interpolate DesiredView between them
+    void StepFixedTimestep(float DeltaTime, FMinimalViewInfo &DesiredView);
+
+    // Start over from the next frame's view
+    void ResetFixedTimestep();
+
+    // Tracking through smooth return, once per frame or once per fixed step
+    virtual void EvaluateView(float DeltaTime, FMinimalViewInfo &DesiredView);
+
+    ///// ///// ////////// ///// /////
+    // Recording
+    //
+
+    // Open while recording. Every GetCameraView is written to it
+    TUniquePtr<FExtendedCameraRecordingWriter> Recorder;
+
+    // This evaluation's inputs, filled in as they're read
+    FExtendedCameraRecordedFrame RecordedFrame;
+
+    // Set while a recorded frame is evaluated. Its inputs stand in for the world's
+    const FExtendedCameraRecordedFrame *ReplayedFrame;
+
+    // Fill the evaluation context from ReplayedFrame instead of the world
+    void ApplyReplayedContext(const FExtendedCameraRecordedFrame &Frame);
+
+    // Write the recorded transforms and FOVs over what tracking produced
+    void ApplyReplayedTracks(const FExtendedCameraRecordedFrame &Frame);
+
+    // Copy the context and tracked values into RecordedFrame
+    void CaptureRecordedTracks();
+
+    ///// ///// ////////// ///// /////
+    // Baked Shot
+    //
+
+    /**
+     * Baked Shot
+     *
+     * Views baked by BakeShot. While set, and while the camera's bindings still
+     * match the ones it was baked with, GetCameraView plays it back at
+     * BakedShotTime instead of evaluating. Otherwise the camera runs live
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Baked Shot")
+    UExtendedCameraBakedShot *BakedShot;
+
+    // Seconds into the baked shot. Key it from zero across the shot in Sequencer
+    UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Baked Shot",
+              meta = (ClampMin = "0.0", Units = s))
+    float BakedShotTime;
+
+    // GetBindingsKey when the bindings were last checked against BakedShot, and whether they matched
+    uint32 BakedShotBindingsKey;
+    bool BakedShotBindingsMatch;
+
+    // True if BakedShot should be played back this frame
+    bool HasPlayableBakedShot();
+
+    // Cheap in-session key for BakedShot and the bindings. Only changes to it recompute the signature
+    uint32 GetBindingsKey() const;
+
+    ///// ///// ////////// ///// /////
+    // Significance
+    //
+
+    /**
+     * Use Significance
+     *
+     * Let the world's UExtendedCameraSubsystem rank this camera through the
+     * significance manager, by whether it's a local player's view target, the
+     * resolution of the render target it's captured to and its distance from
+     * the players. Lower tiers track less often, reuse or skip LOS and snap
+     * their aims. Ignored while recording
+     */
+    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Performance")
+    bool UseSignificance;
+
+    // Written by the subsystem. Full until the camera is first ranked
+    TEnumAsByte<EExtendedCameraSignificance> SignificanceTier;
+    FExtendedCameraSignificanceTier SignificanceSettings;
+
+    // Gathered on the game thread for the significance function, which may run on workers
+    bool SignificanceIsViewTarget;
+    int32 SignificanceCapturePixels;
+    bool SignificanceRegistered;
+
+    // Offsets which frames a throttled camera tracks on, so they don't all land on the same one
+    uint32 SignificancePhase;
+
+    // The last hit given to ApplyLineOfSightHit, for tiers that reuse it and for deferred traces
+    FHitResult LastLOSHit;
+    bool HasLastLOSHit;
+
+    // Where this camera's time is reported against the world's budget
+    UPROPERTY(Transient)
+    UExtendedCameraSubsystem *CameraSubsystem;
+
+    // The tier's settings, or Full's when significance doesn't apply
+    const FExtendedCameraSignificanceTier &GetActiveSignificance() const;
+
+    // True if the tier tracks on this frame
+    bool IsSignificantFrame() const;
+
+    // True if LOS should be traced this frame, rather than reused or skipped
+    bool TracesLineOfSightThisFrame() const;
+
+    // What tracking advances by, which covers the frames the tier skips
+    float GetSignificanceDeltaTime(float DeltaTime) const;
+
+    // Apply the last LOS hit again, placed on this frame's segment
+    void ReuseLineOfSight(AActor *Owner, FMinimalViewInfo &DesiredView);
+
+    ///// ///// ////////// ///// /////
+    // Scheduling
+    //
+
+    // Frames the subsystem last granted this camera a LOS trace and bone resolution. See
+    // UExtendedCameraSubsystem::ScheduleBudget
+    uint64 LineOfSightScheduledFrame;
+    uint64 BoneResolutionScheduledFrame;
+
+    // Frames each has been held back since it was last granted
+    int32 LineOfSightDeferredFrames;
+    int32 BoneResolutionDeferredFrames;
+
+    // What the granted work took, collected by the subsystem for its estimates
+    uint64 LineOfSightCycles;
+    uint64 BoneResolutionCycles;
+
+    // Set while BakeShot evaluates, which has to see every key in full
+    bool BakingShot;
+
+    // Pose the owner's and the tracked actors' meshes for wherever Sequencer has just jumped to
+    void RefreshTrackedPoses();
+
+    // True if this camera may trace LOS, or look its bones up again, this frame
+    bool IsLineOfSightScheduled() const;
+    bool IsBoneResolutionScheduled() const;
+
+    // True if a track's bone has to be looked up in the skeleton again before it can be read
+    bool NeedsBoneResolution() const;
+
     ///// ///// ////////// ///// /////
     // Smooth Return
     //
@@ -254,6 +1046,21 @@ protected:
     UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Smooth Return")
     float SmoothReturnSpeed;
 
+    /**
+     * Smooth Return Time
+     *
+     * Above zero the return follows a critically damped spring instead of
+     * SmoothReturnSpeed, taking roughly this long to get back. Unlike the
+     * interpolation, it behaves the same at any frame rate
+     */
+    UPROPERTY(SaveGame, Interp, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Smooth Return",
+              meta = (ClampMin = "0.0", Units = s))
+    float SmoothReturnTime;
+
+    // Return spring state. Velocity, and where the view wanted to be last frame
+    FVector SmoothReturnVelocity;
+    FVector SmoothReturnTarget;
+
     /**
      * Smooth Return Finished Threshold
      *
@@ -267,21 +1074,102 @@ protected:
     UPROPERTY(SaveGame, BlueprintReadOnly, Category = "Extended Camera|Smooth Return")
     bool WasLineOfSightBlockedRecently;
 
+    // Find the cache slot matching an actor and bone name. Null if this is not one of our tracks
+    FExtendedCameraBoneCache *FindBoneCache(const AActor *Actor, FName BoneName, bool IsAim);
+
     ///// ///// ////////// ///// /////
-    // Driver Modes
+    // Native Dispatch
     //
 
-    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|First Track")
-    TEnumAsByte<EExtendedCameraDriverMode> FirstTrackCameraDriverMode;
+    // One bit per EExtendedCameraScriptEvent that ScriptOverridesClass implements in script
+    uint16 ScriptOverrides;
 
-    UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Extended Camera|Second Track")
-    TEnumAsByte<EExtendedCameraDriverMode> SecondTrackCameraDriverMode;
+    // The class ScriptOverrides was built for. Reinstancing a Blueprint changes our class
+    const UClass *ScriptOverridesClass;
+
+    // Rebuild ScriptOverrides for our current class
+    void CacheScriptOverrides();
+
+    /**
+     * Calls Script
+     *
+     * True if Event has to go through its BlueprintNativeEvent thunk. When it
+     * doesn't, the _Implementation is called directly and ProcessEvent is
+     * skipped. Always false off the game thread, where only native code runs
+     */
+    bool CallsScript(EExtendedCameraScriptEvent Event);
+
+    // As CallsScript, without rebuilding. A class we haven't looked at yet counts as overriding everything
+    bool IsOverriddenInScript(EExtendedCameraScriptEvent Event) const;
+
+    ///// ///// ////////// ///// /////
+    // Evaluation Context
+    //
+
+    FExtendedCameraEvaluationContext EvaluationContext;
+
+    // Resolve the owner, locators and aims for this frame
+    virtual void BuildEvaluationContext(AActor *Owner);
+
+    // True when EvaluationContext was built this frame for Owner
+    bool HasEvaluationContext(const AActor *Owner) const;
+
+    // On throttled frames, carry the held aims into this frame with the owner's current location and blend alphas
+    void RefreshEvaluationContext(AActor *Owner);
+
+    // Named track properties as of the last sync, to tell which side has been written since. Only compared
+    FExtendedCameraTrack SyncedNamedTracks[SecondaryTrackIndex + 1];
+
+    // Copy whichever of each named track property and its track field was written since the last sync onto the
+    // other. The property wins if both were
+    void SyncNamedTrackProperties();
+
+    // Copy the named track properties into the first two CameraTracks, for assets saved before CameraTracks
+    void MigrateNamedTrackProperties();
+
+    // Keep the Primary and Secondary tracks addressable
+    void EnsureNamedTracks();
+
+    // Primary or Secondary track, creating them if the array was shrunk
+    FExtendedCameraTrack &GetNamedTrack(int32 TrackIndex);
+
+    // Evaluate the driver mode for one track
+    virtual void TrackCamera(FExtendedCameraTrack &Track, const FExtendedCameraTrackContext *Context, float DeltaTime,
+                             const FColor &DebugColour);
+
+    /**
+     * Track Camera As
+     *
+     * The driver mode Mode, specialised at compile time. A track keeps a
+     * pointer to the one for its mode, so TrackCamera doesn't branch on it
+     */
+    template <EExtendedCameraDriverMode Mode>
+    static void TrackCameraAs(UExtendedCameraComponent &Camera, FExtendedCameraTrack &Track,
+                              const FExtendedCameraTrackContext *Context, float DeltaTime, const FColor &DebugColour);
+
+    // Point the track at the evaluator for its driver mode
+    static void SelectTrackEvaluator(FExtendedCameraTrack &Track);
+
+    /**
+     * Blend Track
+     *
+     * Blend one track over DesiredView. With a quaternion RotationBlend the
+     * rotation is blended into ViewRotation instead, and DesiredView.Rotation
+     * is left for the caller to set once the stack is done
+     */
+    virtual void BlendTrack(FExtendedCameraTrack &Track, const FVector &OwnerLocation, float FallbackFOV,
+                            FMinimalViewInfo &DesiredView, FQuat &ViewRotation);
+
+    // True if any track wants aim debug drawing
+    bool AnyTrackAimDebug() const;
 
 protected:
     UFUNCTION(BlueprintNativeEvent)
     FVector GetAimLocation(AActor *Owner);
     virtual FVector GetAimLocation_Implementation(AActor *Owner);
 
+    // A track's bone its cache knows the mesh lacks reads as Owner's location or transform. Before the cache it read
+    // as zero, as a bone searched for without a cache still does
     UFUNCTION(BlueprintNativeEvent)
     FVector GetActorTrackLocation(AActor *Owner, EExtendedCameraDriverMode CameraMode, FName LocatorBoneName);
     virtual FVector GetActorTrackLocation_Implementation(AActor *Owner, EExtendedCameraDriverMode CameraMode,
@@ -482,12 +1370,107 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Extended Camera|Dolly Zoom")
     virtual void SetUseDollyZoom(bool NewState);
 
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Line of Sight|Visibility")
+    virtual void SetVisibilityProbes(const TArray<FName> &ProbeBones, const TArray<FVector> &ProbeOffsets);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Line of Sight|Visibility")
+    virtual void SetVisibilityThreshold(float Threshold, int32 RayBudget);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Line of Sight|Visibility")
+    float GetVisibilityScore() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Line of Sight")
+    virtual void SetUseSweptLineOfSight(bool NewState, float ProbeRadius, float Pushback);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Line of Sight")
+    virtual void SetUseAsyncLineOfSight(bool NewState);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Line of Sight")
+    virtual void SetAsyncLineOfSightExtrapolation(float Extrapolation);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Performance")
+    virtual void SetUseBatchedEvaluation(bool NewState);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Performance")
+    virtual void SetUseIncrementalEvaluation(bool NewState, int32 MaxIdleFrames);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Performance")
+    virtual void SetUseFixedTimestep(bool NewState, float Rate = 60.f);
+
+    /**
+     * Start Recording
+     *
+     * Write every evaluation's inputs to Filename until StopRecording, for
+     * replaying offline with FExtendedCameraRecordingPlayer. Relative names
+     * go in Saved/CameraRecordings. Recording cameras are left out of the
+     * subsystem's parallel tracking and batched evaluation
+     */
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Recording")
+    virtual bool StartRecording(const FString &Filename);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Recording")
+    virtual void StopRecording();
+
+    UFUNCTION(BlueprintPure, Category = "Extended Camera|Recording")
+    bool IsRecording() const;
+
+    /**
+     * Bake Shot
+     *
+     * Step Player through its whole range at SampleRate and store this
+     * camera's view at each step in Shot. The camera is evaluated live,
+     * traces and all, so bake in the world the shot plays in
+     */
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Baked Shot")
+    virtual bool BakeShot(UMovieSceneSequencePlayer *Player, UExtendedCameraBakedShot *Shot, float SampleRate = 30.f);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Baked Shot")
+    virtual void SetBakedShot(UExtendedCameraBakedShot *Shot);
+
+    /**
+     * Bindings Signature
+     *
+     * Hash of what a baked view depends on besides time: each track's driver
+     * mode, the actors and bones it's bound to and its aim offset, and the
+     * LOS and rotation blend modes. Actors Sequencer spawned are hashed by
+     * their binding's GUID and the rest by name, so it holds across sessions
+     */
+    uint32 GetBindingsSignature() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Performance")
+    virtual void SetUseSignificance(bool NewState);
+
+    UFUNCTION(BlueprintPure, Category = "Extended Camera|Performance")
+    EExtendedCameraSignificance GetSignificanceTier() const;
+
+    // Normally set by the subsystem from the significance manager
+    virtual void SetSignificanceTier(EExtendedCameraSignificance Tier, const FExtendedCameraSignificanceTier &Settings);
+
+    // Force a full evaluation next frame, for changes the snapshot can't see such as LOS settings
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Performance")
+    virtual void MarkViewDirty();
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Performance")
+    virtual void SetUseParallelTracking(bool NewState);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Line of Sight")
+    virtual void SetUseBatchedLineOfSight(bool NewState);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Line of Sight")
+    virtual void SetUseLineOfSightCache(bool NewState);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Line of Sight")
+    virtual void SetLineOfSightCacheTolerances(float PositionTolerance, float RotationTolerance, int32 MaxAge);
+
     UFUNCTION(BlueprintCallable, Category = "Extended Camera|Smooth Return")
     virtual void SetSmoothReturn(bool NewState);
 
     UFUNCTION(BlueprintCallable, Category = "Extended Camera|Smooth Return")
     virtual void SetSmoothReturnSpeed(float NewReturnSpeed);
 
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Smooth Return")
+    virtual void SetSmoothReturnTime(float NewReturnTime);
+
     UFUNCTION(BlueprintCallable, Category = "Extended Camera|Smooth Return")
     virtual void SetSmoothReturnDeadzone(float NewDeadzone);
 
@@ -503,6 +1486,59 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Extended Camera|Second Track|Debug")
     virtual void SetSecondaryTrackAimDebug(bool Enabled);
 
+    ///// ///// ////////// ///// /////
+    // Blend Stack
+    //
+
+    // Number of tracks in the blend stack. Never less than two
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Tracks")
+    virtual int32 GetCameraTrackCount();
+
+    /**
+     * Set Camera Track Count
+     *
+     * Grows or shrinks the blend stack. The Primary and Secondary tracks are
+     * always kept, so counts below two are raised to two
+     */
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Tracks")
+    virtual void SetCameraTrackCount(int32 Count);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Tracks")
+    virtual void SetCameraTrackAlpha(int32 TrackIndex, float Alpha);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Tracks")
+    virtual float GetCameraTrackAlpha(int32 TrackIndex);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Tracks")
+    virtual void SetCameraTrackTransform(int32 TrackIndex, UPARAM(ref) FTransform &InTransform, float InFOV);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Tracks")
+    virtual void SetCameraTrackMode(int32 TrackIndex, EExtendedCameraDriverMode NewMode);
+
+    // Zero goes back to the track's AimInterpolationSpeed
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Tracks")
+    virtual void SetCameraTrackAimSmoothTime(int32 TrackIndex, float SmoothTime);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera")
+    virtual void SetRotationBlend(EExtendedCameraRotationBlend NewBlend);
+
+    /**
+     * Set Camera Track Locator and Aim
+     *
+     * Sets the actors and bone names used by the locator and aim driver modes.
+     * Returns whether the bones are valid for the track's mode
+     */
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Tracks")
+    virtual bool SetCameraTrackLocatorAndAim(int32 TrackIndex, AActor *Locator, FName LocatorBoneName, AActor *Aim,
+                                             FName AimBoneName);
+
+    // Copy of a track. Returns false if TrackIndex is out of range
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Tracks")
+    virtual bool GetCameraTrack(int32 TrackIndex, FExtendedCameraTrack &OutTrack);
+
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Tracks")
+    virtual void SetCameraTrack(int32 TrackIndex, const FExtendedCameraTrack &InTrack);
+
 
 
 
@@ -514,10 +1550,21 @@ public:
     void KeepAnyLineOfSight(AActor *Owner, FMinimalViewInfo &DesiredView);
     virtual void KeepAnyLineOfSight_Implementation(AActor *Owner, FMinimalViewInfo &DesiredView);
 
+    UFUNCTION(BlueprintNativeEvent)
+    void KeepPartialLineOfSight(AActor *Owner, FMinimalViewInfo &DesiredView);
+    virtual void KeepPartialLineOfSight_Implementation(AActor *Owner, FMinimalViewInfo &DesiredView);
+
     UFUNCTION(BlueprintNativeEvent)
     void CommonKeepLineOfSight(AActor *Owner, FMinimalViewInfo &DesiredView);
     virtual void CommonKeepLineOfSight_Implementation(AActor *Owner, FMinimalViewInfo &DesiredView);
 
+    // Apply an LOS result to the view. Handles pushback, the dolly zoom and smooth return bookkeeping
+    virtual void ApplyLineOfSightHit(AActor *Owner, FMinimalViewInfo &DesiredView, FHitResult &LOSCheck);
+
+    // Consume last frame's async trace into LOSCheck and submit this frame's. False if there was no result
+    virtual bool AsyncLineOfSight(AActor *Owner, const FVector &Aim, FMinimalViewInfo &DesiredView,
+                                  const FCollisionQueryParams &Params, FHitResult &LOSCheck);
+
     virtual void DollyZoom(AActor *Owner, FMinimalViewInfo &DesiredView, FHitResult &LOSCheck);
 
     UFUNCTION(BlueprintCallable, Category = "Extended Camera")
@@ -527,6 +1574,16 @@ public:
 
     virtual void BeginPlay() override;
 
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    virtual void Serialize(FArchive &Ar) override;
+
+    virtual void PostLoad() override;
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent &PropertyChangedEvent) override;
+#endif // WITH_EDITOR
+
 public:
     // Movers for C++
 
@@ -553,4 +1610,14 @@ public:
 
     // Set Secondary Track
     virtual void SetCameraSecondaryLocation(FVector &&InLocation);
+
+    // Set a track's rotation without going through a rotator
+    virtual void SetCameraTrackRotation(int32 TrackIndex, const FQuat &InRotation);
+
+    // Evaluate one recorded frame in place of the world. See FExtendedCameraRecordingPlayer
+    virtual void EvaluateRecordedFrame(const FExtendedCameraRecordedFrame &Frame, FMinimalViewInfo &OutView);
+
+    // Interpolation and LOS state, so a recording and its replay start from the same place
+    void CaptureRecordingState(FExtendedCameraRecordedState &OutState) const;
+    void RestoreRecordingState(const FExtendedCameraRecordedState &State);
 };
\ No newline at end of file
@@ -0,0 +1,652 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#pragma once
+
+#include "ExtendedCameraMath.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * Extended Camera Curve
+ *
+ * A compact, seekable store for camera views sampled at a fixed rate. Like
+ * ExtendedCameraMath it has no engine dependency, so it's built and tested
+ * outside of Unreal.
+ *
+ * Keys that interpolate back within tolerance are dropped. The rest are 16
+ * bytes each: a sample offset, a position on a fixed grid relative to its
+ * segment's origin, a smallest-three quaternion and a quantised FOV. Segments
+ * are indexed by their first sample, and keys within a segment are fixed
+ * size, so a seek is two binary searches and decodes only the keys either
+ * side of the time asked for
+ */
+namespace ExtendedCameraCurve
+{
+using ExtendedCameraMath::TQuat4;
+using ExtendedCameraMath::TVector3;
+
+struct FCurveKey
+{
+    TVector3<double> Location;
+    TQuat4<double> Rotation;
+    float FOV;
+};
+
+struct FCurveSettings
+{
+    // How far the decoded curve may stray from the samples. Units, degrees and degrees
+    double PositionTolerance = 0.1;
+    double AngleTolerance = 0.05;
+    double FOVTolerance = 0.05;
+
+    // Position grid. Should be well under PositionTolerance, or it eats most of it
+    double PositionPrecision = 0.01;
+};
+
+constexpr uint32_t Magic = 0x56434345; // "ECCV"
+constexpr uint16_t Version = 1;
+
+constexpr size_t HeaderSize = 32;
+constexpr size_t SegmentSize = 32;
+constexpr size_t KeySize = 16;
+
+// Longest run of samples one key pair may span. Bounds the encoder's tolerance checks
+constexpr uint32_t MaxKeyGap = 256;
+constexpr uint32_t MaxSegmentKeys = 64;
+
+// Smallest-three components are within this of zero
+constexpr double SmallestThreeRange = 0.70710678118654752440;
+constexpr uint32_t SmallestThreeSteps = (1u << 15) - 1;
+
+///// ///// ////////// ///// /////
+// Bytes
+//
+// Little endian whatever the platform
+//
+
+inline void PutBytes(std::vector<uint8_t> &Out, uint64_t Value, int Count)
+{
+    for (int Byte = 0; Byte < Count; ++Byte)
+    {
+        Out.push_back(uint8_t(Value >> (Byte * 8)));
+    }
+}
+
+inline uint64_t GetBytes(const uint8_t *In, int Count)
+{
+    uint64_t Value = 0;
+    for (int Byte = 0; Byte < Count; ++Byte)
+    {
+        Value |= uint64_t(In[Byte]) << (Byte * 8);
+    }
+    return Value;
+}
+
+inline void PutDouble(std::vector<uint8_t> &Out, double Value)
+{
+    uint64_t Bits;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+    PutBytes(Out, Bits, 8);
+}
+
+inline double GetDouble(const uint8_t *In)
+{
+    const uint64_t Bits = GetBytes(In, 8);
+    double Value;
+    std::memcpy(&Value, &Bits, sizeof(Value));
+    return Value;
+}
+
+inline void PutFloat(std::vector<uint8_t> &Out, float Value)
+{
+    uint32_t Bits;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+    PutBytes(Out, Bits, 4);
+}
+
+inline float GetFloat(const uint8_t *In)
+{
+    const uint32_t Bits = uint32_t(GetBytes(In, 4));
+    float Value;
+    std::memcpy(&Value, &Bits, sizeof(Value));
+    return Value;
+}
+
+///// ///// ////////// ///// /////
+// Quantisation
+//
+
+inline int64_t QuantisePosition(double Value, double Precision)
+{
+    return int64_t(std::llround(Value / Precision));
+}
+
+/** Pack Quat
+ *
+ * Smallest three. The largest component is dropped and rebuilt from the unit
+ * length, made positive first since q and -q are the same rotation. Its index
+ * takes two bits and the others 15 each, 47 bits in all
+ */
+inline uint64_t PackQuat(const TQuat4<double> &Quat)
+{
+    const auto Unit = ExtendedCameraMath::NormalizeQuat(Quat);
+    const double Components[4] = {Unit.X, Unit.Y, Unit.Z, Unit.W};
+
+    int Largest = 0;
+    for (int Index = 1; Index < 4; ++Index)
+    {
+        if (std::fabs(Components[Index]) > std::fabs(Components[Largest]))
+        {
+            Largest = Index;
+        }
+    }
+
+    const double Sign = Components[Largest] < 0.0 ? -1.0 : 1.0;
+
+    uint64_t Packed = uint64_t(Largest);
+    int Shift = 2;
+    for (int Index = 0; Index < 4; ++Index)
+    {
+        if (Index != Largest)
+        {
+            const double Normalised = (Components[Index] * Sign + SmallestThreeRange) / (2.0 * SmallestThreeRange);
+            const auto Step = uint64_t(ExtendedCameraMath::Clamp(std::llround(Normalised * SmallestThreeSteps),
+                                                                 0ll, (long long)SmallestThreeSteps));
+            Packed |= Step << Shift;
+            Shift += 15;
+        }
+    }
+
+    return Packed;
+}
+
+inline TQuat4<double> UnpackQuat(uint64_t Packed)
+{
+    const int Largest = int(Packed & 3);
+
+    double Components[4];
+    double SumSquared = 0.0;
+    int Shift = 2;
+    for (int Index = 0; Index < 4; ++Index)
+    {
+        if (Index != Largest)
+        {
+            const double Step = double((Packed >> Shift) & SmallestThreeSteps);
+            Components[Index] = Step / SmallestThreeSteps * (2.0 * SmallestThreeRange) - SmallestThreeRange;
+            SumSquared += Components[Index] * Components[Index];
+            Shift += 15;
+        }
+    }
+
+    Components[Largest] = std::sqrt(SumSquared < 1.0 ? 1.0 - SumSquared : 0.0);
+    const TQuat4<double> Quat{Components[0], Components[1], Components[2], Components[3]};
+    return ExtendedCameraMath::NormalizeQuat(Quat);
+}
+
+inline uint16_t QuantiseFOV(float FOV)
+{
+    const double Normalised = ExtendedCameraMath::Clamp(double(FOV) / 180.0, 0.0, 1.0);
+    return uint16_t(std::lround(Normalised * 65535.0));
+}
+
+inline float UnquantiseFOV(uint16_t FOV)
+{
+    return float(FOV / 65535.0 * 180.0);
+}
+
+///// ///// ////////// ///// /////
+// Interpolation
+//
+// The encoder checks its tolerances against the same interpolation the decoder uses
+//
+
+inline FCurveKey InterpolateKeys(const FCurveKey &A, const FCurveKey &B, double Alpha)
+{
+    return FCurveKey{ExtendedCameraMath::LerpVector(A.Location, B.Location, Alpha),
+                     ExtendedCameraMath::SlerpQuat(A.Rotation, B.Rotation, Alpha),
+                     float(ExtendedCameraMath::Lerp(double(A.FOV), double(B.FOV), Alpha))};
+}
+
+// Angle between two rotations, in degrees
+inline double AngleBetween(const TQuat4<double> &A, const TQuat4<double> &B)
+{
+    const double Dot = std::fabs(ExtendedCameraMath::QuatDot(A, B));
+    return ExtendedCameraMath::RadiansToDegrees(2.0 * std::acos(Dot < 1.0 ? Dot : 1.0));
+}
+
+///// ///// ////////// ///// /////
+// Encoder
+//
+
+namespace Detail
+{
+// A sample as it will decode, with its grid position
+struct FQuantisedKey
+{
+    int64_t Grid[3];
+    uint64_t Rotation;
+    uint16_t FOV;
+    FCurveKey Decoded;
+};
+
+inline FQuantisedKey Quantise(const FCurveKey &Key, double Precision)
+{
+    FQuantisedKey Quantised;
+    Quantised.Grid[0] = QuantisePosition(Key.Location.X, Precision);
+    Quantised.Grid[1] = QuantisePosition(Key.Location.Y, Precision);
+    Quantised.Grid[2] = QuantisePosition(Key.Location.Z, Precision);
+    Quantised.Rotation = PackQuat(Key.Rotation);
+    Quantised.FOV = QuantiseFOV(Key.FOV);
+    Quantised.Decoded = FCurveKey{{Quantised.Grid[0] * Precision, Quantised.Grid[1] * Precision,
+                                   Quantised.Grid[2] * Precision},
+                                  UnpackQuat(Quantised.Rotation),
+                                  UnquantiseFOV(Quantised.FOV)};
+    return Quantised;
+}
+
+// True if every sample between Start and End comes back within tolerance from those two keys
+inline bool SpanFits(const FCurveKey *Samples, const FQuantisedKey &Start, const FQuantisedKey &End,
+                     uint32_t StartIndex, uint32_t EndIndex, const FCurveSettings &Settings)
+{
+    const double ToleranceSquared = Settings.PositionTolerance * Settings.PositionTolerance;
+    for (uint32_t Index = StartIndex + 1; Index < EndIndex; ++Index)
+    {
+        const double Alpha = double(Index - StartIndex) / double(EndIndex - StartIndex);
+        const auto Key = InterpolateKeys(Start.Decoded, End.Decoded, Alpha);
+        const auto &Sample = Samples[Index];
+
+        const double DX = Key.Location.X - Sample.Location.X;
+        const double DY = Key.Location.Y - Sample.Location.Y;
+        const double DZ = Key.Location.Z - Sample.Location.Z;
+        if (DX * DX + DY * DY + DZ * DZ > ToleranceSquared ||
+            AngleBetween(Key.Rotation, Sample.Rotation) > Settings.AngleTolerance ||
+            std::fabs(double(Key.FOV) - double(Sample.FOV)) > Settings.FOVTolerance)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+inline bool FitsInt16(int64_t Value)
+{
+    return Value >= INT16_MIN && Value <= INT16_MAX;
+}
+} // namespace Detail
+
+/** Encode
+ *
+ * Compress Count views sampled SampleRate times a second. The first and last
+ * samples are always kept. Between them each kept key reaches as far as it
+ * can while everything it skips still interpolates back within tolerance
+ */
+inline std::vector<uint8_t> Encode(const FCurveKey *Samples, uint32_t Count, float SampleRate,
+                                   const FCurveSettings &Settings = FCurveSettings())
+{
+    using namespace Detail;
+
+    const double Precision = Settings.PositionPrecision > 0.0 ? Settings.PositionPrecision : 0.01;
+
+    // Greedy key reduction on the quantised samples, so the tolerance holds for what's decoded
+    std::vector<uint32_t> KeptIndices;
+    std::vector<FQuantisedKey> Kept;
+    if (Count > 0)
+    {
+        KeptIndices.push_back(0);
+        Kept.push_back(Quantise(Samples[0], Precision));
+    }
+
+    uint32_t Start = 0;
+    while (Count > 0 && Start < Count - 1)
+    {
+        uint32_t End = Start + 1;
+        auto EndKey = Quantise(Samples[End], Precision);
+
+        while (End + 1 < Count && End + 1 - Start <= MaxKeyGap)
+        {
+            const auto Candidate = Quantise(Samples[End + 1], Precision);
+            if (!SpanFits(Samples, Kept.back(), Candidate, Start, End + 1, Settings))
+            {
+                break;
+            }
+
+            ++End;
+            EndKey = Candidate;
+        }
+
+        KeptIndices.push_back(End);
+        Kept.push_back(EndKey);
+        Start = End;
+    }
+
+    // Split into segments wherever the origin can't reach, or they fill up
+    std::vector<uint32_t> SegmentStarts;
+    for (uint32_t Key = 0; Key < Kept.size(); ++Key)
+    {
+        bool NewSegment = SegmentStarts.empty() || Key - SegmentStarts.back() >= MaxSegmentKeys;
+        if (!NewSegment)
+        {
+            const auto &Origin = Kept[SegmentStarts.back()];
+            for (int Axis = 0; Axis < 3; ++Axis)
+            {
+                NewSegment |= !FitsInt16(Kept[Key].Grid[Axis] - Origin.Grid[Axis]);
+            }
+        }
+
+        if (NewSegment)
+        {
+            SegmentStarts.push_back(Key);
+        }
+    }
+
+    std::vector<uint8_t> Out;
+    Out.reserve(HeaderSize + SegmentStarts.size() * SegmentSize + Kept.size() * KeySize);
+
+    PutBytes(Out, Magic, 4);
+    PutBytes(Out, Version, 2);
+    PutBytes(Out, 0, 2);
+    PutFloat(Out, SampleRate > 0.f ? SampleRate : 1.f);
+    PutDouble(Out, Precision);
+    PutBytes(Out, Count, 4);
+    PutBytes(Out, Kept.size(), 4);
+    PutBytes(Out, SegmentStarts.size(), 4);
+
+    for (const auto FirstKey : SegmentStarts)
+    {
+        PutBytes(Out, KeptIndices[FirstKey], 4);
+        PutBytes(Out, FirstKey, 4);
+        for (int Axis = 0; Axis < 3; ++Axis)
+        {
+            PutBytes(Out, uint64_t(Kept[FirstKey].Grid[Axis]), 8);
+        }
+    }
+
+    size_t Segment = 0;
+    for (uint32_t Key = 0; Key < Kept.size(); ++Key)
+    {
+        if (Segment + 1 < SegmentStarts.size() && SegmentStarts[Segment + 1] == Key)
+        {
+            ++Segment;
+        }
+
+        const uint32_t FirstKey = SegmentStarts[Segment];
+        PutBytes(Out, KeptIndices[Key] - KeptIndices[FirstKey], 2);
+        for (int Axis = 0; Axis < 3; ++Axis)
+        {
+            PutBytes(Out, uint64_t(Kept[Key].Grid[Axis] - Kept[FirstKey].Grid[Axis]), 2);
+        }
+        PutBytes(Out, Kept[Key].Rotation, 6);
+        PutBytes(Out, Kept[Key].FOV, 2);
+    }
+
+    return Out;
+}
+
+///// ///// ////////// ///// /////
+// Decoder
+//
+
+/** Decoder
+ *
+ * Reads views straight out of encoded bytes, which it doesn't own. Seeks are
+ * two binary searches, and the key pair found last is tried first, so
+ * playing forward is usually neither
+ */
+class FCurveDecoder
+{
+public:
+    // False if Data isn't a curve this version can read, or any of its indices reach outside it
+    bool Open(const uint8_t *InData, size_t InSize)
+    {
+        Data = nullptr;
+        CachedKey = UINT32_MAX;
+
+        if (!InData || InSize < HeaderSize || GetBytes(InData, 4) != Magic || GetBytes(InData + 4, 2) != Version)
+        {
+            return false;
+        }
+
+        SampleRate = GetFloat(InData + 8);
+        Precision = GetDouble(InData + 12);
+        NumSamples = uint32_t(GetBytes(InData + 20, 4));
+        NumKeys = uint32_t(GetBytes(InData + 24, 4));
+        NumSegments = uint32_t(GetBytes(InData + 28, 4));
+
+        if (InSize != HeaderSize + size_t(NumSegments) * SegmentSize + size_t(NumKeys) * KeySize ||
+            (NumKeys > 0) != (NumSegments > 0) || NumSegments > NumKeys || (NumKeys > 0 && NumSamples == 0) ||
+            !(SampleRate > 0.f) || !(Precision > 0.0) || !std::isfinite(Precision))
+        {
+            return false;
+        }
+
+        // The seeks trust the indices, so every one has to land inside the data
+        Data = InData;
+        if (!IndicesHold())
+        {
+            Data = nullptr;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool IsOpen() const
+    {
+        return Data != nullptr;
+    }
+
+    // Forget the bytes opened, before the owner frees or replaces them
+    void Close()
+    {
+        Data = nullptr;
+        CachedKey = UINT32_MAX;
+    }
+
+    uint32_t GetNumKeys() const
+    {
+        return Data ? NumKeys : 0;
+    }
+
+    uint32_t GetNumSamples() const
+    {
+        return Data ? NumSamples : 0;
+    }
+
+    double GetDuration() const
+    {
+        return Data && NumSamples > 1 ? (NumSamples - 1) / double(SampleRate) : 0.0;
+    }
+
+    /** Evaluate
+     *
+     * The view Time seconds in, held at either end. False if there's nothing
+     * to evaluate
+     */
+    bool Evaluate(double Time, FCurveKey &OutKey)
+    {
+        if (!Data || NumKeys == 0)
+        {
+            return false;
+        }
+
+        const double Sample = ExtendedCameraMath::Clamp(Time * SampleRate, 0.0, double(NumSamples - 1));
+
+        // Playing forward lands in the same pair, or the next one, most of the time
+        if (!CachedPairHolds(Sample) && !AdvanceCache(Sample))
+        {
+            Seek(Sample);
+        }
+
+        if (CachedKey + 1 >= NumKeys || CachedNextSample <= CachedSample)
+        {
+            OutKey = CachedStartKey;
+            return true;
+        }
+
+        const double Alpha = (Sample - CachedSample) / double(CachedNextSample - CachedSample);
+        OutKey = InterpolateKeys(CachedStartKey, CachedEndKey, Alpha);
+        return true;
+    }
+
+private:
+    // Segments start at the first key and sample, and go up. Keys go up a sample at least at a time, across
+    // segments too, and stop before the last sample
+    bool IndicesHold() const
+    {
+        uint64_t PreviousSample = 0;
+        for (uint32_t Segment = 0; Segment < NumSegments; ++Segment)
+        {
+            const uint32_t FirstKey = SegmentFirstKey(Segment);
+            const uint32_t EndKey = SegmentEndKey(Segment);
+            if (FirstKey != (Segment == 0 ? 0 : SegmentEndKey(Segment - 1)) || EndKey <= FirstKey ||
+                EndKey > NumKeys || (Segment == 0 && SegmentFirstSample(Segment) != 0))
+            {
+                return false;
+            }
+
+            for (uint32_t Key = FirstKey; Key < EndKey; ++Key)
+            {
+                const uint64_t Offset = GetBytes(KeyAt(Key), 2);
+                const uint64_t Sample = SegmentFirstSample(Segment) + Offset;
+                if ((Key == FirstKey) != (Offset == 0) || (Key > 0 && Sample <= PreviousSample) ||
+                    Sample >= NumSamples)
+                {
+                    return false;
+                }
+                PreviousSample = Sample;
+            }
+        }
+
+        return true;
+    }
+
+    const uint8_t *SegmentAt(uint32_t Segment) const
+    {
+        return Data + HeaderSize + size_t(Segment) * SegmentSize;
+    }
+
+    uint32_t SegmentFirstSample(uint32_t Segment) const
+    {
+        return uint32_t(GetBytes(SegmentAt(Segment), 4));
+    }
+
+    uint32_t SegmentFirstKey(uint32_t Segment) const
+    {
+        return uint32_t(GetBytes(SegmentAt(Segment) + 4, 4));
+    }
+
+    uint32_t SegmentEndKey(uint32_t Segment) const
+    {
+        return Segment + 1 < NumSegments ? SegmentFirstKey(Segment + 1) : NumKeys;
+    }
+
+    const uint8_t *KeyAt(uint32_t Key) const
+    {
+        return Data + HeaderSize + size_t(NumSegments) * SegmentSize + size_t(Key) * KeySize;
+    }
+
+    uint32_t KeySample(uint32_t Segment, uint32_t Key) const
+    {
+        return SegmentFirstSample(Segment) + uint32_t(GetBytes(KeyAt(Key), 2));
+    }
+
+    FCurveKey DecodeKey(uint32_t Segment, uint32_t Key) const
+    {
+        const uint8_t *Origin = SegmentAt(Segment) + 8;
+        const uint8_t *In = KeyAt(Key);
+
+        double Location[3];
+        for (int Axis = 0; Axis < 3; ++Axis)
+        {
+            const auto OriginGrid = int64_t(GetBytes(Origin + Axis * 8, 8));
+            const auto Offset = int16_t(uint16_t(GetBytes(In + 2 + Axis * 2, 2)));
+            Location[Axis] = double(OriginGrid + Offset) * Precision;
+        }
+
+        return FCurveKey{{Location[0], Location[1], Location[2]}, UnpackQuat(GetBytes(In + 8, 6)),
+                         UnquantiseFOV(uint16_t(GetBytes(In + 14, 2)))};
+    }
+
+    bool CachedPairHolds(double Sample) const
+    {
+        return CachedKey != UINT32_MAX && Sample >= CachedSample &&
+               (Sample < CachedNextSample || CachedKey + 1 >= NumKeys);
+    }
+
+    // Move the cached pair on by one key. False if that doesn't reach Sample either
+    bool AdvanceCache(double Sample)
+    {
+        if (CachedKey == UINT32_MAX || CachedKey + 1 >= NumKeys || Sample < CachedNextSample)
+        {
+            return false;
+        }
+
+        const uint32_t Key = CachedKey + 1;
+        const uint32_t Segment = Key < SegmentEndKey(CachedSegment) ? CachedSegment : CachedSegment + 1;
+        LoadPair(Segment, Key);
+        return CachedPairHolds(Sample);
+    }
+
+    // Binary search the segments, then the keys within the one Sample falls in
+    void Seek(double Sample)
+    {
+        uint32_t Low = 0, High = NumSegments;
+        while (High - Low > 1)
+        {
+            const uint32_t Mid = (Low + High) / 2;
+            (double(SegmentFirstSample(Mid)) <= Sample ? Low : High) = Mid;
+        }
+        const uint32_t Segment = Low;
+
+        uint32_t KeyLow = SegmentFirstKey(Segment), KeyHigh = SegmentEndKey(Segment);
+        while (KeyHigh - KeyLow > 1)
+        {
+            const uint32_t Mid = (KeyLow + KeyHigh) / 2;
+            (double(KeySample(Segment, Mid)) <= Sample ? KeyLow : KeyHigh) = Mid;
+        }
+
+        LoadPair(Segment, KeyLow);
+    }
+
+    // Decode Key and the one after it, which may start the next segment
+    void LoadPair(uint32_t Segment, uint32_t Key)
+    {
+        CachedKey = Key;
+        CachedSegment = Segment;
+        CachedSample = KeySample(Segment, Key);
+        CachedStartKey = DecodeKey(Segment, Key);
+
+        if (Key + 1 < NumKeys)
+        {
+            const uint32_t NextSegment = Key + 1 < SegmentEndKey(Segment) ? Segment : Segment + 1;
+            CachedNextSample = KeySample(NextSegment, Key + 1);
+            CachedEndKey = DecodeKey(NextSegment, Key + 1);
+        }
+        else
+        {
+            CachedNextSample = CachedSample;
+            CachedEndKey = CachedStartKey;
+        }
+    }
+
+    const uint8_t *Data = nullptr;
+    float SampleRate = 1.f;
+    double Precision = 0.01;
+    uint32_t NumSamples = 0;
+    uint32_t NumKeys = 0;
+    uint32_t NumSegments = 0;
+
+    // The pair of keys the last evaluation fell between
+    uint32_t CachedKey = UINT32_MAX;
+    uint32_t CachedSegment = 0;
+    uint32_t CachedSample = 0;
+    uint32_t CachedNextSample = 0;
+    FCurveKey CachedStartKey{};
+    FCurveKey CachedEndKey{};
+};
+} // namespace ExtendedCameraCurve
@@ -0,0 +1,813 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Pick the widest vector unit we can rely on. x64 always has SSE2, and AArch64 always has NEON
+#if !defined(EXTENDED_CAMERA_MATH_SSE) && !defined(EXTENDED_CAMERA_MATH_NEON)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EXTENDED_CAMERA_MATH_SSE 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define EXTENDED_CAMERA_MATH_NEON 1
+#endif
+#endif
+
+#ifndef EXTENDED_CAMERA_MATH_SSE
+#define EXTENDED_CAMERA_MATH_SSE 0
+#endif
+
+#ifndef EXTENDED_CAMERA_MATH_NEON
+#define EXTENDED_CAMERA_MATH_NEON 0
+#endif
+
+#if EXTENDED_CAMERA_MATH_SSE
+#include <emmintrin.h>
+#elif EXTENDED_CAMERA_MATH_NEON
+#include <arm_neon.h>
+#endif
+
+/**
+ * Extended Camera Math
+ *
+ * The camera's maths with no engine dependency, so it can be built and measured
+ * outside of Unreal. Vector, rotator and quaternion functions take any type with
+ * X, Y, Z, Pitch, Yaw, Roll or X, Y, Z, W members that can be brace constructed
+ * from them. That covers FVector, FRotator and FQuat as well as the plain types
+ * below
+ */
+namespace ExtendedCameraMath
+{
+template <typename T> struct TVector3
+{
+    T X;
+    T Y;
+    T Z;
+};
+
+template <typename T> struct TRotator3
+{
+    T Pitch;
+    T Yaw;
+    T Roll;
+};
+
+template <typename T> struct TQuat4
+{
+    T X;
+    T Y;
+    T Z;
+    T W;
+};
+
+constexpr double Pi = 3.141592653589793238462643383279502884;
+
+// Same as UE_SMALL_NUMBER and UE_KINDA_SMALL_NUMBER
+constexpr double SmallNumber = 1.e-8;
+constexpr double KindaSmallNumber = 1.e-4;
+
+template <typename T> constexpr T DegreesToRadians(T Degrees)
+{
+    return Degrees * T(Pi / 180.0);
+}
+
+template <typename T> constexpr T RadiansToDegrees(T Radians)
+{
+    return Radians * T(180.0 / Pi);
+}
+
+template <typename T> constexpr T Clamp(T Value, T Min, T Max)
+{
+    return Value < Min ? Min : (Value < Max ? Value : Max);
+}
+
+template <typename T, typename U> constexpr T Lerp(T A, T B, U Alpha)
+{
+    return A + (B - A) * T(Alpha);
+}
+
+template <typename T> constexpr bool IsNearlyEqual(T A, T B, T Tolerance = T(SmallNumber))
+{
+    return (A < B ? B - A : A - B) <= Tolerance;
+}
+
+///// ///// ////////// ///// /////
+// Angles
+//
+
+/** Normalize Axis
+ *
+ * FRotator::NormalizeAxis without the branches, so loops over it vectorise.
+ * Maps to [-180, 180]. The only difference is exactly 180 comes back as -180
+ */
+template <typename T> inline T NormalizeAxis(T Angle)
+{
+    return Angle - T(360) * std::floor(Angle * T(1.0 / 360.0) + T(0.5));
+}
+
+template <typename RotatorType> inline RotatorType NormalizeRotator(const RotatorType &Rotator)
+{
+    return RotatorType{NormalizeAxis(Rotator.Pitch), NormalizeAxis(Rotator.Yaw), NormalizeAxis(Rotator.Roll)};
+}
+
+///// ///// ////////// ///// /////
+// Quaternions
+//
+
+/** Rotator to Quat
+ *
+ * Same as FRotator::Quaternion, so a quaternion made here matches the one a
+ * track's transform holds for the same rotator
+ */
+template <typename QuatType, typename RotatorType> inline QuatType RotatorToQuat(const RotatorType &Rotator)
+{
+    using T = decltype(QuatType{}.X);
+    const T HalfAngle = T(Pi / 360.0);
+    const T SP = std::sin(T(Rotator.Pitch) * HalfAngle), CP = std::cos(T(Rotator.Pitch) * HalfAngle);
+    const T SY = std::sin(T(Rotator.Yaw) * HalfAngle), CY = std::cos(T(Rotator.Yaw) * HalfAngle);
+    const T SR = std::sin(T(Rotator.Roll) * HalfAngle), CR = std::cos(T(Rotator.Roll) * HalfAngle);
+
+    return QuatType{CR * SP * SY - SR * CP * CY, -CR * SP * CY - SR * CP * SY, CR * CP * SY - SR * SP * CY,
+                    CR * CP * CY + SR * SP * SY};
+}
+
+/** Quat to Rotator
+ *
+ * Same as FQuat::Rotator, including its handling of the poles where yaw and
+ * roll can't be told apart
+ */
+template <typename RotatorType, typename QuatType> inline RotatorType QuatToRotator(const QuatType &Quat)
+{
+    using R = decltype(RotatorType{}.Pitch);
+    using T = decltype(Quat.X);
+
+    const T SingularityTest = Quat.Z * Quat.X - Quat.W * Quat.Y;
+    const T YawY = T(2) * (Quat.W * Quat.Z + Quat.X * Quat.Y);
+    const T YawX = T(1) - T(2) * (Quat.Y * Quat.Y + Quat.Z * Quat.Z);
+    const T Yaw = RadiansToDegrees(std::atan2(YawY, YawX));
+
+    // Same threshold as FQuat::Rotator
+    constexpr T SingularityThreshold = T(0.4999995);
+    if (SingularityTest < -SingularityThreshold)
+    {
+        const T Twist = T(2) * RadiansToDegrees(std::atan2(Quat.X, Quat.W));
+        return RotatorType{R(-90), R(Yaw), R(NormalizeAxis(-Yaw - Twist))};
+    }
+
+    if (SingularityTest > SingularityThreshold)
+    {
+        const T Twist = T(2) * RadiansToDegrees(std::atan2(Quat.X, Quat.W));
+        return RotatorType{R(90), R(Yaw), R(NormalizeAxis(Yaw - Twist))};
+    }
+
+    const T Pitch = RadiansToDegrees(std::asin(Clamp(T(2) * SingularityTest, T(-1), T(1))));
+    const T Roll = RadiansToDegrees(std::atan2(T(-2) * (Quat.W * Quat.X + Quat.Y * Quat.Z),
+                                               T(1) - T(2) * (Quat.X * Quat.X + Quat.Y * Quat.Y)));
+    return RotatorType{R(Pitch), R(Yaw), R(Roll)};
+}
+
+template <typename QuatType> constexpr auto QuatDot(const QuatType &A, const QuatType &B)
+{
+    return A.X * B.X + A.Y * B.Y + A.Z * B.Z + A.W * B.W;
+}
+
+// Identity if Quat is too short to normalise
+template <typename QuatType> inline QuatType NormalizeQuat(const QuatType &Quat)
+{
+    using T = decltype(Quat.X);
+    const T SizeSquared = QuatDot(Quat, Quat);
+    if (SizeSquared < T(SmallNumber))
+    {
+        return QuatType{T(0), T(0), T(0), T(1)};
+    }
+
+    const T Scale = T(1) / std::sqrt(SizeSquared);
+    return QuatType{Quat.X * Scale, Quat.Y * Scale, Quat.Z * Scale, Quat.W * Scale};
+}
+
+/** NLerp Quat
+ *
+ * Lerp and renormalise, taking the shortest arc. Cheaper than SlerpQuat, but
+ * the angular speed isn't constant across the blend. Same as FQuat::FastLerp
+ * followed by a normalise
+ */
+template <typename QuatType, typename AlphaType>
+inline QuatType NLerpQuat(const QuatType &A, const QuatType &B, AlphaType Alpha)
+{
+    using T = decltype(A.X);
+
+    // q and -q are the same rotation. Pick whichever is on A's side so we go the short way round
+    const T BScale = QuatDot(A, B) >= T(0) ? T(Alpha) : -T(Alpha);
+    const T AScale = T(1) - T(Alpha);
+
+    return NormalizeQuat(QuatType{A.X * AScale + B.X * BScale, A.Y * AScale + B.Y * BScale,
+                                  A.Z * AScale + B.Z * BScale, A.W * AScale + B.W * BScale});
+}
+
+/** Slerp Quat
+ *
+ * Constant angular speed along the shortest arc. Same as FQuat::Slerp, and
+ * like it falls back to a lerp when A and B are nearly the same
+ */
+template <typename QuatType, typename AlphaType>
+inline QuatType SlerpQuat(const QuatType &A, const QuatType &B, AlphaType Alpha)
+{
+    using T = decltype(A.X);
+
+    const T RawCosom = QuatDot(A, B);
+    const T Cosom = RawCosom >= T(0) ? RawCosom : -RawCosom;
+
+    T AScale, BScale;
+    if (Cosom < T(0.9999))
+    {
+        const T Omega = std::acos(Cosom);
+        const T InvSin = T(1) / std::sin(Omega);
+        AScale = std::sin((T(1) - T(Alpha)) * Omega) * InvSin;
+        BScale = std::sin(T(Alpha) * Omega) * InvSin;
+    }
+    else
+    {
+        AScale = T(1) - T(Alpha);
+        BScale = T(Alpha);
+    }
+
+    BScale = RawCosom >= T(0) ? BScale : -BScale;
+
+    return NormalizeQuat(QuatType{A.X * AScale + B.X * BScale, A.Y * AScale + B.Y * BScale,
+                                  A.Z * AScale + B.Z * BScale, A.W * AScale + B.W * BScale});
+}
+
+///// ///// ////////// ///// /////
+// Dolly Zoom
+//
+
+/** Dolly Zoom FOV
+ *
+ * The FOV that keeps a subject the same size on screen when it moves from
+ * ReferenceDistance, where it was framed with ReferenceFOV, to CurrentDistance.
+ *
+ * A size of TD := 2(tan(0) * x) where theta is FOV/2. We want TD to stay the
+ * same as we move from x to x', so
+ * tan(0') = (tan(0) * x) / x'
+ * 0' = atan(tan(0) * r), with r = x / x'
+ */
+template <typename T> inline T DollyZoomFOV(T ReferenceDistance, T ReferenceFOV, T CurrentDistance)
+{
+    const T ReferenceTheta = DegreesToRadians(ReferenceFOV * T(0.5));
+    const T DistanceRatio = ReferenceDistance / CurrentDistance;
+    return T(2) * RadiansToDegrees(std::atan(std::tan(ReferenceTheta) * DistanceRatio));
+}
+
+///// ///// ////////// ///// /////
+// Batched Dolly Zoom
+//
+
+/** Fast Tan
+ *
+ * Lambert's continued fraction for tan, cut at the fourth term. In exact
+ * arithmetic the relative error is below 2e-7 for |X| up to 89 degrees. In
+ * float it stays below 1e-5, the loss being cancellation in the denominator
+ * near the top of that range. Only valid for |X| < pi/2
+ */
+inline float FastTan(float X)
+{
+    const float X2 = X * X;
+    const float Numerator = X * (135135.f + X2 * (-17325.f + X2 * (378.f - X2)));
+    const float Denominator = 135135.f + X2 * (-62370.f + X2 * (3150.f - 28.f * X2));
+    return Numerator / Denominator;
+}
+
+/** Fast Atan
+ *
+ * Abramowitz and Stegun 4.4.49 over [0, 1], folded with atan(x) = pi/2 -
+ * atan(1/x) for the rest. Absolute error is below 2e-8 radians in exact
+ * arithmetic and 2e-7 radians in float
+ */
+inline float FastAtan(float X)
+{
+    const float AbsX = std::abs(X);
+    const bool Fold = AbsX > 1.f;
+    const float Z = Fold ? 1.f / AbsX : AbsX;
+    const float Z2 = Z * Z;
+
+    float Poly = 0.0028662257f;
+    Poly = Poly * Z2 - 0.0161657367f;
+    Poly = Poly * Z2 + 0.0429096138f;
+    Poly = Poly * Z2 - 0.0752896400f;
+    Poly = Poly * Z2 + 0.1065626393f;
+    Poly = Poly * Z2 - 0.1420889944f;
+    Poly = Poly * Z2 + 0.1999355085f;
+    Poly = Poly * Z2 - 0.3333314528f;
+    const float Result = Z + Z * Z2 * Poly;
+
+    const float Folded = Fold ? float(Pi * 0.5) - Result : Result;
+    return X < 0.f ? -Folded : Folded;
+}
+
+/** Fast Dolly Zoom FOV
+ *
+ * DollyZoomFOV using FastTan and FastAtan. Stays within
+ * FastDollyZoomMaxError degrees of the double precision DollyZoomFOV for
+ * reference FOVs up to 170 degrees
+ */
+constexpr float FastDollyZoomMaxError = 2.e-4f;
+
+inline float FastDollyZoomFOV(float ReferenceDistance, float ReferenceFOV, float CurrentDistance)
+{
+    const float Tangent = FastTan(ReferenceFOV * float(Pi / 360.0));
+    return FastAtan(Tangent * (ReferenceDistance / CurrentDistance)) * float(360.0 / Pi);
+}
+
+/** Dolly Zoom FOV Batch
+ *
+ * FastDollyZoomFOV over arrays, four at a time with SSE2 or NEON where we
+ * have them. OutFOV may alias any of the inputs
+ */
+inline void DollyZoomFOVBatch(const float *ReferenceDistance, const float *ReferenceFOV,
+                              const float *CurrentDistance, float *OutFOV, int Count)
+{
+    int Index = 0;
+
+#if EXTENDED_CAMERA_MATH_SSE
+    const __m128 HalfDegreesToRadians = _mm_set1_ps(float(Pi / 360.0));
+    const __m128 RadiansToDoubleDegrees = _mm_set1_ps(float(360.0 / Pi));
+    const __m128 One = _mm_set1_ps(1.f);
+    const __m128 HalfPi = _mm_set1_ps(float(Pi * 0.5));
+    const __m128 SignMask = _mm_set1_ps(-0.f);
+
+    for (; Index + 4 <= Count; Index += 4)
+    {
+        // Tan
+        const __m128 X = _mm_mul_ps(_mm_loadu_ps(ReferenceFOV + Index), HalfDegreesToRadians);
+        const __m128 X2 = _mm_mul_ps(X, X);
+        __m128 Numerator = _mm_sub_ps(_mm_set1_ps(378.f), X2);
+        Numerator = _mm_add_ps(_mm_mul_ps(Numerator, X2), _mm_set1_ps(-17325.f));
+        Numerator = _mm_add_ps(_mm_mul_ps(Numerator, X2), _mm_set1_ps(135135.f));
+        Numerator = _mm_mul_ps(Numerator, X);
+        __m128 Denominator = _mm_sub_ps(_mm_set1_ps(3150.f), _mm_mul_ps(_mm_set1_ps(28.f), X2));
+        Denominator = _mm_add_ps(_mm_mul_ps(Denominator, X2), _mm_set1_ps(-62370.f));
+        Denominator = _mm_add_ps(_mm_mul_ps(Denominator, X2), _mm_set1_ps(135135.f));
+
+        const __m128 Ratio =
+            _mm_div_ps(_mm_loadu_ps(ReferenceDistance + Index), _mm_loadu_ps(CurrentDistance + Index));
+        const __m128 Y = _mm_mul_ps(_mm_div_ps(Numerator, Denominator), Ratio);
+
+        // Atan. min(|y|, 1/|y|) picks the folded argument without a branch
+        const __m128 Sign = _mm_and_ps(Y, SignMask);
+        const __m128 AbsY = _mm_andnot_ps(SignMask, Y);
+        const __m128 Fold = _mm_cmpgt_ps(AbsY, One);
+        const __m128 Z = _mm_min_ps(AbsY, _mm_div_ps(One, AbsY));
+        const __m128 Z2 = _mm_mul_ps(Z, Z);
+
+        __m128 Poly = _mm_set1_ps(0.0028662257f);
+        Poly = _mm_add_ps(_mm_mul_ps(Poly, Z2), _mm_set1_ps(-0.0161657367f));
+        Poly = _mm_add_ps(_mm_mul_ps(Poly, Z2), _mm_set1_ps(0.0429096138f));
+        Poly = _mm_add_ps(_mm_mul_ps(Poly, Z2), _mm_set1_ps(-0.0752896400f));
+        Poly = _mm_add_ps(_mm_mul_ps(Poly, Z2), _mm_set1_ps(0.1065626393f));
+        Poly = _mm_add_ps(_mm_mul_ps(Poly, Z2), _mm_set1_ps(-0.1420889944f));
+        Poly = _mm_add_ps(_mm_mul_ps(Poly, Z2), _mm_set1_ps(0.1999355085f));
+        Poly = _mm_add_ps(_mm_mul_ps(Poly, Z2), _mm_set1_ps(-0.3333314528f));
+        const __m128 Result = _mm_add_ps(Z, _mm_mul_ps(_mm_mul_ps(Z, Z2), Poly));
+
+        const __m128 Folded =
+            _mm_or_ps(_mm_and_ps(Fold, _mm_sub_ps(HalfPi, Result)), _mm_andnot_ps(Fold, Result));
+        _mm_storeu_ps(OutFOV + Index, _mm_mul_ps(_mm_or_ps(Folded, Sign), RadiansToDoubleDegrees));
+    }
+#elif EXTENDED_CAMERA_MATH_NEON
+    const float32x4_t One = vdupq_n_f32(1.f);
+    const float32x4_t HalfPi = vdupq_n_f32(float(Pi * 0.5));
+
+    for (; Index + 4 <= Count; Index += 4)
+    {
+        // Tan
+        const float32x4_t X = vmulq_n_f32(vld1q_f32(ReferenceFOV + Index), float(Pi / 360.0));
+        const float32x4_t X2 = vmulq_f32(X, X);
+        float32x4_t Numerator = vsubq_f32(vdupq_n_f32(378.f), X2);
+        Numerator = vmlaq_f32(vdupq_n_f32(-17325.f), Numerator, X2);
+        Numerator = vmlaq_f32(vdupq_n_f32(135135.f), Numerator, X2);
+        Numerator = vmulq_f32(Numerator, X);
+        float32x4_t Denominator = vmlsq_f32(vdupq_n_f32(3150.f), vdupq_n_f32(28.f), X2);
+        Denominator = vmlaq_f32(vdupq_n_f32(-62370.f), Denominator, X2);
+        Denominator = vmlaq_f32(vdupq_n_f32(135135.f), Denominator, X2);
+
+        const float32x4_t Ratio = vdivq_f32(vld1q_f32(ReferenceDistance + Index), vld1q_f32(CurrentDistance + Index));
+        const float32x4_t Y = vmulq_f32(vdivq_f32(Numerator, Denominator), Ratio);
+
+        // Atan. min(|y|, 1/|y|) picks the folded argument without a branch
+        const float32x4_t AbsY = vabsq_f32(Y);
+        const uint32x4_t Fold = vcgtq_f32(AbsY, One);
+        const float32x4_t Z = vminq_f32(AbsY, vdivq_f32(One, AbsY));
+        const float32x4_t Z2 = vmulq_f32(Z, Z);
+
+        float32x4_t Poly = vdupq_n_f32(0.0028662257f);
+        Poly = vmlaq_f32(vdupq_n_f32(-0.0161657367f), Poly, Z2);
+        Poly = vmlaq_f32(vdupq_n_f32(0.0429096138f), Poly, Z2);
+        Poly = vmlaq_f32(vdupq_n_f32(-0.0752896400f), Poly, Z2);
+        Poly = vmlaq_f32(vdupq_n_f32(0.1065626393f), Poly, Z2);
+        Poly = vmlaq_f32(vdupq_n_f32(-0.1420889944f), Poly, Z2);
+        Poly = vmlaq_f32(vdupq_n_f32(0.1999355085f), Poly, Z2);
+        Poly = vmlaq_f32(vdupq_n_f32(-0.3333314528f), Poly, Z2);
+        const float32x4_t Result = vmlaq_f32(Z, vmulq_f32(Z, Z2), Poly);
+
+        const float32x4_t Folded = vbslq_f32(Fold, vsubq_f32(HalfPi, Result), Result);
+        const float32x4_t Signed = vbslq_f32(vcltq_f32(Y, vdupq_n_f32(0.f)), vnegq_f32(Folded), Folded);
+        vst1q_f32(OutFOV + Index, vmulq_n_f32(Signed, float(360.0 / Pi)));
+    }
+#endif
+
+    // Whatever doesn't fill a vector
+    for (; Index < Count; ++Index)
+    {
+        OutFOV[Index] = FastDollyZoomFOV(ReferenceDistance[Index], ReferenceFOV[Index], CurrentDistance[Index]);
+    }
+}
+
+///// ///// ////////// ///// /////
+// Blending
+//
+
+template <typename VectorType, typename AlphaType>
+inline VectorType LerpVector(const VectorType &A, const VectorType &B, AlphaType Alpha)
+{
+    return VectorType{Lerp(A.X, B.X, Alpha), Lerp(A.Y, B.Y, Alpha), Lerp(A.Z, B.Z, Alpha)};
+}
+
+/** Lerp Rotator
+ *
+ * Same as FMath::Lerp for FRotator. Each axis takes the shortest way round,
+ * and the result isn't normalized
+ */
+template <typename RotatorType, typename AlphaType>
+inline RotatorType LerpRotator(const RotatorType &A, const RotatorType &B, AlphaType Alpha)
+{
+    using T = decltype(A.Pitch);
+    return RotatorType{A.Pitch + NormalizeAxis(T(B.Pitch - A.Pitch)) * T(Alpha),
+                       A.Yaw + NormalizeAxis(T(B.Yaw - A.Yaw)) * T(Alpha),
+                       A.Roll + NormalizeAxis(T(B.Roll - A.Roll)) * T(Alpha)};
+}
+
+/** Blend View
+ *
+ * Blend a view towards a track. A fully weighted track replaces the view
+ * outright rather than lerping onto it
+ */
+template <typename VectorType, typename RotatorType, typename T>
+inline void BlendView(VectorType &Location, RotatorType &Rotation, T &FOV, const VectorType &TrackLocation,
+                      const RotatorType &TrackRotation, T TrackFOV, T Alpha)
+{
+    if (IsNearlyEqual(Alpha, T(1)))
+    {
+        Location = TrackLocation;
+        Rotation = TrackRotation;
+        FOV = TrackFOV;
+    }
+    else
+    {
+        Location = LerpVector(Location, TrackLocation, Alpha);
+        Rotation = LerpRotator(Rotation, TrackRotation, Alpha);
+        FOV = Lerp(FOV, TrackFOV, Alpha);
+    }
+}
+
+/** Blend View Quat
+ *
+ * BlendView with the rotation kept as a quaternion, so there's no Euler
+ * conversion per track and no flip where an axis wraps at 180 degrees.
+ * Spherical uses SlerpQuat, otherwise NLerpQuat
+ */
+template <typename VectorType, typename QuatType, typename T>
+inline void BlendViewQuat(VectorType &Location, QuatType &Rotation, T &FOV, const VectorType &TrackLocation,
+                          const QuatType &TrackRotation, T TrackFOV, T Alpha, bool Spherical)
+{
+    if (IsNearlyEqual(Alpha, T(1)))
+    {
+        Location = TrackLocation;
+        Rotation = TrackRotation;
+        FOV = TrackFOV;
+    }
+    else
+    {
+        Location = LerpVector(Location, TrackLocation, Alpha);
+        Rotation = Spherical ? SlerpQuat(Rotation, TrackRotation, Alpha) : NLerpQuat(Rotation, TrackRotation, Alpha);
+        FOV = Lerp(FOV, TrackFOV, Alpha);
+    }
+}
+
+///// ///// ////////// ///// /////
+// Interpolation
+//
+
+// Same as FMath::FInterpTo
+template <typename T> inline T InterpTo(T Current, T Target, T DeltaTime, T InterpSpeed)
+{
+    if (InterpSpeed <= T(0))
+    {
+        return Target;
+    }
+
+    const T Distance = Target - Current;
+    if (Distance * Distance < T(SmallNumber))
+    {
+        return Target;
+    }
+
+    return Current + Distance * Clamp(DeltaTime * InterpSpeed, T(0), T(1));
+}
+
+// Same as FMath::VInterpTo
+template <typename VectorType, typename T>
+inline VectorType VInterpTo(const VectorType &Current, const VectorType &Target, T DeltaTime, T InterpSpeed)
+{
+    if (InterpSpeed <= T(0))
+    {
+        return Target;
+    }
+
+    const auto DX = Target.X - Current.X;
+    const auto DY = Target.Y - Current.Y;
+    const auto DZ = Target.Z - Current.Z;
+    if (DX * DX + DY * DY + DZ * DZ < KindaSmallNumber)
+    {
+        return Target;
+    }
+
+    const auto Alpha = Clamp(DeltaTime * InterpSpeed, T(0), T(1));
+    return VectorType{Current.X + DX * Alpha, Current.Y + DY * Alpha, Current.Z + DZ * Alpha};
+}
+
+// Same as FMath::RInterpTo
+template <typename RotatorType, typename T>
+inline RotatorType RInterpTo(const RotatorType &Current, const RotatorType &Target, T DeltaTime, T InterpSpeed)
+{
+    if (DeltaTime == T(0) ||
+        (Current.Pitch == Target.Pitch && Current.Yaw == Target.Yaw && Current.Roll == Target.Roll))
+    {
+        return Current;
+    }
+
+    if (InterpSpeed <= T(0))
+    {
+        return Target;
+    }
+
+    using R = decltype(Current.Pitch);
+    const R DPitch = NormalizeAxis(R(Target.Pitch - Current.Pitch));
+    const R DYaw = NormalizeAxis(R(Target.Yaw - Current.Yaw));
+    const R DRoll = NormalizeAxis(R(Target.Roll - Current.Roll));
+
+    const R Tolerance = R(KindaSmallNumber);
+    if (std::abs(DPitch) <= Tolerance && std::abs(DYaw) <= Tolerance && std::abs(DRoll) <= Tolerance)
+    {
+        return Target;
+    }
+
+    const R Alpha = R(Clamp(DeltaTime * InterpSpeed, T(0), T(1)));
+    return NormalizeRotator(
+        RotatorType{Current.Pitch + DPitch * Alpha, Current.Yaw + DYaw * Alpha, Current.Roll + DRoll * Alpha});
+}
+
+///// ///// ////////// ///// /////
+// Springs
+//
+
+// Substep length and count the springs use unless told otherwise. Spikes past 8 / 60 s are taken in longer steps
+constexpr double SpringMaxStepTime = 1.0 / 60.0;
+constexpr int SpringMaxSubsteps = 8;
+
+/** Spring Damp
+ *
+ * Critically damped spring from Value towards Target, carrying Velocity
+ * between calls. SmoothTime is roughly how long it takes to close the gap.
+ *
+ * This is the exact solution for a target that holds still over DeltaTime,
+ * x(t) = Target + (x0 + (v0 + w * x0) * t) * e^(-w * t), with x0 the offset
+ * from Target and w = 2 / SmoothTime. So it never overshoots a still target,
+ * stays stable for any DeltaTime, and lands in the same place whether the
+ * time is taken in one step or many
+ */
+template <typename T> inline void SpringDamp(T &Value, T &Velocity, T Target, T SmoothTime, T DeltaTime)
+{
+    if (SmoothTime <= T(0))
+    {
+        Value = Target;
+        Velocity = T(0);
+        return;
+    }
+
+    const T Omega = T(2) / SmoothTime;
+    const T Offset = Value - Target;
+    const T Impulse = Velocity + Offset * Omega;
+    const T Decay = std::exp(-Omega * DeltaTime);
+
+    Value = Target + (Offset + Impulse * DeltaTime) * Decay;
+    Velocity = (Velocity - Impulse * Omega * DeltaTime) * Decay;
+}
+
+// How many equal substeps DeltaTime is split into. A step a rounding error over MaxStepTime isn't split
+template <typename T> inline int SpringSubsteps(T DeltaTime, T MaxStepTime, int MaxSubsteps)
+{
+    if (MaxStepTime <= T(0))
+    {
+        return 1;
+    }
+
+    const int Substeps = int(std::ceil(DeltaTime / MaxStepTime - T(1.e-3)));
+    return Substeps < 1 ? 1 : (Substeps < MaxSubsteps ? Substeps : (MaxSubsteps > 1 ? MaxSubsteps : 1));
+}
+
+/** Spring Damp Substepped
+ *
+ * SpringDamp for a moving target. The target is taken to move in a straight
+ * line from PreviousTarget to Target over DeltaTime, and is followed in
+ * substeps of at most MaxStepTime. A frame time spike then lags behind a
+ * moving target the same way a run of short frames would, rather than
+ * chasing where it ended up for the whole spike
+ */
+template <typename T>
+inline void SpringDampSubstepped(T &Value, T &Velocity, T PreviousTarget, T Target, T SmoothTime, T DeltaTime,
+                                 T MaxStepTime = T(SpringMaxStepTime), int MaxSubsteps = SpringMaxSubsteps)
+{
+    const int Substeps = SpringSubsteps(DeltaTime, MaxStepTime, MaxSubsteps);
+    const T StepTime = DeltaTime / T(Substeps);
+
+    for (int Step = 1; Step <= Substeps; ++Step)
+    {
+        SpringDamp(Value, Velocity, Lerp(PreviousTarget, Target, T(Step) / T(Substeps)), SmoothTime, StepTime);
+    }
+}
+
+template <typename VectorType, typename T>
+inline void SpringDampVector(VectorType &Value, VectorType &Velocity, const VectorType &PreviousTarget,
+                             const VectorType &Target, T SmoothTime, T DeltaTime, T MaxStepTime = T(SpringMaxStepTime),
+                             int MaxSubsteps = SpringMaxSubsteps)
+{
+    using R = decltype(Value.X);
+    SpringDampSubstepped(Value.X, Velocity.X, R(PreviousTarget.X), R(Target.X), R(SmoothTime), R(DeltaTime),
+                         R(MaxStepTime), MaxSubsteps);
+    SpringDampSubstepped(Value.Y, Velocity.Y, R(PreviousTarget.Y), R(Target.Y), R(SmoothTime), R(DeltaTime),
+                         R(MaxStepTime), MaxSubsteps);
+    SpringDampSubstepped(Value.Z, Velocity.Z, R(PreviousTarget.Z), R(Target.Z), R(SmoothTime), R(DeltaTime),
+                         R(MaxStepTime), MaxSubsteps);
+}
+
+/** Spring Damp Rotator
+ *
+ * SpringDampVector for rotators. Each axis heads the shortest way round to
+ * its target, and the result is normalized. Velocity is in degrees per second
+ */
+template <typename RotatorType, typename T>
+inline void SpringDampRotator(RotatorType &Value, RotatorType &Velocity, const RotatorType &PreviousTarget,
+                              const RotatorType &Target, T SmoothTime, T DeltaTime,
+                              T MaxStepTime = T(SpringMaxStepTime), int MaxSubsteps = SpringMaxSubsteps)
+{
+    using R = decltype(Value.Pitch);
+
+    // Both targets are brought within half a turn of the value, so no axis goes the long way
+    const auto Axis = [&](R &Angle, R &Speed, R PreviousGoal, R Goal) {
+        const R Current = Angle;
+        SpringDampSubstepped(Angle, Speed, Current + NormalizeAxis(R(PreviousGoal - Current)),
+                             Current + NormalizeAxis(R(Goal - Current)), R(SmoothTime), R(DeltaTime), R(MaxStepTime),
+                             MaxSubsteps);
+        Angle = NormalizeAxis(Angle);
+    };
+
+    Axis(Value.Pitch, Velocity.Pitch, PreviousTarget.Pitch, Target.Pitch);
+    Axis(Value.Yaw, Velocity.Yaw, PreviousTarget.Yaw, Target.Yaw);
+    Axis(Value.Roll, Velocity.Roll, PreviousTarget.Roll, Target.Roll);
+}
+
+///// ///// ////////// ///// /////
+// Batched Springs
+//
+
+/** Fast Neg Exp
+ *
+ * e^-X for X >= 0. Written as 2^-Y, the whole part of Y goes straight into
+ * the float's exponent and the rest is a fifth order series over half a
+ * binade either side. Relative error is below 1e-5 until the result goes
+ * denormal, so a spring using it is as stable as one using std::exp
+ */
+inline float FastNegExp(float X)
+{
+    const float Y = X * 1.44269504f;
+    const float ClampedY = Y < 126.f ? Y : 126.f;
+    const int Whole = int(ClampedY + 0.5f);
+
+    // 2^(Whole - Y) = e^U with |U| <= ln(2) / 2
+    const float U = (float(Whole) - ClampedY) * 0.693147181f;
+    const float Fraction =
+        1.f + U * (1.f + U * (1.f / 2.f + U * (1.f / 6.f + U * (1.f / 24.f + U * (1.f / 120.f)))));
+
+    const std::int32_t Bits = (127 - Whole) << 23;
+    float Scale;
+    std::memcpy(&Scale, &Bits, sizeof(Scale));
+    return Fraction * Scale;
+}
+
+// SpringDamp with FastNegExp. Smooth times below 1e-4 s decay to nothing in a step, which is as good as a snap
+inline void FastSpringDamp(float &Value, float &Velocity, float Target, float SmoothTime, float DeltaTime)
+{
+    const float Omega = 2.f / (SmoothTime > 1.e-4f ? SmoothTime : 1.e-4f);
+    const float Offset = Value - Target;
+    const float Impulse = Velocity + Offset * Omega;
+    const float Decay = FastNegExp(Omega * DeltaTime);
+
+    Value = Target + (Offset + Impulse * DeltaTime) * Decay;
+    Velocity = (Velocity - Impulse * Omega * DeltaTime) * Decay;
+}
+
+/** Spring Damp Batch
+ *
+ * SpringDampSubstepped for Count springs at once, each with its own value,
+ * velocity, targets and smooth time and all over the same DeltaTime. Uses
+ * FastSpringDamp, four at a time with SSE2 or NEON where we have them. A
+ * smooth time of zero or less snaps that spring to within a rounding error of
+ * its target
+ */
+inline void SpringDampBatch(float *Value, float *Velocity, const float *PreviousTarget, const float *Target,
+                            const float *SmoothTime, int Count, float DeltaTime,
+                            float MaxStepTime = float(SpringMaxStepTime), int MaxSubsteps = SpringMaxSubsteps)
+{
+    const int Substeps = SpringSubsteps(DeltaTime, MaxStepTime, MaxSubsteps);
+    const float StepTime = DeltaTime / float(Substeps);
+
+    for (int Step = 1; Step <= Substeps; ++Step)
+    {
+        const float TargetAlpha = float(Step) / float(Substeps);
+        int Index = 0;
+
+#if EXTENDED_CAMERA_MATH_SSE
+        const __m128 Alpha = _mm_set1_ps(TargetAlpha);
+        const __m128 Dt = _mm_set1_ps(StepTime);
+        const __m128 MinTime = _mm_set1_ps(1.e-4f);
+        const __m128 Half = _mm_set1_ps(0.5f);
+
+        for (; Index + 4 <= Count; Index += 4)
+        {
+            const __m128 Previous = _mm_loadu_ps(PreviousTarget + Index);
+            const __m128 Travel = _mm_sub_ps(_mm_loadu_ps(Target + Index), Previous);
+            const __m128 Goal = _mm_add_ps(Previous, _mm_mul_ps(Travel, Alpha));
+            const __m128 Omega = _mm_div_ps(_mm_set1_ps(2.f), _mm_max_ps(_mm_loadu_ps(SmoothTime + Index), MinTime));
+            const __m128 Offset = _mm_sub_ps(_mm_loadu_ps(Value + Index), Goal);
+            const __m128 Speed = _mm_loadu_ps(Velocity + Index);
+            const __m128 Impulse = _mm_add_ps(Speed, _mm_mul_ps(Offset, Omega));
+
+            // FastNegExp
+            const __m128 Y = _mm_min_ps(_mm_mul_ps(Omega, _mm_set1_ps(StepTime * 1.44269504f)), _mm_set1_ps(126.f));
+            const __m128i Whole = _mm_cvttps_epi32(_mm_add_ps(Y, Half));
+            const __m128 U = _mm_mul_ps(_mm_sub_ps(_mm_cvtepi32_ps(Whole), Y), _mm_set1_ps(0.693147181f));
+            __m128 Fraction = _mm_add_ps(_mm_mul_ps(U, _mm_set1_ps(1.f / 120.f)), _mm_set1_ps(1.f / 24.f));
+            Fraction = _mm_add_ps(_mm_mul_ps(Fraction, U), _mm_set1_ps(1.f / 6.f));
+            Fraction = _mm_add_ps(_mm_mul_ps(Fraction, U), Half);
+            Fraction = _mm_add_ps(_mm_mul_ps(Fraction, U), _mm_set1_ps(1.f));
+            Fraction = _mm_add_ps(_mm_mul_ps(Fraction, U), _mm_set1_ps(1.f));
+            const __m128 Scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_sub_epi32(_mm_set1_epi32(127), Whole), 23));
+            const __m128 Decay = _mm_mul_ps(Fraction, Scale);
+
+            const __m128 Moved = _mm_add_ps(Offset, _mm_mul_ps(Impulse, Dt));
+            _mm_storeu_ps(Value + Index, _mm_add_ps(Goal, _mm_mul_ps(Moved, Decay)));
+            const __m128 Braked = _mm_sub_ps(Speed, _mm_mul_ps(_mm_mul_ps(Impulse, Omega), Dt));
+            _mm_storeu_ps(Velocity + Index, _mm_mul_ps(Braked, Decay));
+        }
+#elif EXTENDED_CAMERA_MATH_NEON
+        const float32x4_t MinTime = vdupq_n_f32(1.e-4f);
+
+        for (; Index + 4 <= Count; Index += 4)
+        {
+            const float32x4_t Previous = vld1q_f32(PreviousTarget + Index);
+            const float32x4_t Goal = vmlaq_n_f32(Previous, vsubq_f32(vld1q_f32(Target + Index), Previous), TargetAlpha);
+            const float32x4_t Omega = vdivq_f32(vdupq_n_f32(2.f), vmaxq_f32(vld1q_f32(SmoothTime + Index), MinTime));
+            const float32x4_t Offset = vsubq_f32(vld1q_f32(Value + Index), Goal);
+            const float32x4_t Speed = vld1q_f32(Velocity + Index);
+            const float32x4_t Impulse = vmlaq_f32(Speed, Offset, Omega);
+
+            // FastNegExp
+            const float32x4_t Y = vminq_f32(vmulq_n_f32(Omega, StepTime * 1.44269504f), vdupq_n_f32(126.f));
+            const int32x4_t Whole = vcvtq_s32_f32(vaddq_f32(Y, vdupq_n_f32(0.5f)));
+            const float32x4_t U = vmulq_n_f32(vsubq_f32(vcvtq_f32_s32(Whole), Y), 0.693147181f);
+            float32x4_t Fraction = vmlaq_n_f32(vdupq_n_f32(1.f / 24.f), U, 1.f / 120.f);
+            Fraction = vmlaq_f32(vdupq_n_f32(1.f / 6.f), Fraction, U);
+            Fraction = vmlaq_f32(vdupq_n_f32(0.5f), Fraction, U);
+            Fraction = vmlaq_f32(vdupq_n_f32(1.f), Fraction, U);
+            Fraction = vmlaq_f32(vdupq_n_f32(1.f), Fraction, U);
+            const float32x4_t Scale = vreinterpretq_f32_s32(vshlq_n_s32(vsubq_s32(vdupq_n_s32(127), Whole), 23));
+            const float32x4_t Decay = vmulq_f32(Fraction, Scale);
+
+            const float32x4_t Moved = vmlaq_n_f32(Offset, Impulse, StepTime);
+            vst1q_f32(Value + Index, vmlaq_f32(Goal, Moved, Decay));
+            const float32x4_t Braked = vmlsq_f32(Speed, vmulq_f32(Impulse, Omega), vdupq_n_f32(StepTime));
+            vst1q_f32(Velocity + Index, vmulq_f32(Braked, Decay));
+        }
+#endif
+
+        // Whatever doesn't fill a vector
+        for (; Index < Count; ++Index)
+        {
+            const float Goal = PreviousTarget[Index] + (Target[Index] - PreviousTarget[Index]) * TargetAlpha;
+            FastSpringDamp(Value[Index], Velocity[Index], Goal, SmoothTime[Index], StepTime);
+        }
+    }
+}
+} // namespace ExtendedCameraMath
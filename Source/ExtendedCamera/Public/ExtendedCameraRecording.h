@@ -0,0 +1,170 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#pragma once
+
+#include "Camera/CameraTypes.h"
+#include "CoreMinimal.h"
+
+class UExtendedCameraComponent;
+
+/**
+ * Recorded Track
+ *
+ * One track's inputs for one frame. Transform and FOV are what the track held
+ * after tracking. Tracks with both a locator and an aim rebuild their
+ * transform from those, so it isn't written for them
+ */
+struct FExtendedCameraRecordedTrack
+{
+    FTransform Transform = FTransform::Identity;
+    FVector Locator = FVector::ZeroVector;
+    FTransform Aim = FTransform::Identity;
+    float Alpha = 0.f;
+    float FOV = 0.f;
+    bool HasLocator = false;
+    bool HasAim = false;
+};
+
+/**
+ * Recorded Frame
+ *
+ * Everything one evaluation read from the world. With the camera's settings
+ * and the state it started from, it is enough to rebuild the view
+ */
+struct FExtendedCameraRecordedFrame
+{
+    float DeltaTime = 0.f;
+
+    // The view Super::GetCameraView handed us
+    FVector BaseLocation = FVector::ZeroVector;
+    FRotator BaseRotation = FRotator::ZeroRotator;
+    float BaseFOV = 0.f;
+
+    FVector OwnerLocation = FVector::ZeroVector;
+    FQuat OwnerRotation = FQuat::Identity;
+
+    TArray<FExtendedCameraRecordedTrack, TInlineAllocator<8>> Tracks;
+
+    // The LOS result applied to the view, before pushback. Only set when a check ran
+    bool HasLineOfSight = false;
+    bool LineOfSightBlocked = false;
+    FVector LineOfSightLocation = FVector::ZeroVector;
+    FVector LineOfSightNormal = FVector::ZeroVector;
+};
+
+/**
+ * Recorded State
+ *
+ * The camera's interpolation and LOS state when recording started. A replay
+ * starts from it, so the first frames don't settle differently
+ */
+struct FExtendedCameraRecordedTrackState
+{
+    FRotator PastFrameLookAt = FRotator::ZeroRotator;
+    FRotator PastFrameAimTarget = FRotator::ZeroRotator;
+    FRotator AimVelocity = FRotator::ZeroRotator;
+    float DollyZoomReferenceDistance = 0.f;
+};
+
+struct FExtendedCameraRecordedState
+{
+    TArray<FExtendedCameraRecordedTrackState, TInlineAllocator<8>> Tracks;
+
+    bool IsLOSBlocked = false;
+    float StoredLOSFOV = 0.f;
+    bool WasLineOfSightBlockedRecently = false;
+    FVector StoredPreviousLocationForReturn = FVector::ZeroVector;
+    FVector SmoothReturnVelocity = FVector::ZeroVector;
+    FVector SmoothReturnTarget = FVector::ZeroVector;
+
+    friend FArchive &operator<<(FArchive &Ar, FExtendedCameraRecordedState &State);
+};
+
+/**
+ * Recording Writer
+ *
+ * Writes frames to a binary stream as they happen. Each value is stored as
+ * the bits that changed since the previous frame, so anything holding still
+ * costs a bit in its group's mask, and a small move only the bytes it touched.
+ * Values are kept exactly, so a replay sees the same numbers the game did.
+ * Frames are buffered and written out in blocks
+ */
+class EXTENDEDCAMERA_API FExtendedCameraRecordingWriter
+{
+public:
+    static constexpr uint32 Magic = 0x53524345; // "ECRS"
+    static constexpr uint32 Version = 1;
+
+    ~FExtendedCameraRecordingWriter();
+
+    // Create Filename and write the header. False if the file couldn't be opened
+    bool Open(const FString &Filename, const FExtendedCameraRecordedState &State);
+
+    // Write out anything buffered and close the file
+    void Close();
+
+    bool IsOpen() const;
+
+    void WriteFrame(const FExtendedCameraRecordedFrame &Frame);
+
+    int32 GetNumFrames() const;
+
+private:
+    // Bytes buffered before they're written out
+    static constexpr int32 FlushSize = 64 * 1024;
+
+    void Flush();
+
+    TUniquePtr<FArchive> File;
+    TArray<uint8> Pending;
+    FExtendedCameraRecordedFrame Previous;
+    int32 NumFrames = 0;
+};
+
+/**
+ * Recording Reader
+ *
+ * Reads a stream written by FExtendedCameraRecordingWriter back a frame at a
+ * time, without loading the whole file
+ */
+class EXTENDEDCAMERA_API FExtendedCameraRecordingReader
+{
+public:
+    // False if the file couldn't be opened, or isn't a recording this version can read
+    bool Open(const FString &Filename, FExtendedCameraRecordedState &OutState);
+
+    void Close();
+
+    // False at the end of the stream, or if it's damaged
+    bool ReadFrame(FExtendedCameraRecordedFrame &OutFrame);
+
+private:
+    TUniquePtr<FArchive> File;
+    FExtendedCameraRecordedFrame Previous;
+};
+
+/**
+ * Recording Player
+ *
+ * Feeds a recording back through a camera's tracking, blend, LOS response and
+ * smooth return, one frame per Step. The camera needs no world or owner, only
+ * the settings it was recorded with, so a duplicate or the archetype of the
+ * recorded camera will do. Nothing is traced, the recorded hits are applied
+ */
+class EXTENDEDCAMERA_API FExtendedCameraRecordingPlayer
+{
+public:
+    // Open Filename and put Camera in the state recording started from
+    bool Open(const FString &Filename, UExtendedCameraComponent &Camera);
+
+    // Evaluate the next frame on Camera. False at the end of the recording
+    bool Step(UExtendedCameraComponent &Camera, FMinimalViewInfo &OutView);
+
+    // Frames stepped so far
+    int32 GetFrameNumber() const;
+
+private:
+    FExtendedCameraRecordingReader Reader;
+    FExtendedCameraRecordedFrame Frame;
+    int32 FrameNumber = 0;
+};
@@ -0,0 +1,270 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExtendedCameraComponent.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+
+#include "ExtendedCameraSubsystem.generated.h"
+
+class UExtendedCameraComponent;
+
+/**
+ * Batched Camera Data
+ *
+ * Structure-of-arrays view of every batched camera's blend inputs. Per-camera
+ * arrays are indexed by camera, per-track arrays are track-major so each track
+ * layer is one contiguous run across all cameras
+ */
+struct FExtendedCameraBatch
+{
+    int32 NumCameras = 0;
+    int32 NumLayers = 0;
+
+    // Per camera. Positions keep full precision for large worlds
+    TArray<FVector::FReal> OwnerX, OwnerY, OwnerZ;
+    TArray<FVector::FReal> ViewX, ViewY, ViewZ;
+    TArray<float> ViewFOV;
+    TArray<float> FallbackFOV;
+
+    // Per camera view rotation. Euler blending cameras use the angles, quaternion blending ones the quaternion
+    TArray<uint8> RotationBlend;
+    TArray<float> ViewPitch, ViewYaw, ViewRoll;
+    TArray<FQuat::FReal> ViewQX, ViewQY, ViewQZ, ViewQW;
+
+    // Per track, Layer * NumCameras + Camera. Rotations as the track's transform holds them
+    TArray<FVector::FReal> TrackX, TrackY, TrackZ;
+    TArray<FQuat::FReal> TrackQX, TrackQY, TrackQZ, TrackQW;
+    TArray<float> TrackFOV;
+    TArray<float> TrackOffsetFOV;
+    TArray<float> TrackAlpha;
+    TArray<float> DollyReferenceDistance;
+    TArray<uint8> DollyEnabled;
+    TArray<uint8> DollyLiveUpdate;
+
+    // One layer's dolly zooming tracks, packed for the batched zoom
+    TArray<int32> DollyIndex;
+    TArray<float> DollyReference;
+    TArray<float> DollyFOV;
+    TArray<float> DollyDistance;
+
+    void Reset(int32 InNumCameras, int32 InNumLayers);
+};
+
+/**
+ * Batched Line of Sight Query
+ *
+ * One camera's LOS trace, or one of its visibility probe rays, for the frame.
+ * Everything the trace reads is copied in so the queries can be traced on any
+ * thread
+ */
+struct FExtendedCameraLOSQuery
+{
+    UExtendedCameraComponent *Camera = nullptr;
+
+    // Index into the camera's visibility probes, or none for its LOS trace
+    int32 Probe = INDEX_NONE;
+
+    FVector Start = FVector::ZeroVector;
+    FVector End = FVector::ZeroVector;
+    ECollisionChannel Channel = ECC_Camera;
+    FCollisionShape Shape;
+    FCollisionQueryParams Params;
+    FHitResult Hit;
+
+    // What the trace took, charged to the camera for the schedule's estimates
+    uint64 Cycles = 0;
+};
+
+/**
+ * Scheduled Camera Work
+ *
+ * One piece of a camera's per-frame work the subsystem's schedule can hold
+ * back to a later frame
+ */
+enum class EExtendedCameraWork : uint8
+{
+    BoneResolution,
+    LineOfSight,
+};
+
+struct FExtendedCameraScheduledWork
+{
+    UExtendedCameraComponent *Camera = nullptr;
+    EExtendedCameraWork Work = EExtendedCameraWork::LineOfSight;
+
+    // The camera's tier ranked as a significance, plus the frames the work has waited
+    float Priority = 0.f;
+};
+
+/**
+ * Extended Camera Subsystem
+ *
+ * Keeps track of every extended camera in the world. Cameras using batched
+ * evaluation are tracked and blended here once per frame, before the camera
+ * managers update, and GetCameraView only reads back the result.
+ *
+ * Cameras using significance are ranked here too, and the time every camera
+ * takes is held to SignificanceBudget by lowering their tiers.
+ *
+ * With a ScheduleBudget, LOS traces and bone lookups are granted each frame
+ * in priority order until the budget is spent, and the rest wait for a later
+ * frame. Settings are read from [/Script/ExtendedCamera.ExtendedCameraSubsystem]
+ * in Game.ini
+ */
+UCLASS(Config = Game)
+class EXTENDEDCAMERA_API UExtendedCameraSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UExtendedCameraSubsystem();
+
+    virtual void RegisterCamera(UExtendedCameraComponent *Camera);
+    virtual void UnregisterCamera(UExtendedCameraComponent *Camera);
+
+    // Add a camera to, or take it off, the world's significance manager
+    virtual void RegisterSignificance(UExtendedCameraComponent *Camera);
+    virtual void UnregisterSignificance(UExtendedCameraComponent *Camera);
+
+    // Count time spent on cameras this frame against the budget
+    void AddCameraTime(uint64 Cycles);
+
+    // True if LOS traces and bone lookups only run when this frame's schedule grants them
+    bool IsScheduling() const;
+
+    // Change the schedule's budget at runtime, such as from scalability settings. Zero turns it off
+    UFUNCTION(BlueprintCallable, Category = "Extended Camera|Performance")
+    void SetScheduleBudget(float Microseconds, int32 MaxDeferredFrames = 8);
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+protected:
+    virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+    // Run tracking for every parallel or batched camera, native ones across workers
+    virtual void TrackCameras(float DeltaTime);
+
+    // Pull every batched camera's tracks into the batch
+    virtual void GatherBatch(float DeltaTime);
+
+    // Blend every layer across all cameras
+    virtual void EvaluateBatch();
+
+    // Hand the results back to the cameras
+    virtual void ScatterBatch();
+
+    // Trace every batched camera's LOS at once and hand the hits back
+    virtual void TraceBatch();
+
+    // Gather what the significance function reads, and update the significance manager from the local players
+    virtual void UpdateSignificance();
+
+    // Lower or raise tiers to bring last frame's camera time back under budget
+    virtual void UpdateBudget();
+
+    // Queue every camera's LOS and bone lookups for this frame and grant them until ScheduleBudget is spent
+    virtual void ScheduleWork();
+
+    // Significance for one viewpoint. Higher is more significant, and the best of the viewpoints is taken
+    float GetCameraSignificance(const UExtendedCameraComponent &Camera, const FTransform &Viewpoint) const;
+
+    // Turn a significance back into a tier, lowered by the budget, and hand it to the camera
+    void ApplySignificance(UExtendedCameraComponent &Camera, float Significance) const;
+
+    ///// ///// ////////// ///// /////
+    // Significance Settings
+    //
+
+    // Microseconds per frame every extended camera in the world may take together. Zero turns the budget off
+    UPROPERTY(Config)
+    float SignificanceBudget;
+
+    // Frames between tier changes made for the budget, so it settles rather than oscillating
+    UPROPERTY(Config)
+    int32 SignificanceBudgetFrames;
+
+    // Captured cameras drop a tier beyond each of these distances from the nearest player
+    UPROPERTY(Config)
+    float SignificanceReducedDistance;
+
+    UPROPERTY(Config)
+    float SignificanceMinimalDistance;
+
+    // Captured cameras with fewer pixels than this start at Reduced rather than Full
+    UPROPERTY(Config)
+    int32 SignificanceFullResolution;
+
+    // What each tier runs, in EExtendedCameraSignificance order
+    UPROPERTY(Config)
+    TArray<FExtendedCameraSignificanceTier> SignificanceTiers;
+
+    // Update the significance manager from the local players' views. Turn off if the game updates it itself
+    UPROPERTY(Config)
+    bool UpdateSignificanceManager;
+
+    ///// ///// ////////// ///// /////
+    // Schedule Settings
+    //
+
+    /**
+     * Schedule Budget
+     *
+     * Microseconds per frame of LOS traces and bone lookups, across every
+     * extended camera in the world. Work over it waits for a later frame,
+     * reusing the last LOS hit and the last resolved bones meanwhile. View
+     * targets are always granted. Zero turns the schedule off
+     */
+    UPROPERTY(Config)
+    float ScheduleBudget;
+
+    // Frames work may wait before it's granted regardless of the budget
+    UPROPERTY(Config)
+    int32 ScheduleMaxDeferredFrames;
+
+    ///// ///// ////////// ///// /////
+    // Schedule State
+    //
+
+    // This frame's work, as a heap on priority. Kept to avoid the allocation
+    TArray<FExtendedCameraScheduledWork> ScheduledWork;
+
+    // Running averages of what granted work has taken, used as its cost
+    double AverageLineOfSightMicroseconds;
+    double AverageBoneResolutionMicroseconds;
+
+    ///// ///// ////////// ///// /////
+    // Significance State
+    //
+
+    // This frame's local player views, and what they're viewing
+    TArray<FTransform> Viewpoints;
+    TArray<const AActor *> ViewTargets;
+
+    // Camera time so far this frame, and a running average of the frames before
+    uint64 CameraCycles;
+    double AverageCameraMicroseconds;
+
+    // Tiers every ranked camera outside the view targets is lowered by
+    int32 SignificanceBias;
+    int32 FramesSinceBiasChange;
+
+    UPROPERTY(Transient)
+    TArray<UExtendedCameraComponent *> Cameras;
+
+    // Cameras in this frame's batch, in batch order
+    UPROPERTY(Transient)
+    TArray<UExtendedCameraComponent *> BatchedCameras;
+
+    // This frame's tracking split. Rebuilt every tick, kept to avoid the allocation
+    TArray<UExtendedCameraComponent *> ParallelTrackedCameras;
+    TArray<UExtendedCameraComponent *> SerialTrackedCameras;
+
+    FExtendedCameraBatch Batch;
+
+    // This frame's LOS traces. Rebuilt every tick, kept to avoid the allocation
+    TArray<FExtendedCameraLOSQuery> LOSQueries;
+};
@@ -0,0 +1,26 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class ExtendedCameraTests: ModuleRules
+{
+	public ExtendedCameraTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"ExtendedCamera",
+				"Json",
+				"LevelSequence",
+				"MovieScene",
+				"MovieSceneTracks",
+				"Projects",
+			}
+			);
+	}
+}
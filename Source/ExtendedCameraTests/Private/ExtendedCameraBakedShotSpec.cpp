@@ -0,0 +1,227 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#include "Channels/MovieSceneDoubleChannel.h"
+#include "ExtendedCameraBakedShot.h"
+#include "ExtendedCameraComponent.h"
+#include "ExtendedCameraRecording.h"
+#include "ExtendedCameraTestWorld.h"
+#include "HAL/FileManager.h"
+#include "LevelSequence.h"
+#include "LevelSequenceActor.h"
+#include "LevelSequencePlayer.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "MovieScene.h"
+#include "Sections/MovieScene3DTransformSection.h"
+#include "Tracks/MovieScene3DTransformTrack.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FExtendedCameraBakedShotSpec, "ExtendedCamera.BakedShot",
+                  EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+static constexpr float DeltaTime = 1.f / 60.f;
+static constexpr float SampleRate = 10.f;
+
+// Two keys a second apart, nowhere near the live view
+UExtendedCameraBakedShot *MakeShot(const UExtendedCameraComponent *Camera);
+
+// The sequence moves the locator this far over this many seconds
+static constexpr double ShotDuration = 1.0;
+inline static const FVector ShotOffset = FVector(0.0, 500.0, 0.0);
+
+// A player for a sequence that slides Locator along ShotOffset
+ULevelSequencePlayer *MakeLocatorPlayer(FExtendedCameraTestWorld &TestWorld, AActor *Locator);
+
+END_DEFINE_SPEC(FExtendedCameraBakedShotSpec)
+
+void FExtendedCameraBakedShotSpec::Define()
+{
+    It("should play back between keys while the bindings match", [this]() {
+        FExtendedCameraTestWorld TestWorld;
+        const auto Track = TestWorld.SpawnTrack(EExtendedCameraDriverMode::LocAndAim);
+        auto Camera = TestWorld.SpawnCamera(FVector::ZeroVector);
+        Camera->SetCameraTrack(0, Track);
+        Camera->SetBakedShot(MakeShot(Camera));
+        Camera->BakedShotTime = 0.05f;
+
+        TestWorld.Step(DeltaTime);
+        const auto View = FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+        TestEqual(TEXT("Location"), View.Location, FVector(5000.0, 0.0, 0.0), 0.01f);
+        TestEqual(TEXT("Rotation"), View.Rotation, FRotator(0.0, 45.0, 0.0), 0.01f);
+        TestEqual(TEXT("FOV"), View.FOV, 60.f, 0.01f);
+    });
+
+    It("should bake the views the camera evaluates live, and put the player and camera back", [this]() {
+        FExtendedCameraTestWorld TestWorld;
+        const auto Track = TestWorld.SpawnTrack(EExtendedCameraDriverMode::LocAndAim);
+        auto Camera = TestWorld.SpawnCamera(FVector::ZeroVector);
+        Camera->SetCameraTrack(0, Track);
+
+        auto Player = MakeLocatorPlayer(TestWorld, Track.Locator);
+        if (!TestNotNull(TEXT("Player"), Player))
+        {
+            return;
+        }
+
+        // Part way through the shot, and recording, when the bake is asked for
+        const double PlayerTime = ShotDuration * 0.5;
+        Player->SetPlaybackPosition(FMovieSceneSequencePlaybackParams(float(PlayerTime), EUpdatePositionMethod::Jump));
+        TestWorld.Step(DeltaTime);
+        const auto ViewBefore = FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+        const auto LocatorBefore = Track.Locator->GetActorLocation();
+
+        const auto Filename = FPaths::ConvertRelativePathToFull(
+            FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("ExtendedCameraBakedShot.bin")));
+        if (!TestTrue(TEXT("Recording started"), Camera->StartRecording(Filename)))
+        {
+            return;
+        }
+
+        auto Shot = NewObject<UExtendedCameraBakedShot>(GetTransientPackage());
+        if (!TestTrue(TEXT("Baked"), Camera->BakeShot(Player, Shot, SampleRate)))
+        {
+            Camera->StopRecording();
+            IFileManager::Get().Delete(*Filename);
+            return;
+        }
+
+        TestEqual(TEXT("Player time"), Player->GetCurrentTime().AsSeconds(), PlayerTime, 0.001);
+        TestEqual(TEXT("Locator"), Track.Locator->GetActorLocation(), LocatorBefore, 0.01);
+        TestTrue(TEXT("Still recording"), Camera->IsRecording());
+        TestEqual(TEXT("Bindings"), Shot->GetBindingsSignature(), Camera->GetBindingsSignature());
+
+        // The camera carries on from where it was before the bake
+        TestWorld.Step(DeltaTime);
+        const auto ViewAfter = FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+        TestEqual(TEXT("Location after"), ViewAfter.Location, ViewBefore.Location, 0.01f);
+        TestEqual(TEXT("Rotation after"), ViewAfter.Rotation, ViewBefore.Rotation, 0.01f);
+        TestEqual(TEXT("FOV after"), ViewAfter.FOV, ViewBefore.FOV, 0.01f);
+
+        // Only that frame was recorded, not the bake's
+        Camera->StopRecording();
+        {
+            auto Replay = NewObject<UExtendedCameraComponent>(GetTransientPackage());
+            auto ReplayTrack = Track;
+            ReplayTrack.Locator = nullptr;
+            ReplayTrack.Aim = nullptr;
+            Replay->SetCameraTrack(0, ReplayTrack);
+
+            FExtendedCameraRecordingPlayer Recording;
+            int32 RecordedFrames = 0;
+            FMinimalViewInfo View;
+            if (TestTrue(TEXT("Recording opened"), Recording.Open(Filename, *Replay)))
+            {
+                while (Recording.Step(*Replay, View))
+                {
+                    ++RecordedFrames;
+                }
+            }
+            TestEqual(TEXT("Recorded frames"), RecordedFrames, 1);
+        }
+        IFileManager::Get().Delete(*Filename);
+
+        // Each key is what the camera shows live at that point in the shot, to within compression
+        const int32 NumKeys = FMath::FloorToInt(ShotDuration * SampleRate) + 1;
+        for (int32 Key = 0; Key < NumKeys; ++Key)
+        {
+            const float Time = Key / SampleRate;
+            Player->SetPlaybackPosition(FMovieSceneSequencePlaybackParams(Time, EUpdatePositionMethod::Jump));
+            TestWorld.Step(1.f / SampleRate);
+            const auto Live = FExtendedCameraTestWorld::Evaluate(Camera, 1.f / SampleRate);
+
+            FMinimalViewInfo Baked;
+            const auto What = FString::Printf(TEXT("Key %d"), Key);
+            if (!TestTrue(What + TEXT(" baked"), Shot->Evaluate(Time, Baked)) ||
+                !TestEqual(What + TEXT(" location"), Baked.Location, Live.Location, 0.2f) ||
+                !TestEqual(What + TEXT(" rotation"), Baked.Rotation, Live.Rotation, 0.1f) ||
+                !TestEqual(What + TEXT(" FOV"), Baked.FOV, Live.FOV, 0.1f))
+            {
+                return;
+            }
+        }
+    });
+
+    It("should evaluate live once a track is rebound", [this]() {
+        AddExpectedError(TEXT("Evaluating live"), EAutomationExpectedErrorFlags::Contains, 1);
+
+        FExtendedCameraTestWorld TestWorld;
+        const auto Track = TestWorld.SpawnTrack(EExtendedCameraDriverMode::LocAndAim);
+        auto Camera = TestWorld.SpawnCamera(FVector::ZeroVector);
+        Camera->SetCameraTrack(0, Track);
+        Camera->SetBakedShot(MakeShot(Camera));
+
+        const auto Locator = TestWorld.SpawnTarget(ExtendedCameraTestScene::TrackLocation);
+        Camera->SetCameraTrackLocatorAndAim(0, Locator, NAME_None, Track.Aim, NAME_None);
+
+        FVector ExpectedLocation;
+        FRotator ExpectedRotation;
+        float ExpectedFOV;
+        ExtendedCameraTestScene::GetExpectedView(Track, ExpectedLocation, ExpectedRotation, ExpectedFOV);
+
+        TestWorld.Step(DeltaTime);
+        const auto View = FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+        TestEqual(TEXT("Location"), View.Location, ExpectedLocation, 0.01f);
+    });
+}
+
+UExtendedCameraBakedShot *FExtendedCameraBakedShotSpec::MakeShot(const UExtendedCameraComponent *Camera)
+{
+    auto Shot = NewObject<UExtendedCameraBakedShot>(GetTransientPackage());
+    Shot->Reset(SampleRate, Camera->GetBindingsSignature());
+
+    FMinimalViewInfo View;
+    View.Location = FVector(0.0, 0.0, 0.0);
+    View.Rotation = FRotator(0.0, 0.0, 0.0);
+    View.FOV = 40.f;
+    Shot->AddKey(View);
+
+    View.Location = FVector(10000.0, 0.0, 0.0);
+    View.Rotation = FRotator(0.0, 90.0, 0.0);
+    View.FOV = 80.f;
+    Shot->AddKey(View);
+
+    Shot->Compress();
+    return Shot;
+}
+
+ULevelSequencePlayer *FExtendedCameraBakedShotSpec::MakeLocatorPlayer(FExtendedCameraTestWorld &TestWorld,
+                                                                      AActor *Locator)
+{
+    auto Sequence = NewObject<ULevelSequence>(GetTransientPackage());
+    Sequence->Initialize();
+
+    auto MovieScene = Sequence->GetMovieScene();
+    const auto End = MovieScene->GetTickResolution().AsFrameNumber(ShotDuration);
+    MovieScene->SetPlaybackRange(TRange<FFrameNumber>(FFrameNumber(0), End));
+
+    const auto Binding = MovieScene->AddPossessable(Locator->GetName(), Locator->GetClass());
+    Sequence->BindPossessableObject(Binding, *Locator, TestWorld.GetWorld());
+
+    auto TransformTrack = MovieScene->AddTrack<UMovieScene3DTransformTrack>(Binding);
+    auto Section = CastChecked<UMovieScene3DTransformSection>(TransformTrack->CreateNewSection());
+    Section->SetRange(TRange<FFrameNumber>::All());
+    TransformTrack->AddSection(*Section);
+
+    // Location, rotation and scale, three channels each
+    const auto Channels = Section->GetChannelProxy().GetChannels<FMovieSceneDoubleChannel>();
+    const auto Transform = Locator->GetActorTransform();
+    const auto Rotation = Transform.Rotator();
+    const FVector Start = Transform.GetLocation();
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        Channels[Axis]->AddLinearKey(FFrameNumber(0), Start[Axis]);
+        Channels[Axis]->AddLinearKey(End, Start[Axis] + ShotOffset[Axis]);
+        Channels[Axis + 6]->SetDefault(Transform.GetScale3D()[Axis]);
+    }
+    Channels[3]->SetDefault(Rotation.Roll);
+    Channels[4]->SetDefault(Rotation.Pitch);
+    Channels[5]->SetDefault(Rotation.Yaw);
+
+    ALevelSequenceActor *SequenceActor = nullptr;
+    return ULevelSequencePlayer::CreateLevelSequencePlayer(TestWorld.GetWorld(), Sequence,
+                                                           FMovieSceneSequencePlaybackSettings(), SequenceActor);
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
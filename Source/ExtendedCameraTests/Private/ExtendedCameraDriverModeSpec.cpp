@@ -0,0 +1,147 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#include "ExtendedCameraComponent.h"
+#include "ExtendedCameraTestWorld.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FExtendedCameraDriverModeSpec, "ExtendedCamera.DriverModes",
+                  EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+static constexpr int32 NumFrames = 3;
+static constexpr float DeltaTime = 1.f / 60.f;
+
+/**
+ * Test Driver Mode
+ *
+ * Checks every camera reading the shared scene's track for Mode lands on the
+ * expected view, frame after frame. With MissingBones, bone driven tracks
+ * look for a bone the mannequin doesn't have
+ */
+void TestDriverMode(EExtendedCameraDriverMode Mode, bool MissingBones = false);
+
+END_DEFINE_SPEC(FExtendedCameraDriverModeSpec)
+
+void FExtendedCameraDriverModeSpec::Define()
+{
+    const auto Enum = StaticEnum<EExtendedCameraDriverMode>();
+
+    for (int32 Mode = 0; Mode < EExtendedCameraDriverMode::TOTAL_CAMERA_DRIVER_MODES; ++Mode)
+    {
+        const auto DriverMode = EExtendedCameraDriverMode(Mode);
+        It(FString::Printf(TEXT("should produce the expected view in %s"), *Enum->GetNameStringByValue(Mode)),
+           [this, DriverMode]() { TestDriverMode(DriverMode); });
+    }
+
+    Describe("with a bone the mesh doesn't have", [this, Enum]() {
+        const EExtendedCameraDriverMode BoneModes[] = {EExtendedCameraDriverMode::Skeleton,
+                                                       EExtendedCameraDriverMode::SkeletonLocator,
+                                                       EExtendedCameraDriverMode::SkeletonAim};
+
+        for (const auto DriverMode : BoneModes)
+        {
+            It(FString::Printf(TEXT("should fall back to the actor in %s"), *Enum->GetNameStringByValue(DriverMode)),
+               [this, DriverMode]() { TestDriverMode(DriverMode, true); });
+        }
+    });
+
+    It("should evaluate the named track properties Sequencer keys, and write the track back to them", [this]() {
+        FExtendedCameraTestWorld TestWorld;
+        const auto Track = TestWorld.SpawnTrack(EExtendedCameraDriverMode::DataDriven);
+        auto Camera = TestWorld.SpawnCamera(FVector::ZeroVector);
+
+        // Sequencer and Blueprint reach them by name, through reflection
+        const auto FindValue = [Camera](const TCHAR *Name) {
+            const auto Property = FindFProperty<FProperty>(UExtendedCameraComponent::StaticClass(), Name);
+            return Property ? Property->ContainerPtrToValuePtr<void>(Camera) : nullptr;
+        };
+
+        const auto DriverMode = static_cast<TEnumAsByte<EExtendedCameraDriverMode> *>(
+            FindValue(TEXT("FirstTrackCameraDriverMode")));
+        const auto Transform = static_cast<FTransform *>(FindValue(TEXT("PrimaryTrackTransform")));
+        const auto FOV = static_cast<float *>(FindValue(TEXT("PrimaryTrackFOV")));
+        const auto Alpha = static_cast<float *>(FindValue(TEXT("CameraPrimaryTrackBlendAlpha")));
+        if (!TestTrue(TEXT("Named track properties exist"), DriverMode && Transform && FOV && Alpha))
+        {
+            return;
+        }
+
+        *DriverMode = Track.DriverMode;
+        *Transform = Track.Transform;
+        *FOV = Track.FOV;
+        *Alpha = Track.BlendAlpha;
+
+        TestWorld.Step(DeltaTime);
+        const auto View = FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+
+        FVector ExpectedLocation;
+        FRotator ExpectedRotation;
+        float ExpectedFOV;
+        ExtendedCameraTestScene::GetExpectedView(Track, ExpectedLocation, ExpectedRotation, ExpectedFOV);
+        TestEqual(TEXT("Location"), View.Location, ExpectedLocation, 0.01f);
+        TestEqual(TEXT("Rotation"), View.Rotation, ExpectedRotation, 0.01f);
+        TestEqual(TEXT("FOV"), View.FOV, ExpectedFOV, 0.01f);
+
+        // Writes through the track API show up under the old names once the camera has been evaluated
+        Camera->SetPrimaryCameraTrackAlpha(0.5f);
+        TestWorld.Step(DeltaTime);
+        FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+        TestEqual(TEXT("Alpha written back"), *Alpha, 0.5f);
+    });
+}
+
+void FExtendedCameraDriverModeSpec::TestDriverMode(EExtendedCameraDriverMode Mode, bool MissingBones)
+{
+    if (!ExtendedCameraTestScene::CanSpawnTrack(*this, Mode))
+    {
+        return;
+    }
+
+    FExtendedCameraTestWorld TestWorld;
+
+    // Every camera reads the same targets from a different place
+    auto Track = TestWorld.SpawnTrack(Mode);
+    if (MissingBones)
+    {
+        // Each camera's tracks warn once, when they first look for the bone
+        AddExpectedError(TEXT("Invalid Bone Name"), EAutomationExpectedErrorFlags::Contains, 0);
+        Track.LocatorBoneName = ExtendedCameraTestScene::MissingBoneName;
+        Track.AimBoneName = ExtendedCameraTestScene::MissingBoneName;
+    }
+
+    TArray<UExtendedCameraComponent *> Cameras;
+    for (int32 Index = 0; Index < GetExtendedCameraTestCount(); ++Index)
+    {
+        auto Camera = TestWorld.SpawnCamera(FVector(0.0, Index * 400.0, 0.0));
+        Camera->SetCameraTrack(0, Track);
+        Cameras.Add(Camera);
+    }
+
+    // Every frame after the first reads the bones back from the cache
+    for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        TestWorld.Step(DeltaTime);
+
+        FVector ExpectedLocation;
+        FRotator ExpectedRotation;
+        float ExpectedFOV;
+        ExtendedCameraTestScene::GetExpectedView(Track, ExpectedLocation, ExpectedRotation, ExpectedFOV);
+
+        for (int32 Index = 0; Index < Cameras.Num(); ++Index)
+        {
+            const auto View = FExtendedCameraTestWorld::Evaluate(Cameras[Index], DeltaTime);
+            const auto What = FString::Printf(TEXT("Frame %d, camera %d"), Frame, Index);
+
+            // One report per case is enough to see what went wrong
+            if (!TestEqual(What + TEXT(" location"), View.Location, ExpectedLocation, 0.01f) ||
+                !TestEqual(What + TEXT(" rotation"), View.Rotation, ExpectedRotation, 0.01f) ||
+                !TestEqual(What + TEXT(" FOV"), View.FOV, ExpectedFOV, 0.01f))
+            {
+                return;
+            }
+        }
+    }
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,213 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#include "ExtendedCameraComponent.h"
+#include "ExtendedCameraTestWorld.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FExtendedCameraLineOfSightSpec, "ExtendedCamera.LineOfSight",
+                  EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+static constexpr int32 NumFrames = 2;
+static constexpr float DeltaTime = 1.f / 60.f;
+
+// Each camera sits this far behind its owner, with a wall in between
+static constexpr double CameraDistance = 400.0;
+static constexpr double WallDistance = 200.0;
+static constexpr double WallHalfThickness = 10.0;
+static constexpr double WallHalfHeight = 200.0;
+static constexpr double CameraSpacing = 400.0;
+
+/**
+ * Test Line of Sight
+ *
+ * Spawns the cameras and the wall, and checks every camera ends up on the
+ * owner's side of the wall when ExpectBlocked, or where its track put it.
+ * SetUp changes how each camera traces
+ */
+void TestLineOfSight(EExtendedCameraMode Mode, bool FacingOwner, bool ExpectBlocked,
+                     const TArray<FVector> &ProbeOffsets = TArray<FVector>(),
+                     TFunction<void(UExtendedCameraComponent *)> SetUp = nullptr);
+
+END_DEFINE_SPEC(FExtendedCameraLineOfSightSpec)
+
+void FExtendedCameraLineOfSightSpec::Define()
+{
+    Describe("with the owner in frame", [this]() {
+        It("should ignore the wall in Ignore", [this]() { TestLineOfSight(EExtendedCameraMode::Ignore, true, false); });
+        It("should pull in front of the wall in KeepLos",
+           [this]() { TestLineOfSight(EExtendedCameraMode::KeepLos, true, true); });
+        It("should pull in front of the wall in KeepLosNoDot",
+           [this]() { TestLineOfSight(EExtendedCameraMode::KeepLosNoDot, true, true); });
+        It("should pull in front of the wall in KeepLosWithinLimit",
+           [this]() { TestLineOfSight(EExtendedCameraMode::KeepLosWithinLimit, true, true); });
+        It("should pull in front of the wall in KeepLosPartial",
+           [this]() { TestLineOfSight(EExtendedCameraMode::KeepLosPartial, true, true); });
+    });
+
+    Describe("with the owner behind the camera", [this]() {
+        It("should ignore the wall in Ignore",
+           [this]() { TestLineOfSight(EExtendedCameraMode::Ignore, false, false); });
+        It("should ignore the wall in KeepLos",
+           [this]() { TestLineOfSight(EExtendedCameraMode::KeepLos, false, false); });
+        It("should pull in front of the wall in KeepLosNoDot",
+           [this]() { TestLineOfSight(EExtendedCameraMode::KeepLosNoDot, false, true); });
+        It("should ignore the wall in KeepLosWithinLimit",
+           [this]() { TestLineOfSight(EExtendedCameraMode::KeepLosWithinLimit, false, false); });
+        It("should pull in front of the wall in KeepLosPartial",
+           [this]() { TestLineOfSight(EExtendedCameraMode::KeepLosPartial, false, true); });
+    });
+
+    Describe("with a probe seen over the wall", [this]() {
+        // Half the probes are visible, which meets the default threshold
+        It("should leave the camera behind the wall in KeepLosPartial", [this]() {
+            TestLineOfSight(EExtendedCameraMode::KeepLosPartial, true, false,
+                            {FVector::ZeroVector, FVector(0.0, 0.0, 500.0)});
+        });
+    });
+
+    Describe("with the aim clear and the probes blocked", [this]() {
+        It("should pull in to the nearest blocked probe in KeepLosPartial", [this]() {
+            FExtendedCameraTestWorld TestWorld;
+
+            // The wall stands to one side, off the aim but across the probe's view
+            const FVector ProbeOffset(0.0, 300.0, 0.0);
+            TestWorld.SpawnBlocker(FVector(-WallDistance, ProbeOffset.Y, 0.0),
+                                   FVector(WallHalfThickness, WallHalfHeight, WallHalfHeight));
+
+            const FVector TrackLocation(-CameraDistance, 0.0, 0.0);
+            auto Camera = TestWorld.SpawnCamera(FVector::ZeroVector);
+            Camera->SetCameraMode(EExtendedCameraMode::KeepLosPartial);
+            Camera->SetCameraTrackMode(0, EExtendedCameraDriverMode::DataDriven);
+            Camera->SetCameraTrackAlpha(0, 1.f);
+            Camera->SetCameraTrackTransform(0, FTransform(FRotator::ZeroRotator, TrackLocation), 0.f);
+            Camera->SetVisibilityProbes(TArray<FName>(), {ProbeOffset});
+            Camera->SetVisibilityThreshold(0.5f, 8);
+
+            // Where the probe's line to the camera meets the wall's near face
+            const double HitTime = (WallDistance - WallHalfThickness) / CameraDistance;
+            const auto ExpectedLocation = FMath::Lerp(ProbeOffset, TrackLocation, HitTime);
+
+            for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+            {
+                TestWorld.Step(DeltaTime);
+
+                const auto View = FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+                if (!TestEqual(FString::Printf(TEXT("Frame %d location"), Frame), View.Location, ExpectedLocation,
+                               0.1f))
+                {
+                    return;
+                }
+            }
+        });
+    });
+
+    Describe("with incremental evaluation", [this]() {
+        It("should see a wall move in front of an idle camera straight away", [this]() {
+            FExtendedCameraTestWorld TestWorld;
+
+            auto Camera = TestWorld.SpawnCamera(FVector::ZeroVector);
+            Camera->SetCameraMode(EExtendedCameraMode::KeepLosNoDot);
+            Camera->SetCameraTrackMode(0, EExtendedCameraDriverMode::DataDriven);
+            Camera->SetCameraTrackAlpha(0, 1.f);
+            Camera->SetCameraTrackTransform(0, FTransform(FRotator::ZeroRotator, FVector(-CameraDistance, 0.0, 0.0)),
+                                            0.f);
+            Camera->SetUseIncrementalEvaluation(true, 1000);
+
+            // Long enough for the view to go idle
+            for (int32 Frame = 0; Frame < 4; ++Frame)
+            {
+                TestWorld.Step(DeltaTime);
+                FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+            }
+
+            TestWorld.SpawnBlocker(FVector(-WallDistance, 0.0, 0.0),
+                                   FVector(WallHalfThickness, WallHalfHeight, WallHalfHeight));
+            TestWorld.Step(DeltaTime);
+
+            const auto View = FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+            TestEqual(TEXT("Pulled in front of the wall"), View.Location,
+                      FVector(-(WallDistance - WallHalfThickness), 0.0, 0.0), 0.1f);
+        });
+    });
+
+    Describe("with probes traced away from the camera", [this]() {
+        It("should pull in front of the wall when the subsystem traces them", [this]() {
+            TestLineOfSight(EExtendedCameraMode::KeepLosPartial, true, true, TArray<FVector>(),
+                            [](UExtendedCameraComponent *Camera) {
+                                Camera->SetUseBatchedEvaluation(true);
+                                Camera->SetUseBatchedLineOfSight(true);
+                            });
+        });
+        It("should pull in front of the wall when they're traced async", [this]() {
+            TestLineOfSight(EExtendedCameraMode::KeepLosPartial, true, true, TArray<FVector>(),
+                            [](UExtendedCameraComponent *Camera) { Camera->SetUseAsyncLineOfSight(true); });
+        });
+        It("should pull in front of the wall when they're cached", [this]() {
+            TestLineOfSight(EExtendedCameraMode::KeepLosPartial, true, true, TArray<FVector>(),
+                            [](UExtendedCameraComponent *Camera) { Camera->SetUseLineOfSightCache(true); });
+        });
+    });
+}
+
+void FExtendedCameraLineOfSightSpec::TestLineOfSight(EExtendedCameraMode Mode, bool FacingOwner, bool ExpectBlocked,
+                                                     const TArray<FVector> &ProbeOffsets,
+                                                     TFunction<void(UExtendedCameraComponent *)> SetUp)
+{
+    FExtendedCameraTestWorld TestWorld;
+
+    // One wall, long enough for every camera
+    const int32 NumCameras = GetExtendedCameraTestCount();
+    const double WallHalfLength = NumCameras * CameraSpacing * 0.5 + CameraSpacing;
+    TestWorld.SpawnBlocker(FVector(-WallDistance, (NumCameras - 1) * CameraSpacing * 0.5, 0.0),
+                           FVector(WallHalfThickness, WallHalfLength, WallHalfHeight));
+
+    const FRotator TrackRotation(0.0, FacingOwner ? 0.0 : 180.0, 0.0);
+
+    TArray<UExtendedCameraComponent *> Cameras;
+    for (int32 Index = 0; Index < NumCameras; ++Index)
+    {
+        const FVector OwnerLocation(0.0, Index * CameraSpacing, 0.0);
+        auto Camera = TestWorld.SpawnCamera(OwnerLocation);
+
+        FExtendedCameraTrack Track;
+        Track.DriverMode = EExtendedCameraDriverMode::DataDriven;
+        Track.BlendAlpha = 1.f;
+        Track.FOV = 90.f;
+        Track.Transform = FTransform(TrackRotation, OwnerLocation - FVector(CameraDistance, 0.0, 0.0));
+
+        Camera->SetCameraTrack(0, Track);
+        Camera->SetCameraMode(Mode);
+        Camera->SetVisibilityProbes(TArray<FName>(), ProbeOffsets);
+        if (SetUp)
+        {
+            SetUp(Camera);
+        }
+        Cameras.Add(Camera);
+    }
+
+    // A line trace stops on the owner's face of the wall
+    const double ExpectedDistance = ExpectBlocked ? WallDistance - WallHalfThickness : CameraDistance;
+
+    for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        TestWorld.Step(DeltaTime);
+
+        for (int32 Index = 0; Index < Cameras.Num(); ++Index)
+        {
+            const auto View = FExtendedCameraTestWorld::Evaluate(Cameras[Index], DeltaTime);
+            const FVector ExpectedLocation(-ExpectedDistance, Index * CameraSpacing, 0.0);
+            const auto What = FString::Printf(TEXT("Frame %d, camera %d"), Frame, Index);
+
+            if (!TestEqual(What + TEXT(" location"), View.Location, ExpectedLocation, 0.1f) ||
+                !TestEqual(What + TEXT(" rotation"), View.Rotation, TrackRotation, 0.01f) ||
+                !TestEqual(What + TEXT(" FOV"), View.FOV, 90.f, 0.01f))
+            {
+                return;
+            }
+        }
+    }
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,98 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#include "ExtendedCameraPerfBaseline.h"
+#include "Dom/JsonObject.h"
+#include "HAL/IConsoleManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+static TAutoConsoleVariable<FString> CVarExtendedCameraBaselineFile(
+    TEXT("ExtendedCamera.Tests.BaselineFile"), TEXT(""),
+    TEXT("Performance baseline for the ExtendedCamera.Performance specs. Empty uses the plugin's own"));
+
+FString FExtendedCameraPerfBaseline::GetFilename()
+{
+    const auto Override = CVarExtendedCameraBaselineFile.GetValueOnGameThread();
+    if (!Override.IsEmpty())
+    {
+        return Override;
+    }
+
+    const auto Plugin = IPluginManager::Get().FindPlugin(TEXT("ExtendedCamera"));
+    const auto BaseDir = Plugin ? Plugin->GetBaseDir() : FPaths::ProjectDir();
+    return FPaths::Combine(BaseDir, TEXT("Config"), TEXT("PerformanceBaseline.json"));
+}
+
+bool FExtendedCameraPerfBaseline::Load()
+{
+    Entries.Reset();
+
+    FString Json;
+    if (!FFileHelper::LoadFileToString(Json, *GetFilename()))
+    {
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> Root;
+    if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid())
+    {
+        return false;
+    }
+
+    const TSharedPtr<FJsonObject> *Baselines = nullptr;
+    if (Root->TryGetObjectField(TEXT("Baselines"), Baselines))
+    {
+        for (const auto &Pair : (*Baselines)->Values)
+        {
+            const auto Case = Pair.Value->AsObject();
+            if (Case.IsValid())
+            {
+                auto &Entry = Entries.Add(Pair.Key);
+                Entry.NumCameras = Case->GetIntegerField(TEXT("Cameras"));
+                Entry.MedianMicroseconds = Case->GetNumberField(TEXT("MedianMicroseconds"));
+            }
+        }
+    }
+
+    return true;
+}
+
+bool FExtendedCameraPerfBaseline::Save() const
+{
+    auto Baselines = MakeShared<FJsonObject>();
+    for (const auto &Pair : Entries)
+    {
+        auto Case = MakeShared<FJsonObject>();
+        Case->SetNumberField(TEXT("Cameras"), Pair.Value.NumCameras);
+        Case->SetNumberField(TEXT("MedianMicroseconds"), Pair.Value.MedianMicroseconds);
+        Baselines->SetObjectField(Pair.Key, Case);
+    }
+
+    auto Root = MakeShared<FJsonObject>();
+    Root->SetObjectField(TEXT("Baselines"), Baselines);
+
+    FString Json;
+    if (!FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Json)))
+    {
+        return false;
+    }
+
+    return FFileHelper::SaveStringToFile(Json, *GetFilename());
+}
+
+double FExtendedCameraPerfBaseline::Find(const FString &Case, int32 NumCameras) const
+{
+    const auto Entry = Entries.Find(Case);
+    return Entry && Entry->NumCameras == NumCameras ? Entry->MedianMicroseconds : -1.0;
+}
+
+void FExtendedCameraPerfBaseline::Set(const FString &Case, int32 NumCameras, double MedianMicroseconds)
+{
+    auto &Entry = Entries.FindOrAdd(Case);
+    Entry.NumCameras = NumCameras;
+    Entry.MedianMicroseconds = MedianMicroseconds;
+}
@@ -0,0 +1,38 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Performance Baseline
+ *
+ * Median frame times per case, as recorded on the machine the suite runs on.
+ * Stored as JSON in the plugin's Config directory, or wherever
+ * ExtendedCamera.Tests.BaselineFile points. A baseline only applies to runs
+ * with the camera count it was recorded with
+ */
+class FExtendedCameraPerfBaseline
+{
+public:
+    static FString GetFilename();
+
+    // False if there was no file, or it couldn't be read
+    bool Load();
+
+    bool Save() const;
+
+    // Stored median in microseconds, or a negative value if there is none for this many cameras
+    double Find(const FString &Case, int32 NumCameras) const;
+
+    void Set(const FString &Case, int32 NumCameras, double MedianMicroseconds);
+
+private:
+    struct FEntry
+    {
+        int32 NumCameras = 0;
+        double MedianMicroseconds = 0.0;
+    };
+
+    TMap<FString, FEntry> Entries;
+};
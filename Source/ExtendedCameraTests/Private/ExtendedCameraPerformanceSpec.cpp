@@ -0,0 +1,146 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#include "ExtendedCameraComponent.h"
+#include "ExtendedCameraPerfBaseline.h"
+#include "ExtendedCameraTestWorld.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static TAutoConsoleVariable<int32> CVarExtendedCameraPerfCameras(
+    TEXT("ExtendedCamera.Tests.PerfCameras"), 64, TEXT("Number of extended cameras each performance case evaluates"));
+
+static TAutoConsoleVariable<int32> CVarExtendedCameraPerfFrames(
+    TEXT("ExtendedCamera.Tests.PerfFrames"), 120, TEXT("Number of frames each performance case measures"));
+
+static TAutoConsoleVariable<float> CVarExtendedCameraPerfMargin(
+    TEXT("ExtendedCamera.Tests.PerfMargin"), 0.25f,
+    TEXT("How far over its baseline a case's median frame time may be before it fails. 0.25 is 25%"));
+
+static TAutoConsoleVariable<bool> CVarExtendedCameraPerfUpdateBaseline(
+    TEXT("ExtendedCamera.Tests.UpdateBaseline"), false,
+    TEXT("Record this run's median frame times as the baseline instead of testing against it"));
+
+BEGIN_DEFINE_SPEC(FExtendedCameraPerformanceSpec, "ExtendedCamera.Performance",
+                  EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+static constexpr int32 WarmupFrames = 10;
+static constexpr float DeltaTime = 1.f / 60.f;
+
+FExtendedCameraPerfBaseline Baseline;
+
+void MeasureCase(EExtendedCameraDriverMode DriverMode, EExtendedCameraMode LOSMode);
+
+END_DEFINE_SPEC(FExtendedCameraPerformanceSpec)
+
+void FExtendedCameraPerformanceSpec::Define()
+{
+    const auto DriverEnum = StaticEnum<EExtendedCameraDriverMode>();
+    const auto LOSEnum = StaticEnum<EExtendedCameraMode>();
+
+    BeforeEach([this]() { Baseline.Load(); });
+
+    AfterEach([this]() {
+        if (CVarExtendedCameraPerfUpdateBaseline.GetValueOnGameThread() && !Baseline.Save())
+        {
+            AddError(FString::Printf(TEXT("Couldn't write %s"), *FExtendedCameraPerfBaseline::GetFilename()));
+        }
+    });
+
+    // Bone driven modes resolve the mannequin's bones once, so they measure the cached path
+    for (int32 Driver = 0; Driver < EExtendedCameraDriverMode::TOTAL_CAMERA_DRIVER_MODES; ++Driver)
+    {
+        const auto DriverMode = EExtendedCameraDriverMode(Driver);
+        for (int32 Mode = 0; Mode < EExtendedCameraMode::TOTAL_CAMERA_MODES; ++Mode)
+        {
+            const auto LOSMode = EExtendedCameraMode(Mode);
+            It(FString::Printf(TEXT("should stay within baseline in %s with %s"),
+                               *DriverEnum->GetNameStringByValue(DriverMode), *LOSEnum->GetNameStringByValue(Mode)),
+               [this, DriverMode, LOSMode]() { MeasureCase(DriverMode, LOSMode); });
+        }
+    }
+}
+
+void FExtendedCameraPerformanceSpec::MeasureCase(EExtendedCameraDriverMode DriverMode, EExtendedCameraMode LOSMode)
+{
+    if (!ExtendedCameraTestScene::CanSpawnTrack(*this, DriverMode))
+    {
+        return;
+    }
+
+    const int32 NumCameras = FMath::Max(1, CVarExtendedCameraPerfCameras.GetValueOnGameThread());
+    const int32 NumFrames = FMath::Max(1, CVarExtendedCameraPerfFrames.GetValueOnGameThread());
+
+    FExtendedCameraTestWorld TestWorld;
+
+    // Every camera has the wall between it and its owner, so the LOS modes do their full work
+    const auto Track = TestWorld.SpawnTrack(DriverMode);
+    TestWorld.SpawnBlocker(FVector(-100.0, NumCameras * 200.0, 0.0), FVector(10.0, NumCameras * 200.0 + 400.0, 200.0));
+
+    TArray<UExtendedCameraComponent *> Cameras;
+    for (int32 Index = 0; Index < NumCameras; ++Index)
+    {
+        auto Camera = TestWorld.SpawnCamera(FVector(0.0, Index * 400.0, 0.0));
+        Camera->SetCameraTrack(0, Track);
+        Camera->SetCameraMode(LOSMode);
+        Cameras.Add(Camera);
+    }
+
+    for (int32 Frame = 0; Frame < WarmupFrames; ++Frame)
+    {
+        TestWorld.Step(DeltaTime);
+        for (const auto Camera : Cameras)
+        {
+            FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+        }
+    }
+
+    // Only the views are timed. The world tick is the engine's cost, not ours
+    TArray<double> FrameTimes;
+    FrameTimes.Reserve(NumFrames);
+    for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        TestWorld.Step(DeltaTime);
+
+        const auto Start = FPlatformTime::Cycles64();
+        for (const auto Camera : Cameras)
+        {
+            FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+        }
+        FrameTimes.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start) * 1000.0);
+    }
+
+    FrameTimes.Sort();
+    const double Median = FrameTimes[NumFrames / 2];
+    const double Worst = FrameTimes.Last();
+
+    const auto Case = FString::Printf(TEXT("%s.%s"),
+                                      *StaticEnum<EExtendedCameraDriverMode>()->GetNameStringByValue(DriverMode),
+                                      *StaticEnum<EExtendedCameraMode>()->GetNameStringByValue(LOSMode));
+    AddInfo(FString::Printf(TEXT("%s: %d cameras, median %.2f us/frame, worst %.2f us/frame"), *Case, NumCameras,
+                            Median, Worst));
+
+    if (CVarExtendedCameraPerfUpdateBaseline.GetValueOnGameThread())
+    {
+        Baseline.Set(Case, NumCameras, Median);
+        return;
+    }
+
+    const double Stored = Baseline.Find(Case, NumCameras);
+    if (Stored < 0.0)
+    {
+        AddInfo(FString::Printf(TEXT("%s has no baseline for %d cameras. Record one with "
+                                     "ExtendedCamera.Tests.UpdateBaseline 1"),
+                                *Case, NumCameras));
+        return;
+    }
+
+    const double Margin = FMath::Max(0.f, CVarExtendedCameraPerfMargin.GetValueOnGameThread());
+    TestTrue(FString::Printf(TEXT("%s median %.2f us/frame within %.0f%% of its %.2f us/frame baseline"), *Case,
+                             Median, Margin * 100.0, Stored),
+             Median <= Stored * (1.0 + Margin));
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,126 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#include "ExtendedCameraComponent.h"
+#include "ExtendedCameraRecording.h"
+#include "ExtendedCameraTestWorld.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FExtendedCameraRecordingSpec, "ExtendedCamera.Recording",
+                  EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// Frames before recording starts, so the aim spring and smooth return have state to carry over
+static constexpr int32 WarmupFrames = 5;
+static constexpr int32 NumFrames = 60;
+static constexpr float DeltaTime = 1.f / 60.f;
+
+FString Filename;
+
+// Configure a camera the same way for recording and replay. A zero rate leaves the fixed timestep off
+void SetUpCamera(UExtendedCameraComponent *Camera, const FExtendedCameraTrack &Track, float FixedTimestepRate);
+
+// Record a camera through a wall moving away, then replay it without the world and compare the views
+void TestReplay(float FixedTimestepRate);
+
+END_DEFINE_SPEC(FExtendedCameraRecordingSpec)
+
+void FExtendedCameraRecordingSpec::Define()
+{
+    BeforeEach([this]() {
+        Filename = FPaths::ConvertRelativePathToFull(
+            FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("ExtendedCameraRecording.bin")));
+    });
+
+    AfterEach([this]() { IFileManager::Get().Delete(*Filename); });
+
+    It("should replay the recorded views without a world", [this]() { TestReplay(0.f); });
+
+    // Four steps a frame, of which only the first traces
+    It("should replay fixed timestep views a frame at a time", [this]() { TestReplay(240.f); });
+}
+
+void FExtendedCameraRecordingSpec::TestReplay(float FixedTimestepRate)
+{
+    FExtendedCameraTestWorld TestWorld;
+
+    // The wall blocks the first half, then moves away and the camera returns
+    auto Track = TestWorld.SpawnTrack(EExtendedCameraDriverMode::LocAndAim);
+    Track.AimSmoothTime = 0.2f;
+    const auto Wall = TestWorld.SpawnBlocker(ExtendedCameraTestScene::TrackLocation * 0.5, FVector(10.0, 400.0, 400.0));
+
+    auto Camera = TestWorld.SpawnCamera(FVector::ZeroVector);
+    SetUpCamera(Camera, Track, FixedTimestepRate);
+
+    TArray<FMinimalViewInfo> Views;
+    for (int32 Frame = 0; Frame < WarmupFrames + NumFrames; ++Frame)
+    {
+        if (Frame == WarmupFrames)
+        {
+            if (!TestTrue(TEXT("Recording started"), Camera->StartRecording(Filename)))
+            {
+                return;
+            }
+        }
+
+        if (Frame == WarmupFrames + NumFrames / 2)
+        {
+            Wall->SetActorLocation(FVector(0.0, 0.0, -10000.0));
+        }
+
+        Track.Locator->SetActorLocation(ExtendedCameraTestScene::TrackLocation + FVector(0.0, Frame * 5.0, 0.0));
+        TestWorld.Step(DeltaTime);
+
+        const auto View = FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+        if (Frame >= WarmupFrames)
+        {
+            Views.Add(View);
+        }
+    }
+
+    Camera->StopRecording();
+
+    // Nothing the replay reads may come from the world
+    Track.Locator = nullptr;
+    Track.Aim = nullptr;
+    auto Replay = NewObject<UExtendedCameraComponent>(GetTransientPackage());
+    SetUpCamera(Replay, Track, FixedTimestepRate);
+
+    FExtendedCameraRecordingPlayer Player;
+    if (!TestTrue(TEXT("Recording opened"), Player.Open(Filename, *Replay)))
+    {
+        return;
+    }
+
+    for (int32 Frame = 0; Frame < Views.Num(); ++Frame)
+    {
+        FMinimalViewInfo View;
+        const auto What = FString::Printf(TEXT("Frame %d"), Frame);
+        if (!TestTrue(What + TEXT(" read"), Player.Step(*Replay, View)) ||
+            !TestEqual(What + TEXT(" location"), View.Location, Views[Frame].Location, 0.001f) ||
+            !TestEqual(What + TEXT(" rotation"), View.Rotation, Views[Frame].Rotation, 0.001f) ||
+            !TestEqual(What + TEXT(" FOV"), View.FOV, Views[Frame].FOV, 0.001f))
+        {
+            return;
+        }
+    }
+
+    // One recorded frame per view, however many fixed steps each took
+    FMinimalViewInfo View;
+    TestFalse(TEXT("Recording ended"), Player.Step(*Replay, View));
+}
+
+void FExtendedCameraRecordingSpec::SetUpCamera(UExtendedCameraComponent *Camera, const FExtendedCameraTrack &Track,
+                                               float FixedTimestepRate)
+{
+    Camera->SetCameraTrack(0, Track);
+    Camera->SetUseFixedTimestep(FixedTimestepRate > 0.f, FMath::Max(FixedTimestepRate, 1.f));
+    Camera->SetCameraMode(EExtendedCameraMode::KeepLosNoDot);
+    Camera->SetSmoothReturn(true);
+    Camera->SetSmoothReturnTime(0.25f);
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
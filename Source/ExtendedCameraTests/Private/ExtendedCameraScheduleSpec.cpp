@@ -0,0 +1,84 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#include "Engine/World.h"
+#include "ExtendedCameraComponent.h"
+#include "ExtendedCameraSubsystem.h"
+#include "ExtendedCameraTestWorld.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FExtendedCameraScheduleSpec, "ExtendedCamera.Schedule",
+                  EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+static constexpr float DeltaTime = 1.f / 60.f;
+static constexpr int32 MaxDeferredFrames = 2;
+
+END_DEFINE_SPEC(FExtendedCameraScheduleSpec)
+
+void FExtendedCameraScheduleSpec::Define()
+{
+    It("should trace straight away when the budget has room", [this]() {
+        FExtendedCameraTestWorld TestWorld;
+        auto Camera = TestWorld.SpawnBlockedCamera();
+        TestWorld.GetWorld()->GetSubsystem<UExtendedCameraSubsystem>()->SetScheduleBudget(1.e9f, MaxDeferredFrames);
+
+        TestWorld.Step(DeltaTime);
+        const auto View = FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+        TestTrue(TEXT("Traced in front of the wall"), View.Location.X > ExtendedCameraTestScene::BlockerLocation.X);
+    });
+
+    It("should hold a trace back until it has waited the longest it may", [this]() {
+        FExtendedCameraTestWorld TestWorld;
+        auto Camera = TestWorld.SpawnBlockedCamera();
+
+        // Nothing fits, so only the starvation guarantee gets the trace through
+        TestWorld.GetWorld()->GetSubsystem<UExtendedCameraSubsystem>()->SetScheduleBudget(1.e-3f, MaxDeferredFrames);
+
+        for (int32 Frame = 0; Frame < MaxDeferredFrames; ++Frame)
+        {
+            TestWorld.Step(DeltaTime);
+            const auto View = FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+            TestEqual(TEXT("Deferred"), View.Location, ExtendedCameraTestScene::BlockedTrackLocation, 0.01f);
+        }
+
+        TestWorld.Step(DeltaTime);
+        const auto View = FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+        TestTrue(TEXT("Traced in front of the wall"), View.Location.X > ExtendedCameraTestScene::BlockerLocation.X);
+    });
+
+    It("should keep following the characters while a bone search waits", [this]() {
+        if (!ExtendedCameraTestScene::CanSpawnTrack(*this, EExtendedCameraDriverMode::Skeleton))
+        {
+            return;
+        }
+
+        FExtendedCameraTestWorld TestWorld;
+        const auto Track = TestWorld.SpawnTrack(EExtendedCameraDriverMode::Skeleton);
+        auto Camera = TestWorld.SpawnCamera(FVector::ZeroVector);
+        Camera->SetCameraTrack(0, Track);
+        TestWorld.GetWorld()->GetSubsystem<UExtendedCameraSubsystem>()->SetScheduleBudget(1.e-3f, MaxDeferredFrames);
+
+        // Until the search is let through, the track reads the characters the bones are on
+        auto ActorTrack = Track;
+        ActorTrack.DriverMode = EExtendedCameraDriverMode::LocAndAim;
+
+        for (int32 Frame = 0; Frame <= MaxDeferredFrames; ++Frame)
+        {
+            TestWorld.Step(DeltaTime);
+            const auto View = FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+
+            FVector ExpectedLocation;
+            FRotator ExpectedRotation;
+            float ExpectedFOV;
+            ExtendedCameraTestScene::GetExpectedView(Frame < MaxDeferredFrames ? ActorTrack : Track, ExpectedLocation,
+                                                     ExpectedRotation, ExpectedFOV);
+
+            const auto What = FString::Printf(TEXT("Frame %d"), Frame);
+            TestEqual(What + TEXT(" location"), View.Location, ExpectedLocation, 0.01f);
+            TestEqual(What + TEXT(" rotation"), View.Rotation, ExpectedRotation, 0.01f);
+        }
+    });
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
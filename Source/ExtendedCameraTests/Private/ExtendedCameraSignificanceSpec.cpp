@@ -0,0 +1,129 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#include "ExtendedCameraComponent.h"
+#include "ExtendedCameraTestWorld.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FExtendedCameraSignificanceSpec, "ExtendedCamera.Significance",
+                  EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+static constexpr float DeltaTime = 1.f / 60.f;
+
+// The test world has no players, so nothing ranks the cameras but the specs
+FExtendedCameraSignificanceTier MakeTier(int32 TrackingInterval, EExtendedCameraSignificanceLOS LineOfSight,
+                                         bool SmoothAim);
+
+END_DEFINE_SPEC(FExtendedCameraSignificanceSpec)
+
+void FExtendedCameraSignificanceSpec::Define()
+{
+    It("should only track on the tier's interval", [this]() {
+        FExtendedCameraTestWorld TestWorld;
+        const auto Track = TestWorld.SpawnTrack(EExtendedCameraDriverMode::LocAndAim);
+        auto Camera = TestWorld.SpawnCamera(FVector::ZeroVector);
+        Camera->SetCameraTrack(0, Track);
+        Camera->SetUseSignificance(true);
+        Camera->SetSignificanceTier(EExtendedCameraSignificance::SignificanceMinimal,
+                                    MakeTier(4, EExtendedCameraSignificanceLOS::TraceLineOfSight, true));
+
+        // The locator moves every frame, but the view only follows on tracked ones
+        FMinimalViewInfo Previous;
+        int32 Moves = 0;
+        for (int32 Frame = 0; Frame < 9; ++Frame)
+        {
+            Track.Locator->SetActorLocation(ExtendedCameraTestScene::TrackLocation + FVector(0.0, Frame * 10.0, 0.0));
+            TestWorld.Step(DeltaTime);
+
+            const auto View = FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+            Moves += Frame > 0 && !View.Location.Equals(Previous.Location, 0.01);
+            Previous = View;
+        }
+
+        TestEqual(TEXT("Tracked frames"), Moves, 2);
+    });
+
+    It("should dolly zoom from where the owner is now, between tracked frames", [this]() {
+        FExtendedCameraTestWorld TestWorld;
+        auto Track = TestWorld.SpawnTrack(EExtendedCameraDriverMode::DataDriven);
+        Track.DollyZoomEnabled = true;
+        Track.DollyZoomDistanceLiveUpdate = false;
+        Track.DollyZoomReferenceDistance = ExtendedCameraTestScene::TrackLocation.Size();
+
+        auto Camera = TestWorld.SpawnCamera(FVector::ZeroVector);
+        Camera->SetCameraTrack(0, Track);
+        Camera->SetUseSignificance(true);
+        Camera->SetSignificanceTier(EExtendedCameraSignificance::SignificanceMinimal,
+                                    MakeTier(4, EExtendedCameraSignificanceLOS::TraceLineOfSight, true));
+
+        // The track holds still, so only the owner's distance from it moves the FOV
+        float PreviousFOV = 0.f;
+        int32 Zooms = 0;
+        for (int32 Frame = 0; Frame < 9; ++Frame)
+        {
+            Camera->GetOwner()->SetActorLocation(FVector(0.0, Frame * 10.0, 0.0));
+            TestWorld.Step(DeltaTime);
+
+            const auto View = FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+            Zooms += Frame > 0 && !FMath::IsNearlyEqual(View.FOV, PreviousFOV, 0.001f);
+            PreviousFOV = View.FOV;
+        }
+
+        TestEqual(TEXT("Zoomed frames"), Zooms, 8);
+    });
+
+    It("should snap the aim when the tier doesn't smooth it", [this]() {
+        FExtendedCameraTestWorld TestWorld;
+        auto Track = TestWorld.SpawnTrack(EExtendedCameraDriverMode::LocAndAim);
+        Track.AimSmoothTime = 0.5f;
+
+        auto Camera = TestWorld.SpawnCamera(FVector::ZeroVector);
+        Camera->SetCameraTrack(0, Track);
+        Camera->SetUseSignificance(true);
+        Camera->SetSignificanceTier(EExtendedCameraSignificance::SignificanceMinimal,
+                                    MakeTier(1, EExtendedCameraSignificanceLOS::TraceLineOfSight, false));
+
+        FVector ExpectedLocation;
+        FRotator ExpectedRotation;
+        float ExpectedFOV;
+        ExtendedCameraTestScene::GetExpectedView(Track, ExpectedLocation, ExpectedRotation, ExpectedFOV);
+
+        TestWorld.Step(DeltaTime);
+        const auto View = FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+        TestEqual(TEXT("Rotation"), View.Rotation, ExpectedRotation, 0.01f);
+    });
+
+    It("should leave a blocked view behind the wall when the tier skips LOS", [this]() {
+        FExtendedCameraTestWorld TestWorld;
+        auto Camera = TestWorld.SpawnBlockedCamera();
+
+        Camera->SetUseSignificance(true);
+        Camera->SetSignificanceTier(EExtendedCameraSignificance::SignificanceDormant,
+                                    MakeTier(1, EExtendedCameraSignificanceLOS::SkipLineOfSight, false));
+
+        TestWorld.Step(DeltaTime);
+        auto View = FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+        TestEqual(TEXT("Skipped"), View.Location, ExtendedCameraTestScene::BlockedTrackLocation, 0.01f);
+
+        // Back to tracing, the wall is seen again
+        Camera->SetSignificanceTier(EExtendedCameraSignificance::SignificanceFull, FExtendedCameraSignificanceTier());
+
+        TestWorld.Step(DeltaTime);
+        View = FExtendedCameraTestWorld::Evaluate(Camera, DeltaTime);
+        TestTrue(TEXT("Traced in front of the wall"), View.Location.X > ExtendedCameraTestScene::BlockerLocation.X);
+    });
+}
+
+FExtendedCameraSignificanceTier FExtendedCameraSignificanceSpec::MakeTier(int32 TrackingInterval,
+                                                                          EExtendedCameraSignificanceLOS LineOfSight,
+                                                                          bool SmoothAim)
+{
+    FExtendedCameraSignificanceTier Tier;
+    Tier.TrackingInterval = TrackingInterval;
+    Tier.LineOfSight = LineOfSight;
+    Tier.SmoothAim = SmoothAim;
+    return Tier;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
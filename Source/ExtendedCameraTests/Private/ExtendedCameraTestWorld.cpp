@@ -0,0 +1,244 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#include "ExtendedCameraTestWorld.h"
+#include "Camera/CameraActor.h"
+#include "Camera/CameraComponent.h"
+#include "Components/BoxComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/Engine.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/World.h"
+#include "ExtendedCameraComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+static TAutoConsoleVariable<int32> CVarExtendedCameraTestCount(
+    TEXT("ExtendedCamera.Tests.Cameras"), 16, TEXT("Number of extended cameras each ExtendedCamera spec case spawns"));
+
+int32 GetExtendedCameraTestCount()
+{
+    return FMath::Max(1, CVarExtendedCameraTestCount.GetValueOnGameThread());
+}
+
+static bool UsesLocatorBone(EExtendedCameraDriverMode Mode)
+{
+    return Mode == EExtendedCameraDriverMode::Skeleton || Mode == EExtendedCameraDriverMode::SkeletonLocator;
+}
+
+static bool UsesAimBone(EExtendedCameraDriverMode Mode)
+{
+    return Mode == EExtendedCameraDriverMode::Skeleton || Mode == EExtendedCameraDriverMode::SkeletonAim;
+}
+
+// Quietly, as a missing mannequin is reported by CanSpawnTrack
+static USkeletalMesh *LoadCharacterMesh()
+{
+    return LoadObject<USkeletalMesh>(nullptr, ExtendedCameraTestScene::CharacterMeshPath, nullptr,
+                                     LOAD_NoWarn | LOAD_Quiet);
+}
+
+// Where a locator or aim is read from. The bone if there is one, otherwise the actor
+static FTransform GetTrackedTransform(const AActor *Actor, FName BoneName, bool UsesBone)
+{
+    const auto Character = Cast<ACharacter>(Actor);
+    const auto Mesh = UsesBone && Character ? Character->GetMesh() : nullptr;
+    const int32 Bone = Mesh ? Mesh->GetBoneIndex(BoneName) : INDEX_NONE;
+    return Bone != INDEX_NONE ? Mesh->GetBoneTransform(Bone) : Actor->GetActorTransform();
+}
+
+void ExtendedCameraTestScene::GetExpectedView(const FExtendedCameraTrack &Track, FVector &OutLocation,
+                                              FRotator &OutRotation, float &OutFOV)
+{
+    const EExtendedCameraDriverMode Mode = Track.DriverMode;
+    OutFOV = TrackFOV;
+
+    if (Mode == EExtendedCameraDriverMode::ReferenceCameraDriven || Mode == EExtendedCameraDriverMode::Compat ||
+        Mode == EExtendedCameraDriverMode::DataDriven)
+    {
+        OutLocation = TrackLocation;
+        OutRotation = TrackRotation;
+        return;
+    }
+
+    // The aim offset is in the aim's space
+    const auto Locator = GetTrackedTransform(Track.Locator, Track.LocatorBoneName, UsesLocatorBone(Mode));
+    const auto Aim = GetTrackedTransform(Track.Aim, Track.AimBoneName, UsesAimBone(Mode));
+
+    OutLocation = Locator.GetLocation();
+    OutRotation = (Aim.TransformPosition(Track.AimOffset) - OutLocation).Rotation();
+}
+
+bool ExtendedCameraTestScene::CanSpawnTrack(FAutomationTestBase &Test, EExtendedCameraDriverMode Mode)
+{
+    if ((!UsesLocatorBone(Mode) && !UsesAimBone(Mode)) || LoadCharacterMesh())
+    {
+        return true;
+    }
+
+    Test.AddWarning(FString::Printf(TEXT("Skipped, %s isn't installed"), CharacterMeshPath));
+    return false;
+}
+
+FExtendedCameraTestWorld::FExtendedCameraTestWorld()
+{
+    // Rooted by CreateWorld, so a GC between spec steps can't take it
+    World = UWorld::CreateWorld(EWorldType::Game, false);
+
+    auto &WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(World);
+
+    FURL URL;
+    World->InitializeActorsForPlay(URL);
+    World->BeginPlay();
+
+    // There is no game mode to start play for us
+    if (!World->HasBegunPlay())
+    {
+        World->GetWorldSettings()->NotifyBeginPlay();
+    }
+}
+
+FExtendedCameraTestWorld::~FExtendedCameraTestWorld()
+{
+    // EndPlay unregisters the cameras from the subsystem
+    for (const auto &Actor : SpawnedActors)
+    {
+        if (Actor.IsValid())
+        {
+            Actor->Destroy();
+        }
+    }
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+}
+
+AActor *FExtendedCameraTestWorld::SpawnRooted(const FVector &Location, const FRotator &Rotation)
+{
+    auto Actor = World->SpawnActor<AActor>();
+    auto Root = NewObject<USceneComponent>(Actor, TEXT("Root"));
+    Actor->SetRootComponent(Root);
+    Root->RegisterComponent();
+    Actor->SetActorLocationAndRotation(Location, Rotation);
+
+    SpawnedActors.Add(Actor);
+    return Actor;
+}
+
+UExtendedCameraComponent *FExtendedCameraTestWorld::SpawnCamera(const FVector &Location)
+{
+    auto Actor = World->SpawnActor<AActor>();
+    auto Camera = NewObject<UExtendedCameraComponent>(Actor, TEXT("ExtendedCamera"));
+    Actor->SetRootComponent(Camera);
+
+    // The actor has begun play, so this also begins play on the camera
+    Camera->RegisterComponent();
+    Actor->SetActorLocation(Location);
+
+    SpawnedActors.Add(Actor);
+    return Camera;
+}
+
+AActor *FExtendedCameraTestWorld::SpawnTarget(const FVector &Location, const FRotator &Rotation)
+{
+    return SpawnRooted(Location, Rotation);
+}
+
+ACharacter *FExtendedCameraTestWorld::SpawnCharacter(const FVector &Location)
+{
+    auto Character = World->SpawnActor<ACharacter>(Location, FRotator::ZeroRotator);
+    SpawnedActors.Add(Character);
+
+    const auto Mesh = LoadCharacterMesh();
+    ensureMsgf(Mesh, TEXT("Couldn't load %s"), ExtendedCameraTestScene::CharacterMeshPath);
+    Character->GetMesh()->SetSkeletalMesh(Mesh);
+    return Character;
+}
+
+ACameraActor *FExtendedCameraTestWorld::SpawnReferenceCamera(const FVector &Location, const FRotator &Rotation,
+                                                             float FOV)
+{
+    auto CameraActor = World->SpawnActor<ACameraActor>(Location, Rotation);
+    CameraActor->GetCameraComponent()->SetFieldOfView(FOV);
+
+    SpawnedActors.Add(CameraActor);
+    return CameraActor;
+}
+
+AActor *FExtendedCameraTestWorld::SpawnBlocker(const FVector &Location, const FVector &Extent)
+{
+    auto Actor = World->SpawnActor<AActor>();
+    auto Box = NewObject<UBoxComponent>(Actor, TEXT("Blocker"));
+    Box->SetBoxExtent(Extent, false);
+    Box->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+    Actor->SetRootComponent(Box);
+    Box->RegisterComponent();
+    Actor->SetActorLocation(Location);
+
+    SpawnedActors.Add(Actor);
+    return Actor;
+}
+
+UExtendedCameraComponent *FExtendedCameraTestWorld::SpawnBlockedCamera()
+{
+    using namespace ExtendedCameraTestScene;
+
+    SpawnBlocker(BlockerLocation, BlockerExtent);
+
+    auto Camera = SpawnCamera(FVector::ZeroVector);
+    Camera->SetCameraMode(EExtendedCameraMode::KeepLosNoDot);
+    Camera->SetCameraTrackMode(0, EExtendedCameraDriverMode::DataDriven);
+    Camera->SetCameraTrackAlpha(0, 1.f);
+    Camera->SetCameraTrackTransform(0, FTransform(FRotator::ZeroRotator, BlockedTrackLocation), 0.f);
+    return Camera;
+}
+
+FExtendedCameraTrack FExtendedCameraTestWorld::SpawnTrack(EExtendedCameraDriverMode Mode)
+{
+    using namespace ExtendedCameraTestScene;
+
+    FExtendedCameraTrack Track;
+    Track.DriverMode = Mode;
+    Track.BlendAlpha = 1.f;
+    Track.FOV = TrackFOV;
+
+    if (Mode == EExtendedCameraDriverMode::DataDriven)
+    {
+        Track.Transform = FTransform(TrackRotation, TrackLocation);
+    }
+    else if (Mode == EExtendedCameraDriverMode::ReferenceCameraDriven || Mode == EExtendedCameraDriverMode::Compat)
+    {
+        // The transform and FOV are left wrong, so only the copy from the camera can pass
+        Track.FOV = 0.f;
+        Track.TrackedCamera = SpawnReferenceCamera(TrackLocation, TrackRotation, TrackFOV);
+    }
+    else
+    {
+        Track.Locator = UsesLocatorBone(Mode) ? static_cast<AActor *>(SpawnCharacter(TrackLocation))
+                                              : SpawnTarget(TrackLocation);
+        Track.Aim =
+            UsesAimBone(Mode) ? static_cast<AActor *>(SpawnCharacter(AimLocation)) : SpawnTarget(AimLocation);
+        Track.AimOffset = AimOffset;
+        Track.LocatorBoneName = LocatorBoneName;
+        Track.AimBoneName = AimBoneName;
+    }
+
+    return Track;
+}
+
+void FExtendedCameraTestWorld::Step(float DeltaTime)
+{
+    // The cameras stamp their per-frame caches with this
+    ++GFrameCounter;
+    World->Tick(LEVELTICK_All, DeltaTime);
+}
+
+FMinimalViewInfo FExtendedCameraTestWorld::Evaluate(UExtendedCameraComponent *Camera, float DeltaTime)
+{
+    FMinimalViewInfo View;
+    Camera->GetCameraView(DeltaTime, View);
+    return View;
+}
@@ -0,0 +1,129 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#pragma once
+
+#include "Camera/CameraTypes.h"
+#include "CoreMinimal.h"
+#include "ExtendedCameraComponent.h"
+
+class AActor;
+class ACameraActor;
+class ACharacter;
+class FAutomationTestBase;
+class UWorld;
+
+// Number of cameras the specs spawn per case. ExtendedCamera.Tests.Cameras
+int32 GetExtendedCameraTestCount();
+
+///// ///// ////////// ///// /////
+// Shared Scene
+//
+
+namespace ExtendedCameraTestScene
+{
+// Where the reference camera and the locator sit, and what the data driven track is set to
+inline const FVector TrackLocation(-500.0, 200.0, 150.0);
+inline const FRotator TrackRotation(-15.0, 30.0, 0.0);
+constexpr float TrackFOV = 70.f;
+
+// Where the aim sits, and the offset applied in its space
+inline const FVector AimLocation(300.0, -100.0, 50.0);
+inline const FVector AimOffset(50.0, 50.0, 0.0);
+
+// Characters are spawned with the engine's mannequin, so bone driven tracks have real bones to find. It's tutorial
+// content, which editor installs ship with but cooked or trimmed engines may not
+inline const TCHAR *const CharacterMeshPath =
+    TEXT("/Engine/Tutorial/SubEditors/TutorialAssets/Character/TutorialTPP.TutorialTPP");
+inline const FName LocatorBoneName(TEXT("head"));
+inline const FName AimBoneName(TEXT("spine_03"));
+
+// A bone the mannequin doesn't have
+inline const FName MissingBoneName(TEXT("NoSuchBone"));
+
+// The blocked camera's wall, and its track behind the wall from the owner at the origin
+inline const FVector BlockerLocation(-200.0, 0.0, 0.0);
+inline const FVector BlockerExtent(10.0, 200.0, 200.0);
+inline const FVector BlockedTrackLocation(-400.0, 0.0, 0.0);
+
+/**
+ * Expected View
+ *
+ * What a single fully blended Track from the shared scene should produce.
+ * Bones are read from the track's characters as they're posed now, and a
+ * bone that can't be found falls back to the actor it was looked for on
+ */
+void GetExpectedView(const FExtendedCameraTrack &Track, FVector &OutLocation, FRotator &OutRotation, float &OutFOV);
+
+/**
+ * Can Spawn Track
+ *
+ * False when Mode reads bones and the mannequin isn't installed. The case
+ * is then skipped with a warning on Test rather than failed
+ */
+bool CanSpawnTrack(FAutomationTestBase &Test, EExtendedCameraDriverMode Mode);
+} // namespace ExtendedCameraTestScene
+
+/**
+ * Test World
+ *
+ * A game world that exists for the lifetime of this object. The only content
+ * it loads is the mannequin, so it runs headless under -nullrhi. Everything
+ * spawned is destroyed with it
+ */
+class FExtendedCameraTestWorld
+{
+public:
+    FExtendedCameraTestWorld();
+    ~FExtendedCameraTestWorld();
+
+    FExtendedCameraTestWorld(const FExtendedCameraTestWorld &) = delete;
+    FExtendedCameraTestWorld &operator=(const FExtendedCameraTestWorld &) = delete;
+
+    UWorld *GetWorld() const
+    {
+        return World;
+    }
+
+    // An actor whose root is an extended camera
+    UExtendedCameraComponent *SpawnCamera(const FVector &Location);
+
+    // An actor with nothing but a root, for locators and aims
+    AActor *SpawnTarget(const FVector &Location, const FRotator &Rotation = FRotator::ZeroRotator);
+
+    // A character with the mannequin as its mesh, in its reference pose
+    ACharacter *SpawnCharacter(const FVector &Location);
+
+    ACameraActor *SpawnReferenceCamera(const FVector &Location, const FRotator &Rotation, float FOV);
+
+    // A box that blocks every channel
+    AActor *SpawnBlocker(const FVector &Location, const FVector &Extent);
+
+    // A KeepLosNoDot camera at the origin with the shared scene's wall between it and its data driven track
+    UExtendedCameraComponent *SpawnBlockedCamera();
+
+    /**
+     * Spawn Track
+     *
+     * Spawns the shared scene's targets for Mode and returns a fully blended
+     * track that reads them. Bone driven locators and aims are characters,
+     * tracked by LocatorBoneName and AimBoneName
+     */
+    FExtendedCameraTrack SpawnTrack(EExtendedCameraDriverMode Mode);
+
+    /**
+     * Step
+     *
+     * Starts a new frame and ticks the world, so the subsystem and physics
+     * see it the way the engine loop would
+     */
+    void Step(float DeltaTime);
+
+    // GetCameraView from the camera's base view
+    static FMinimalViewInfo Evaluate(UExtendedCameraComponent *Camera, float DeltaTime);
+
+private:
+    AActor *SpawnRooted(const FVector &Location, const FRotator &Rotation);
+
+    UWorld *World;
+    TArray<TWeakObjectPtr<AActor>> SpawnedActors;
+};
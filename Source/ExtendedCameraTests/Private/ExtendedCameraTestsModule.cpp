@@ -0,0 +1,5 @@
+// Copyright Acinonyx Ltd. 2022. All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, ExtendedCameraTests)